@@ -37,6 +37,12 @@
 using MutexType = tbb::queuing_mutex;
 #endif
 
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+
+#include <QtCore/QFileInfo>
+
 #include <itkAmoebaOptimizer.h>
 #include <itkFFTConvolutionImageFilter.h>
 #include <itkNumericTraits.h>
@@ -44,6 +50,7 @@ using MutexType = tbb::queuing_mutex;
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/CoreFilters/ConvertColorToGrayScale.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
 #include "SIMPLib/DataContainers/DataArrayPath.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -55,16 +62,17 @@ using MutexType = tbb::queuing_mutex;
 #include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
 #include "SIMPLib/FilterParameters/MontageSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/MontageStructureSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Montages/GridMontage.h"
-#include "SIMPLib/Utilities/ParallelData2DAlgorithm.h"
-#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
+#include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "ITKImageProcessing/FilterParameters/EbsdWarpPolynomialFilterParameter.h"
 #include "ITKImageProcessing/ITKImageProcessingConstants.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTDewarpHelper.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTDewarpMap.h"
 #include "ITKImageProcessing/ITKImageProcessingVersion.h"
 
 using Grayscale_T = uint8_t;
@@ -110,145 +118,89 @@ FFTDewarpHelper::ParametersType convertVec2Params(const std::vector<double>& vec
 //{
 //  return FFTDewarpHelper::pixelIndex(sizeVec[0], sizeVec[1]);
 //}
-SizeVec2Type pixelIndexToSizeVec(const FFTDewarpHelper::PixelIndex& pixelType)
-{
-  return SizeVec2Type(static_cast<size_t>(pixelType[0]), static_cast<size_t>(pixelType[1]));
-}
-size_t flatten(const SizeVec2Type& xyPos, const SizeVec3Type& dimensions)
-{
-  const size_t x = xyPos[0];
-  const size_t y = xyPos[1];
-
-  const size_t width = dimensions[0];
 
-  return x + y * width;
-}
-size_t flatten(const FFTDewarpHelper::PixelIndex& xyPos, const SizeVec3Type& dimensions)
-{
-  return flatten(pixelIndexToSizeVec(xyPos), dimensions);
-}
-
-template <typename T>
-void clearTuple(const typename DataArray<T>::Pointer& da, size_t numComponents, size_t tupleId)
-{
-  T initValue = da->getInitValue();
-  typename std::vector<T> blankTuple(numComponents, initValue);
-  da->setTuple(tupleId, blankTuple);
-}
-
-template <typename T>
-void transformDataPixel(double x_trans, double y_trans, const SizeVec2Type& newPixel, const FFTDewarpHelper::ParametersType& parameters, const SizeVec3Type& dimensions,
-                        const typename DataArray<T>::Pointer& da, const typename DataArray<T>::Pointer& tempDACopy)
+// -----------------------------------------------------------------------------
+// Returns true if the chosen interpolation is applied to the array.  Single component floating point arrays such
+// as image quality and 8 or 16 bit unsigned image arrays of any number of channels are interpolated.  Other
+// integer arrays such as phases and feature ids, and multi-component floating point arrays such as Euler angles,
+// keep the nearest neighbor value.
+// -----------------------------------------------------------------------------
+bool isInterpolated(const IDataArray& da)
 {
-  FFTDewarpHelper::PixelIndex offset = FFTDewarpHelper::pixelIndex(x_trans, y_trans);
-  FFTDewarpHelper::PixelIndex oldPixelIndex = FFTDewarpHelper::getOldIndex(FFTDewarpHelper::pixelIndex(newPixel[0], newPixel[1]), offset, parameters);
-
-  auto compDims = tempDACopy->getComponentDimensions();
-  size_t numComponents = std::accumulate(compDims.begin(), compDims.end(), 0);
-  size_t newIndex = flatten(newPixel, dimensions);
-
-  // Cannot flatten invalid { X,Y } positions
-  if(oldPixelIndex[0] < 0 || oldPixelIndex[1] < 0 || oldPixelIndex[0] >= dimensions[0] || oldPixelIndex[1] >= dimensions[1])
+  if(nullptr != dynamic_cast<const FloatArrayType*>(&da) || nullptr != dynamic_cast<const DoubleArrayType*>(&da))
   {
-    clearTuple<T>(da, numComponents, newIndex);
-    return;
-  }
-
-  size_t oldIndex = flatten(oldPixelIndex, dimensions);
-  if((oldIndex >= da->getNumberOfTuples()) || (newIndex >= da->getNumberOfTuples()))
-  {
-    return;
+    return da.getNumberOfComponents() == 1;
   }
-
-  T* oldTuplePtr = tempDACopy->getTuplePointer(oldIndex);
-  da->setTuple(newIndex, oldTuplePtr);
+  return nullptr != dynamic_cast<const UInt8ArrayType*>(&da) || nullptr != dynamic_cast<const UInt16ArrayType*>(&da);
 }
 
 template <typename T>
-void transformDataArray(const FFTDewarpHelper::ParametersType& parameters, const SizeVec3Type& dimensions, double x_trans, double y_trans, const typename DataArray<T>::Pointer& da)
+void transformDataArray(const FFTDewarpMap& warpMap, const SizeVec3Type& dimensions, const typename DataArray<T>::Pointer& da)
 {
   // Do not resize items that do not match the geometry.
   size_t flattenedDims = std::accumulate(dimensions.begin(), dimensions.end(), 1, std::multiplies<double>());
   size_t numComps = da->getNumberOfComponents();
   size_t totalItems = da->getNumberOfTuples() * numComps;
-  if(totalItems / numComps != flattenedDims)
+  if(totalItems / numComps != flattenedDims || warpMap.getNumberOfPixels() != flattenedDims)
   {
     return;
   }
 
-  typename DataArray<T>::Pointer daCopy = std::dynamic_pointer_cast<DataArray<T>>(da->deepCopy());
-
-  const size_t width = dimensions[0];
-  const size_t height = dimensions[1];
-
-  ParallelTaskAlgorithm taskAlg;
-  std::function<void(void)> fn;
-
-  // Loop over pixels
-  for(size_t x = 0; x < width; x++)
-  {
-    for(size_t y = 0; y < height; y++)
-    {
-      SizeVec2Type newPixel{x, y};
-
-      fn = std::bind(&transformDataPixel<T>, x_trans, y_trans, newPixel, parameters, dimensions, da, daCopy);
-      taskAlg.execute(fn);
-    }
-  }
-  taskAlg.wait();
+  const bool interpolate = isInterpolated(*da);
+  warpMap.applyInPlace<T>(da->data(), numComps, da->getInitValue(), interpolate);
 }
 
-void transformIDataArray(const FFTDewarpHelper::ParametersType& parameters, const SizeVec3Type& dimensions, double x_trans, double y_trans, const IDataArray::Pointer& da)
+void transformIDataArray(const FFTDewarpMap& warpMap, const SizeVec3Type& dimensions, const IDataArray::Pointer& da)
 {
   if(std::dynamic_pointer_cast<Int8ArrayType>(da))
   {
     Int8ArrayType::Pointer array = std::dynamic_pointer_cast<Int8ArrayType>(da);
-    transformDataArray<int8_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<int8_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<UInt8ArrayType>(da))
   {
     UInt8ArrayType::Pointer array = std::dynamic_pointer_cast<UInt8ArrayType>(da);
-    transformDataArray<uint8_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<uint8_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<Int16ArrayType>(da))
   {
     Int16ArrayType::Pointer array = std::dynamic_pointer_cast<Int16ArrayType>(da);
-    transformDataArray<int16_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<int16_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<UInt16ArrayType>(da))
   {
     UInt16ArrayType::Pointer array = std::dynamic_pointer_cast<UInt16ArrayType>(da);
-    transformDataArray<uint16_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<uint16_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<Int32ArrayType>(da))
   {
     Int32ArrayType::Pointer array = std::dynamic_pointer_cast<Int32ArrayType>(da);
-    transformDataArray<int32_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<int32_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<UInt32ArrayType>(da))
   {
     UInt32ArrayType::Pointer array = std::dynamic_pointer_cast<UInt32ArrayType>(da);
-    transformDataArray<uint32_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<uint32_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<Int64ArrayType>(da))
   {
     Int64ArrayType::Pointer array = std::dynamic_pointer_cast<Int64ArrayType>(da);
-    transformDataArray<int64_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<int64_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<UInt64ArrayType>(da))
   {
     UInt64ArrayType::Pointer array = std::dynamic_pointer_cast<UInt64ArrayType>(da);
-    transformDataArray<uint64_t>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<uint64_t>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<FloatArrayType>(da))
   {
     FloatArrayType::Pointer array = std::dynamic_pointer_cast<FloatArrayType>(da);
-    transformDataArray<float>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<float>(warpMap, dimensions, array);
   }
   else if(std::dynamic_pointer_cast<DoubleArrayType>(da))
   {
     DoubleArrayType::Pointer array = std::dynamic_pointer_cast<DoubleArrayType>(da);
-    transformDataArray<double>(parameters, dimensions, x_trans, y_trans, array);
+    transformDataArray<double>(warpMap, dimensions, array);
   }
 }
 } // namespace
@@ -292,6 +244,13 @@ void ApplyDewarpParameters::setupFilterParameters()
   DataArraySelectionFilterParameter::RequirementType req;
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Transform Array", TransformPath, FilterParameter::Category::Parameter, ApplyDewarpParameters, req));
 
+  std::vector<QString> interpolationChoices{"Nearest Neighbor", "Bilinear", "Bicubic"};
+  parameters.push_back(SIMPL_NEW_CHOICE_FP("Interpolation", InterpolationType, FilterParameter::Category::Parameter, ApplyDewarpParameters, interpolationChoices, false));
+
+  std::vector<QString> linkedCacheProps{"WarpMapCacheFile"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Cache Warp Maps", UseWarpMapCache, FilterParameter::Category::Parameter, ApplyDewarpParameters, linkedCacheProps));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Warp Map Cache File", WarpMapCacheFile, FilterParameter::Category::Parameter, ApplyDewarpParameters, ".dwm"));
+
   parameters.push_back(SIMPL_NEW_STRING_FP("Transformed Data Container Prefix", TransformPrefix, FilterParameter::Category::CreatedArray, ApplyDewarpParameters));
   parameters.push_back(SIMPL_NEW_STRING_FP("Mask Array Name", MaskName, FilterParameter::Category::CreatedArray, ApplyDewarpParameters));
 
@@ -320,6 +279,27 @@ void ApplyDewarpParameters::dataCheck()
     return;
   }
 
+  if(m_InterpolationType < static_cast<int>(FFTDewarpHelper::InterpolationType::NearestNeighbor) || m_InterpolationType > static_cast<int>(FFTDewarpHelper::InterpolationType::Bicubic))
+  {
+    QString ss = tr("The interpolation type %1 is not supported").arg(m_InterpolationType);
+    setErrorCondition(-66763, ss);
+    return;
+  }
+
+  if(m_UseWarpMapCache)
+  {
+    QFileInfo fi(getWarpMapCacheFile());
+    if(fi.suffix().compare("") == 0)
+    {
+      setWarpMapCacheFile(getWarpMapCacheFile().append(".dwm"));
+    }
+    FileSystemPathHelper::CheckOutputFile(this, "Warp Map Cache File", getWarpMapCacheFile(), true);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+  }
+
   const QString newMontageName = m_TransformPrefix + m_MontageName;
   GridMontage::Pointer newMontage = dca->createNonPrereqGridMontage(this, newMontageName, oldMontage->getGridSize());
 
@@ -338,6 +318,12 @@ void ApplyDewarpParameters::dataCheck()
     {
       GridTileIndex index = newMontage->getTileIndex(row, col);
       DataContainerShPtr dc = oldMontage->getDataContainer(index);
+      if(!FFTDewarpMap::SupportsDimensions(dc->getGeometryAs<ImageGeom>()->getDimensions()))
+      {
+        QString ss = tr("The tile %1 is too large to be dewarped").arg(dc->getName());
+        setErrorCondition(-66760, ss);
+        return;
+      }
 
       const QString newName = m_TransformPrefix + dc->getName();
       DataContainerShPtr dcCopy = DataContainer::New(newName);
@@ -345,6 +331,11 @@ void ApplyDewarpParameters::dataCheck()
       AttributeMatrix::Pointer dewarpAM = dc->getAttributeMatrix(m_AttributeMatrixName)->deepCopy();
       dcCopy->insertOrAssign(dewarpAM);
 
+      if(row == 0 && col == 0)
+      {
+        warnNearestNeighborArrays(*dewarpAM);
+      }
+
       // Create Mask array
       dewarpAM->createNonPrereqArray<UInt8ArrayType>(this, m_MaskName, 255, {1});
 
@@ -354,6 +345,32 @@ void ApplyDewarpParameters::dataCheck()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ApplyDewarpParameters::warnNearestNeighborArrays(AttributeMatrix& am)
+{
+  if(m_InterpolationType == static_cast<int>(FFTDewarpHelper::InterpolationType::NearestNeighbor))
+  {
+    return;
+  }
+
+  QStringList nearestNeighborNames;
+  for(const QString& name : am.getAttributeArrayNames())
+  {
+    IDataArray::Pointer da = am.getAttributeArray(name);
+    if(nullptr != da && !isInterpolated(*da))
+    {
+      nearestNeighborNames.push_back(name);
+    }
+  }
+  if(!nearestNeighborNames.empty())
+  {
+    QString ss = tr("The chosen interpolation is not applied to the arrays %1, which keep the nearest neighbor value").arg(nearestNeighborNames.join(", "));
+    setWarningCondition(-66764, ss);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -460,10 +477,23 @@ std::vector<double> ApplyDewarpParameters::getPxyVec()
 // -----------------------------------------------------------------------------
 void ApplyDewarpParameters::warpDataContainers(const FFTDewarpHelper::ParametersType& parameters, double imageDimX, double imageDimY)
 {
+  FFTDewarpMapCache warpMapCache;
+  if(m_UseWarpMapCache && QFileInfo::exists(m_WarpMapCacheFile) && !warpMapCache.load(m_WarpMapCacheFile))
+  {
+    QString ss = QObject::tr("Unable to read the warp map cache file '%1'. The warp maps will be recreated.").arg(m_WarpMapCacheFile);
+    setWarningCondition(-66761, ss);
+    warpMapCache.clear();
+  }
+
   // Duplicate the DataContainers used and Warp them based on the transformVector generated.
   AbstractMontage::Pointer montage = getDataContainerArray()->getMontage(m_MontageName);
   for(const auto& dcOrig : *montage)
   {
+    if(getCancel())
+    {
+      return;
+    }
+
     DataContainerShPtr dc = getDataContainerArray()->getDataContainer(m_TransformPrefix + dcOrig->getName());
     ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
     SizeVec3Type dimensions = imageGeom->getDimensions();
@@ -480,12 +510,20 @@ void ApplyDewarpParameters::warpDataContainers(const FFTDewarpHelper::Parameters
       UInt8ArrayType::Pointer maskArray = am->getAttributeArrayAs<UInt8ArrayType>(m_MaskName);
       maskArray->setInitValue(0);
 
+      // Every array in the AttributeMatrix shares the same warp map, as does every tile with the same geometry
+      FFTDewarpMap::ConstPointer warpMap = warpMapCache.getMap(FFTDewarpMap::CreateKey(parameters, dimensions, x_trans, y_trans, static_cast<FFTDewarpHelper::InterpolationType>(m_InterpolationType)));
       for(const auto& da : *am)
       {
-        transformIDataArray(parameters, dimensions, x_trans, y_trans, da);
+        transformIDataArray(*warpMap, dimensions, da);
       }
     }
   }
+
+  if(m_UseWarpMapCache && warpMapCache.isModified() && !warpMapCache.save(m_WarpMapCacheFile))
+  {
+    QString ss = QObject::tr("Unable to write the warp map cache file '%1'").arg(m_WarpMapCacheFile);
+    setWarningCondition(-66762, ss);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -747,3 +785,39 @@ void ApplyDewarpParameters::setYFactors(const FloatVec7Type& value)
   m_YFactors = value;
 }
 #endif
+
+// -----------------------------------------------------------------------------
+bool ApplyDewarpParameters::getUseWarpMapCache() const
+{
+  return m_UseWarpMapCache;
+}
+
+// -----------------------------------------------------------------------------
+void ApplyDewarpParameters::setUseWarpMapCache(bool value)
+{
+  m_UseWarpMapCache = value;
+}
+
+// -----------------------------------------------------------------------------
+QString ApplyDewarpParameters::getWarpMapCacheFile() const
+{
+  return m_WarpMapCacheFile;
+}
+
+// -----------------------------------------------------------------------------
+void ApplyDewarpParameters::setWarpMapCacheFile(const QString& value)
+{
+  m_WarpMapCacheFile = value;
+}
+
+// -----------------------------------------------------------------------------
+int ApplyDewarpParameters::getInterpolationType() const
+{
+  return m_InterpolationType;
+}
+
+// -----------------------------------------------------------------------------
+void ApplyDewarpParameters::setInterpolationType(int value)
+{
+  m_InterpolationType = value;
+}
@@ -51,6 +51,8 @@
 #endif
 #include "itkSingleValuedCostFunction.h"
 
+class AttributeMatrix;
+
 /**
  * @brief The ApplyDewarpParameters class. See [Filter documentation](@ref ApplyDewarpParameters) for details.
  */
@@ -69,6 +71,9 @@ class ITKImageProcessing_EXPORT ApplyDewarpParameters : public AbstractFilter
   PYB11_PROPERTY(QString MaskName READ getMaskName WRITE setMaskName)
   PYB11_PROPERTY(DataArrayPath TransformPath READ getTransformPath WRITE setTransformPath)
   PYB11_PROPERTY(QString TransformPrefix READ getTransformPrefix WRITE setTransformPrefix)
+  PYB11_PROPERTY(int InterpolationType READ getInterpolationType WRITE setInterpolationType)
+  PYB11_PROPERTY(bool UseWarpMapCache READ getUseWarpMapCache WRITE setUseWarpMapCache)
+  PYB11_PROPERTY(QString WarpMapCacheFile READ getWarpMapCacheFile WRITE setWarpMapCacheFile)
   PYB11_END_BINDINGS()
   // clang-format on
 
@@ -129,6 +134,18 @@ public:
   void setTransformPrefix(const QString& value);
   Q_PROPERTY(QString TransformPrefix READ getTransformPrefix WRITE setTransformPrefix)
 
+  int getInterpolationType() const;
+  void setInterpolationType(int value);
+  Q_PROPERTY(int InterpolationType READ getInterpolationType WRITE setInterpolationType)
+
+  bool getUseWarpMapCache() const;
+  void setUseWarpMapCache(bool value);
+  Q_PROPERTY(bool UseWarpMapCache READ getUseWarpMapCache WRITE setUseWarpMapCache)
+
+  QString getWarpMapCacheFile() const;
+  void setWarpMapCacheFile(const QString& value);
+  Q_PROPERTY(QString WarpMapCacheFile READ getWarpMapCacheFile WRITE setWarpMapCacheFile)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -210,6 +227,12 @@ protected:
    */
   bool checkMontageRequirements();
 
+  /**
+   * @brief Sets a warning naming the arrays of the attribute matrix that the chosen interpolation is not applied to.
+   * @param am
+   */
+  void warnNearestNeighborArrays(AttributeMatrix& am);
+
   /**
    * @brief Creates new DataContainers and warps the data by the FFT Convolution kernel generated.
    * @param parameters
@@ -238,6 +261,9 @@ private:
   QString m_MaskName = "Mask";
   bool m_UseDataArray = true;
   DataArrayPath m_TransformPath;
+  int m_InterpolationType = 0;
+  bool m_UseWarpMapCache = false;
+  QString m_WarpMapCacheFile;
 
   // FloatVec7Type m_XFactors = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
   // FloatVec7Type m_YFactors = {0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
@@ -42,7 +42,6 @@ using MutexType = tbb::queuing_mutex;
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/SIMPLRange.h"
-#include "SIMPLib/CoreFilters/ConvertColorToGrayScale.h"
 #include "SIMPLib/DataContainers/DataArrayPath.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -69,13 +68,13 @@ using MutexType = tbb::queuing_mutex;
 #include "ITKImageProcessing/ITKImageProcessingConstants.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTConvolutionCostFunction.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTDewarpHelper.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKPhaseTimer.h"
 #include "ITKImageProcessing/ITKImageProcessingVersion.h"
 
-using Grayscale_T = uint8_t;
-
 namespace
 {
-const QString InternalGrayscalePrefex = "_INTERNAL_Grayscale_";
+constexpr int k_MaxPyramidLevels = 3;
+constexpr size_t k_MinPyramidOverlapSize = 16;
 
 // -----------------------------------------------------------------------------
 // std::vector<double> convertParams2Vec(const FFTDewarpHelper::ParametersType& params)
@@ -173,6 +172,13 @@ void CalcDewarpParameters::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Max Iterations", MaxIterations, FilterParameter::Category::Parameter, CalcDewarpParameters));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Delta", Delta, FilterParameter::Category::Parameter, CalcDewarpParameters));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Fractional Convergence Tolerance", FractionalTolerance, FilterParameter::Category::Parameter, CalcDewarpParameters));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Evaluate Simplex in Parallel", ParallelEvaluation, FilterParameter::Category::Parameter, CalcDewarpParameters));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Number of Starts", NumberOfStarts, FilterParameter::Category::Parameter, CalcDewarpParameters));
+  std::vector<QString> interpolationChoices{"Nearest Neighbor", "Bilinear", "Bicubic"};
+  parameters.push_back(SIMPL_NEW_CHOICE_FP("Interpolation", InterpolationType, FilterParameter::Category::Parameter, CalcDewarpParameters, interpolationChoices, false));
+  std::vector<QString> linkedPyramidProps{"PyramidLevels"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Coarse-to-Fine Optimization", UsePyramid, FilterParameter::Category::Parameter, CalcDewarpParameters, linkedPyramidProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Pyramid Levels", PyramidLevels, FilterParameter::Category::Parameter, CalcDewarpParameters));
 
   std::vector<QString> linkedSpecifySimplexProps{"XFactors", "YFactors"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Specify Initial Simplex", SpecifyInitialSimplex, FilterParameter::Category::Parameter, CalcDewarpParameters, linkedSpecifySimplexProps));
@@ -205,6 +211,24 @@ void CalcDewarpParameters::dataCheck()
     return;
   }
 
+  if(m_InterpolationType < static_cast<int>(FFTDewarpHelper::InterpolationType::NearestNeighbor) || m_InterpolationType > static_cast<int>(FFTDewarpHelper::InterpolationType::Bicubic))
+  {
+    setErrorCondition(-66740, QString("The interpolation type %1 is not supported").arg(m_InterpolationType));
+    return;
+  }
+
+  if(m_NumberOfStarts < 1)
+  {
+    setErrorCondition(-66743, "The number of starts must be at least 1");
+    return;
+  }
+
+  if(m_UsePyramid && (m_PyramidLevels < 1 || m_PyramidLevels > k_MaxPyramidLevels))
+  {
+    setErrorCondition(-66741, QString("The number of pyramid levels must be between 1 and %1").arg(k_MaxPyramidLevels));
+    return;
+  }
+
   // The data container holds a single output attribute matrix with 3 data arrays
   // One for the number of iterations taken
   // One for the transform array
@@ -233,70 +257,150 @@ void CalcDewarpParameters::execute()
     return;
   }
 
-  // Generate internal grayscale values
-  int err = generateGrayscaleIPF();
-  if(err < 0)
+  std::vector<double> xyParameters = getPxyVec();
+  FFTDewarpHelper::ParametersType transformParams = ::convertVec2Params(xyParameters);
+
+  // The tiles are read directly in their stored type.  checkMontageRequirements has already
+  // verified that every tile uses the same supported type.
+  AbstractMontageShPtr montage = getDataContainerArray()->getMontage(getMontageName());
+  DataContainerShPtr firstTile = montage->getDataContainers().front();
+  IDataArray::Pointer tileArray = firstTile->getAttributeMatrix(m_AttributeMatrixName)->getAttributeArray(m_IPFColorsArrayName);
+  ITKPhaseTimer timer(getNameOfClass());
+  if(std::dynamic_pointer_cast<UInt8ArrayType>(tileArray))
+  {
+    transformParams = calcDewarpParameters<uint8_t>(transformParams, timer);
+  }
+  else if(std::dynamic_pointer_cast<UInt16ArrayType>(tileArray))
+  {
+    transformParams = calcDewarpParameters<uint16_t>(transformParams, timer);
+  }
+  else
+  {
+    transformParams = calcDewarpParameters<float>(transformParams, timer);
+  }
+  timer.report(this);
+
+  if(getCancel())
+  {
+    m_Optimizer = nullptr;
+    return;
+  }
+
+  // ...otherwise, set the appropriate values for the filter's output data array
+  AttributeMatrixShPtr transformAM = getDataContainerArray()->getDataContainer(m_TransformDCName)->getAttributeMatrix(m_TransformMatrixName);
+  auto transformArray = transformAM->getAttributeArrayAs<DoubleArrayType>(m_TransformArrayName);
+
+  if(transformParams.size() != transformArray->size())
   {
-    setErrorCondition(err, QObject::tr("Sub-filter ConvertColorToGrayScale failed"));
+    setErrorCondition(-87000, QObject::tr("Mismatching sizes in transform array"));
     return;
   }
-  std::vector<double> xyParameters = getPxyVec();
-  FFTDewarpHelper::ParametersType transformParams = ::convertVec2Params(xyParameters);
 
-  // The optimizer needs an initial guess; this is supplied through a filter parameter
-  FFTDewarpHelper::ParametersType initialParams = ::convertVec2Params(xyParameters);
+  std::copy(transformParams.begin(), transformParams.end(), transformArray->begin());
+  m_Optimizer = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+FFTDewarpHelper::ParametersType CalcDewarpParameters::calcDewarpParameters(const FFTDewarpHelper::ParametersType& initialParams, ITKPhaseTimer& timer)
+{
+  FFTDewarpHelper::ParametersType transformParams = initialParams;
 
-  using CostFunctionType = FFTConvolutionCostFunction;
+  using CostFunctionType = FFTConvolutionCostFunction<TPixel>;
   using ConstFucntionPointerType = typename CostFunctionType::Pointer;
   // This needs to be an ItkSmartPointer type because another object is going to increase the refcount
   ConstFucntionPointerType costFunctionObject = CostFunctionType::New();
   GridMontageShPtr gridMontage = std::dynamic_pointer_cast<GridMontage>(getDataContainerArray()->getMontage(getMontageName()));
-  costFunctionObject->Initialize(gridMontage, getDataContainerArray(), m_AttributeMatrixName, getGrayscaleArrayName());
+  costFunctionObject->setInterpolationType(static_cast<FFTDewarpHelper::InterpolationType>(m_InterpolationType));
+  costFunctionObject->setPhaseTimer(&timer);
+  {
+    ITKPhaseTimer::Scope scope(&timer, "read tiles");
+    costFunctionObject->Initialize(gridMontage, getDataContainerArray(), m_AttributeMatrixName, m_IPFColorsArrayName);
+  }
+
+  // Build the downsampled levels from the previous level so that each tile is only read once
+  std::vector<ConstFucntionPointerType> levels{costFunctionObject};
+  if(m_UsePyramid)
+  {
+    for(int level = 1; level <= m_PyramidLevels; level++)
+    {
+      ConstFucntionPointerType coarseLevel = nullptr;
+      {
+        ITKPhaseTimer::Scope scope(&timer, "downsample");
+        coarseLevel = levels.back()->createDownsampled(2);
+      }
+      if(coarseLevel->getMinimumOverlapSize() < k_MinPyramidOverlapSize)
+      {
+        QString ss = QString("The overlaps are too small for %1 pyramid levels. Only %2 levels will be used").arg(m_PyramidLevels).arg(level - 1);
+        setWarningCondition(-66742, ss);
+        break;
+      }
+      levels.push_back(coarseLevel);
+    }
+  }
+
+  // Optimize from the coarsest level to full resolution.  The parameters are converted to each
+  // level's pixel positions so that the result of one level becomes the starting simplex of the next.
+  for(size_t level = levels.size(); level > 0; level--)
+  {
+    const double factor = static_cast<double>(1 << (level - 1));
+    if(levels.size() > 1)
+    {
+      notifyStatusMessage(QString("Optimizing pyramid level %1 of %2 (1/%3 resolution)").arg(levels.size() - level + 1).arg(levels.size()).arg(factor));
+    }
+
+    const ConstFucntionPointerType& levelCostFunction = levels[level - 1];
+    FFTDewarpHelper::ParametersType levelParams = FFTDewarpHelper::scaleParameters(transformParams, factor);
+    ITKPhaseTimer::Scope scope(&timer, "optimize");
+    levelParams = optimize(levelCostFunction.GetPointer(), levelCostFunction->getImageDimX(), levelCostFunction->getImageDimY(), levelParams);
+    transformParams = FFTDewarpHelper::scaleParameters(levelParams, 1.0 / factor);
+
+    if(getCancel())
+    {
+      break;
+    }
+  }
+
+  return transformParams;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FFTDewarpHelper::ParametersType CalcDewarpParameters::optimize(itk::SingleValuedCostFunction* costFunction, double imageDimX, double imageDimY, const FFTDewarpHelper::ParametersType& initialParams)
+{
   // Calculate parameter step sizes
-  const double imgX = costFunctionObject->getImageDimX();
-  const double imgY = costFunctionObject->getImageDimY();
-  FFTDewarpHelper::ParametersType stepSizes = ::convertVec2Params(getStepSizes(xyParameters, imgX, imgY));
+  std::vector<double> xyParameters(initialParams.begin(), initialParams.end());
+  FFTDewarpHelper::ParametersType stepSizes = ::convertVec2Params(getStepSizes(xyParameters, imageDimX, imageDimY));
 
   m_Optimizer = AmoebaOptimizer::New();
   m_Optimizer->SetMaximumNumberOfIterations(m_MaxIterations);
   m_Optimizer->SetFractionalTolerance(m_FractionalTolerance);
   m_Optimizer->SetInitialPosition(initialParams);
   m_Optimizer->SetInitialSimplexDelta(stepSizes);
+  m_Optimizer->SetParallelEvaluation(m_ParallelEvaluation);
+  m_Optimizer->SetNumberOfStarts(static_cast<unsigned int>(m_NumberOfStarts));
   // m_Optimizer->SetOptimizeWithRestarts(true);
 
   m_Optimizer->SetSIMPLFilter(this);
-  m_Optimizer->SetCostFunction(costFunctionObject); // Note: Increases the refcount for costFunctionObject
-  m_Optimizer->MaximizeOn();                        // Search for the greatest value
+  m_Optimizer->SetCostFunction(costFunction); // Note: Increases the refcount for costFunction
+  m_Optimizer->MaximizeOn();                  // Search for the greatest value
   m_Optimizer->StartOptimization();
 
   // Newer versions of the optimizer allow for easier methods of output information
   // to be obtained, but until then, we have to do some string parsing from the
   // optimizer's stop description
   QString stopReason = QString::fromStdString(m_Optimizer->GetStopConditionDescription());
-  transformParams = m_Optimizer->GetCurrentPosition();
+  FFTDewarpHelper::ParametersType optimizedParams = m_Optimizer->GetCurrentPosition();
 
   // cache value
   m_Optimizer->GetValue();
   getIterationsFromStopDescription(stopReason, m_MaxIterations);
 
-  notifyStatusMessage(QString::fromStdString(m_Optimizer->GetStopConditionDescription()));
-
-  // ...otherwise, set the appropriate values for the filter's output data array
-  AttributeMatrixShPtr transformAM = getDataContainerArray()->getDataContainer(m_TransformDCName)->getAttributeMatrix(m_TransformMatrixName);
-  auto transformArray = transformAM->getAttributeArrayAs<DoubleArrayType>(m_TransformArrayName);
-
-  if(transformParams.size() != transformArray->size())
-  {
-    setErrorCondition(-87000, QObject::tr("Mismatching sizes in transform array"));
-    return;
-  }
-
-  std::copy(transformParams.begin(), transformParams.end(), transformArray->begin());
-
-  // Remove internal arrays
-  deleteGrayscaleIPF();
-  m_Optimizer = nullptr;
+  notifyStatusMessage(stopReason);
+  return optimizedParams;
 }
 
 // -----------------------------------------------------------------------------
@@ -331,6 +435,7 @@ bool CalcDewarpParameters::checkMontageRequirements()
   }
 
   // All of the types in the chosen data container's image data arrays should be the same
+  QString typeName;
   for(const auto& dc : montage->getDataContainers())
   {
     if(nullptr == dc)
@@ -346,24 +451,43 @@ bool CalcDewarpParameters::checkMontageRequirements()
       return false;
     }
 
-    DataArray<Grayscale_T>::Pointer da = am->getAttributeArrayAs<DataArray<Grayscale_T>>(m_IPFColorsArrayName);
+    IDataArray::Pointer da = am->getAttributeArray(m_IPFColorsArrayName);
     if(nullptr == da)
     {
       setErrorCondition(-66730, QString("DataArray: %1 / %2 / %3 required").arg(dc->getName()).arg(m_AttributeMatrixName).arg(m_IPFColorsArrayName));
       return false;
     }
 
-    QString typeName = da->getTypeAsString();
+    const QString tileTypeName = da->getTypeAsString();
+    if(!std::dynamic_pointer_cast<UInt8ArrayType>(da) && !std::dynamic_pointer_cast<UInt16ArrayType>(da) && !std::dynamic_pointer_cast<FloatArrayType>(da))
+    {
+      setErrorCondition(-66731, QString("DataArray: %1 / %2 / %3 must be uint8, uint16 or float").arg(dc->getName()).arg(m_AttributeMatrixName).arg(m_IPFColorsArrayName));
+      return false;
+    }
+
+    if(typeName.isEmpty())
+    {
+      typeName = tileTypeName;
+    }
+
     if(da->getComponentDimensions().size() > 1)
     {
       setErrorCondition(-66700, "Data array has unexpected dimensions");
+      return false;
     }
-    else if(da->getTypeAsString() != typeName)
+    if(tileTypeName != typeName)
     {
       setErrorCondition(-66800, "Not all data attribute arrays are the same type");
+      return false;
     }
   }
 
+  if(typeName.isEmpty())
+  {
+    setErrorCondition(-66716, QString("Montage: %1 does not contain any tiles").arg(getMontageName()));
+    return false;
+  }
+
   return true;
 }
 
@@ -459,70 +583,6 @@ std::vector<double> CalcDewarpParameters::getDefaultPy() const
   return py;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-QString CalcDewarpParameters::getGrayscaleArrayName() const
-{
-  return ::InternalGrayscalePrefex + m_IPFColorsArrayName;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int CalcDewarpParameters::generateGrayscaleIPF()
-{
-  ConvertColorToGrayScale::Pointer conversionFilter = ConvertColorToGrayScale::New();
-  conversionFilter->setConversionAlgorithm(static_cast<int>(ConvertColorToGrayScale::ConversionType::Luminosity));
-  conversionFilter->setOutputArrayPrefix(::InternalGrayscalePrefex);
-
-  connect(conversionFilter.get(), &AbstractFilter::messageGenerated, this, &AbstractFilter::messageGenerated);
-
-  AbstractMontage::Pointer montage = getDataContainerArray()->getMontage(getMontageName());
-  AbstractMontage::CollectionType dcs = montage->getDataContainers();
-  for(const auto& dc : dcs)
-  {
-    // Find IPF Colors
-    AttributeMatrix::Pointer am = dc->getAttributeMatrix(m_AttributeMatrixName);
-    DataArray<Grayscale_T>::Pointer ipfArray = am->getAttributeArrayAs<DataArray<Grayscale_T>>(m_IPFColorsArrayName);
-
-    // Create internal grayscale version
-    conversionFilter->setDataContainerArray(getDataContainerArray());
-    std::vector<DataArrayPath> dataArrayPaths;
-    dataArrayPaths.push_back(DataArrayPath(dc->getName(), m_AttributeMatrixName, m_IPFColorsArrayName));
-    conversionFilter->setInputDataArrayVector(dataArrayPaths);
-
-    conversionFilter->execute();
-    int err = conversionFilter->getErrorCode();
-    if(err < 0)
-    {
-      return err;
-    }
-  }
-
-  return 0;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void CalcDewarpParameters::deleteGrayscaleIPF()
-{
-  AbstractMontage::Pointer montage = getDataContainerArray()->getMontage(getMontageName());
-  AbstractMontage::CollectionType dcs = montage->getDataContainers();
-  for(const auto& dc : dcs)
-  {
-    // Find internal IPF grayscale
-    AttributeMatrix::Pointer am = dc->getAttributeMatrix(m_AttributeMatrixName);
-
-    const QString internalArrayName = getGrayscaleArrayName();
-    if(am->hasChildWithName(internalArrayName))
-    {
-      am->removeAttributeArray(internalArrayName);
-    }
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -826,3 +886,63 @@ void CalcDewarpParameters::setTransformDCName(const QString& value)
 {
   m_TransformDCName = value;
 }
+
+// -----------------------------------------------------------------------------
+int CalcDewarpParameters::getInterpolationType() const
+{
+  return m_InterpolationType;
+}
+
+// -----------------------------------------------------------------------------
+void CalcDewarpParameters::setInterpolationType(int value)
+{
+  m_InterpolationType = value;
+}
+
+// -----------------------------------------------------------------------------
+bool CalcDewarpParameters::getUsePyramid() const
+{
+  return m_UsePyramid;
+}
+
+// -----------------------------------------------------------------------------
+void CalcDewarpParameters::setUsePyramid(bool value)
+{
+  m_UsePyramid = value;
+}
+
+// -----------------------------------------------------------------------------
+int CalcDewarpParameters::getPyramidLevels() const
+{
+  return m_PyramidLevels;
+}
+
+// -----------------------------------------------------------------------------
+void CalcDewarpParameters::setPyramidLevels(int value)
+{
+  m_PyramidLevels = value;
+}
+
+// -----------------------------------------------------------------------------
+bool CalcDewarpParameters::getParallelEvaluation() const
+{
+  return m_ParallelEvaluation;
+}
+
+// -----------------------------------------------------------------------------
+void CalcDewarpParameters::setParallelEvaluation(bool value)
+{
+  m_ParallelEvaluation = value;
+}
+
+// -----------------------------------------------------------------------------
+int CalcDewarpParameters::getNumberOfStarts() const
+{
+  return m_NumberOfStarts;
+}
+
+// -----------------------------------------------------------------------------
+void CalcDewarpParameters::setNumberOfStarts(int value)
+{
+  m_NumberOfStarts = value;
+}
@@ -53,6 +53,8 @@
 
 #include "itkSingleValuedCostFunction.h"
 
+class ITKPhaseTimer;
+
 /**
  * @brief The CalcDewarpParameters class. See [Filter documentation](@ref CalcDewarpParameters) for details.
  */
@@ -71,6 +73,11 @@ class ITKImageProcessing_EXPORT CalcDewarpParameters : public AbstractFilter
   PYB11_PROPERTY(double FractionalTolerance READ getFractionalTolerance WRITE setFractionalTolerance)
   PYB11_PROPERTY(int Delta READ getDelta WRITE setDelta)
   PYB11_PROPERTY(bool SpecifyInitialSimplex READ getSpecifyInitialSimplex WRITE setSpecifyInitialSimplex)
+  PYB11_PROPERTY(int InterpolationType READ getInterpolationType WRITE setInterpolationType)
+  PYB11_PROPERTY(bool UsePyramid READ getUsePyramid WRITE setUsePyramid)
+  PYB11_PROPERTY(int PyramidLevels READ getPyramidLevels WRITE setPyramidLevels)
+  PYB11_PROPERTY(bool ParallelEvaluation READ getParallelEvaluation WRITE setParallelEvaluation)
+  PYB11_PROPERTY(int NumberOfStarts READ getNumberOfStarts WRITE setNumberOfStarts)
   PYB11_PROPERTY(FloatVec7Type XFactors READ getXFactors WRITE setXFactors)
   PYB11_PROPERTY(FloatVec7Type YFactors READ getYFactors WRITE setYFactors)
   PYB11_PROPERTY(QString AttributeMatrixName READ getAttributeMatrixName WRITE setAttributeMatrixName)
@@ -128,6 +135,26 @@ public:
   void setSpecifyInitialSimplex(bool value);
   Q_PROPERTY(bool SpecifyInitialSimplex READ getSpecifyInitialSimplex WRITE setSpecifyInitialSimplex)
 
+  int getInterpolationType() const;
+  void setInterpolationType(int value);
+  Q_PROPERTY(int InterpolationType READ getInterpolationType WRITE setInterpolationType)
+
+  bool getUsePyramid() const;
+  void setUsePyramid(bool value);
+  Q_PROPERTY(bool UsePyramid READ getUsePyramid WRITE setUsePyramid)
+
+  int getPyramidLevels() const;
+  void setPyramidLevels(int value);
+  Q_PROPERTY(int PyramidLevels READ getPyramidLevels WRITE setPyramidLevels)
+
+  bool getParallelEvaluation() const;
+  void setParallelEvaluation(bool value);
+  Q_PROPERTY(bool ParallelEvaluation READ getParallelEvaluation WRITE setParallelEvaluation)
+
+  int getNumberOfStarts() const;
+  void setNumberOfStarts(int value);
+  Q_PROPERTY(int NumberOfStarts READ getNumberOfStarts WRITE setNumberOfStarts)
+
   FloatVec7Type getXFactors() const;
   void setXFactors(const FloatVec7Type& value);
   Q_PROPERTY(FloatVec7Type XFactors READ getXFactors WRITE setXFactors)
@@ -256,20 +283,14 @@ protected:
   bool checkMontageRequirements();
 
   /**
-   * @brief Returns the name used for the internal grayscale array.
+   * @brief Builds the cost function for tiles of TPixel, including the downsampled pyramid levels,
+   * and optimizes from the coarsest level to full resolution.  Returns the full resolution parameters.
+   * @param initialParams
+   * @param timer Records the time spent reading the tiles, downsampling and optimizing
    * @return
    */
-  QString getGrayscaleArrayName() const;
-
-  /**
-   * @brief Generates internal grayscale array.
-   */
-  int generateGrayscaleIPF();
-
-  /**
-   * @brief Removes internal grayscale array.
-   */
-  void deleteGrayscaleIPF();
+  template <typename TPixel>
+  itk::SingleValuedCostFunction::ParametersType calcDewarpParameters(const itk::SingleValuedCostFunction::ParametersType& initialParams, ITKPhaseTimer& timer);
 
   /**
    * @brief Returns the required length for either X or Y parameters.
@@ -287,6 +308,18 @@ protected:
    */
   std::vector<double> getStepSizes(const std::vector<double>& params, size_t imgDimX, size_t imgDimY) const;
 
+  /**
+   * @brief Runs the optimizer on the given cost function starting from the initial parameters
+   * and returns the optimized parameters.  The parameters use the cost function's pixel positions.
+   * @param costFunction
+   * @param imageDimX
+   * @param imageDimY
+   * @param initialParams
+   * @return
+   */
+  itk::SingleValuedCostFunction::ParametersType optimize(itk::SingleValuedCostFunction* costFunction, double imageDimX, double imageDimY,
+                                                         const itk::SingleValuedCostFunction::ParametersType& initialParams);
+
 private:
   AmoebaOptimizer::Pointer m_Optimizer = nullptr;
   QString m_MontageName;
@@ -294,6 +327,11 @@ private:
   double m_FractionalTolerance = 1E-5;
   int m_StepDelta = 5;
   bool m_SpecifyInitialSimplex = true;
+  int m_InterpolationType = 0;
+  bool m_UsePyramid = false;
+  int m_PyramidLevels = 3;
+  bool m_ParallelEvaluation = false;
+  int m_NumberOfStarts = 1;
   QString m_AttributeMatrixName;
   QString m_IPFColorsArrayName = "IPFColor";
   QString m_TransformDCName = "Dewarp Data";
@@ -14,7 +14,11 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/ITK/SimpleITKEnums.h"
 
-#include "SIMPLib/ITK/Dream3DTemplateAliasMacro.h"
+namespace
+{
+using SupportedPixelTypes = ITKPixelTypeList::StandardPixelTypes;
+using SupportedDimensions = ITKPixelTypeList::AllDimensions;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -33,6 +37,8 @@ void ITKAbsImage::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -56,9 +62,18 @@ void ITKAbsImage::readFilterParameters(AbstractFilterParametersReader* reader, i
   setSelectedCellArrayPath(reader->readDataArrayPath("SelectedCellArrayPath", getSelectedCellArrayPath()));
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKAbsImage::supportsStreamOutput() const
+{
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -78,7 +93,7 @@ void ITKAbsImage::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  Dream3DArraySwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
@@ -101,7 +116,7 @@ void ITKAbsImage::filter()
 // -----------------------------------------------------------------------------
 void ITKAbsImage::filterInternal()
 {
-  Dream3DArraySwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
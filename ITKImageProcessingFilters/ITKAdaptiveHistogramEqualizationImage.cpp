@@ -14,7 +14,11 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/ITK/SimpleITKEnums.h"
 
-#include "SIMPLib/ITK/Dream3DTemplateAliasMacro.h"
+namespace
+{
+using SupportedPixelTypes = ITKPixelTypeList::StandardPixelTypes;
+using SupportedDimensions = ITKPixelTypeList::AllDimensions;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -42,6 +46,8 @@ void ITKAdaptiveHistogramEqualizationImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Alpha", Alpha, FilterParameter::Category::Parameter, ITKAdaptiveHistogramEqualizationImage));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Beta", Beta, FilterParameter::Category::Parameter, ITKAdaptiveHistogramEqualizationImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -68,6 +74,7 @@ void ITKAdaptiveHistogramEqualizationImage::readFilterParameters(AbstractFilterP
   setAlpha(reader->readValue("Alpha", getAlpha()));
   setBeta(reader->readValue("Beta", getBeta()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -90,7 +97,7 @@ void ITKAdaptiveHistogramEqualizationImage::dataCheck()
 {
   clearErrorCode();
   clearWarningCode();
-  Dream3DArraySwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
@@ -116,7 +123,7 @@ void ITKAdaptiveHistogramEqualizationImage::filter()
 // -----------------------------------------------------------------------------
 void ITKAdaptiveHistogramEqualizationImage::filterInternal()
 {
-  Dream3DArraySwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
@@ -40,6 +40,8 @@ void ITKApproximateSignedDistanceMapImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("InsideValue", InsideValue, FilterParameter::Category::Parameter, ITKApproximateSignedDistanceMapImage));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("OutsideValue", OutsideValue, FilterParameter::Category::Parameter, ITKApproximateSignedDistanceMapImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -65,6 +67,7 @@ void ITKApproximateSignedDistanceMapImage::readFilterParameters(AbstractFilterPa
   setInsideValue(reader->readValue("InsideValue", getInsideValue()));
   setOutsideValue(reader->readValue("OutsideValue", getOutsideValue()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
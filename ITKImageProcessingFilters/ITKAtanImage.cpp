@@ -14,7 +14,11 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/ITK/SimpleITKEnums.h"
 
-#include "SIMPLib/ITK/Dream3DTemplateAliasMacro.h"
+namespace
+{
+using SupportedPixelTypes = ITKPixelTypeList::RealPixelTypes;
+using SupportedDimensions = ITKPixelTypeList::AllDimensions;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -33,6 +37,8 @@ void ITKAtanImage::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -56,9 +62,18 @@ void ITKAtanImage::readFilterParameters(AbstractFilterParametersReader* reader,
   setSelectedCellArrayPath(reader->readDataArrayPath("SelectedCellArrayPath", getSelectedCellArrayPath()));
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKAtanImage::supportsStreamOutput() const
+{
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -77,7 +92,7 @@ void ITKAtanImage::dataCheck()
 {
   clearErrorCode();
   clearWarningCode();
-  Dream3DArraySwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
@@ -100,7 +115,7 @@ void ITKAtanImage::filter()
 // -----------------------------------------------------------------------------
 void ITKAtanImage::filterInternal()
 {
-  Dream3DArraySwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
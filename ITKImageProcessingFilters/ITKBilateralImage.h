@@ -140,6 +140,12 @@ protected:
   template <typename InputImageType, typename OutputImageType, unsigned int Dimension>
   void dataCheckImpl();
 
+  /**
+   * @brief supportsStreamOutput Reimplemented from @see ITKImageBase class.  Each output pixel only depends on a
+   * fixed neighborhood of the input, which ITK adds to the requested region of every chunk.
+   */
+  bool supportsStreamOutput() const override;
+
   /**
    * @brief filterInternal overloads filterInternal in ITKImageBase and calls templated filter
    */
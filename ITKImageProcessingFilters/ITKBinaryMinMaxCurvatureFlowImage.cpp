@@ -44,6 +44,8 @@ void ITKBinaryMinMaxCurvatureFlowImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("StencilRadius", StencilRadius, FilterParameter::Category::Parameter, ITKBinaryMinMaxCurvatureFlowImage));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Threshold", Threshold, FilterParameter::Category::Parameter, ITKBinaryMinMaxCurvatureFlowImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -71,6 +73,7 @@ void ITKBinaryMinMaxCurvatureFlowImage::readFilterParameters(AbstractFilterParam
   setStencilRadius(reader->readValue("StencilRadius", getStencilRadius()));
   setThreshold(reader->readValue("Threshold", getThreshold()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -56,6 +56,8 @@ void ITKCastImage::setupFilterParameters()
     parameters.push_back(parameter);
   }
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -80,9 +82,18 @@ void ITKCastImage::readFilterParameters(AbstractFilterParametersReader* reader,
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setCastingType(reader->readValue("CastingType", getCastingType()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKCastImage::supportsStreamOutput() const
+{
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -112,6 +112,12 @@ protected:
   template <typename InputImageType, typename OutputImageType, unsigned int Dimension>
   void dataCheckImpl();
 
+  /**
+   * @brief supportsStreamOutput Reimplemented from @see ITKImageBase class.  Each output pixel only depends on the
+   * input pixel at the same position, so every chunk matches the unstreamed output.
+   */
+  bool supportsStreamOutput() const override;
+
   /**
    * @brief filterInternal overloads filterInternal in ITKImageBase and calls templated filter
    */
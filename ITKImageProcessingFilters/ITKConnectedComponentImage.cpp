@@ -38,6 +38,8 @@ void ITKConnectedComponentImage::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_BOOL_FP("FullyConnected", FullyConnected, FilterParameter::Category::Parameter, ITKConnectedComponentImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -62,6 +64,7 @@ void ITKConnectedComponentImage::readFilterParameters(AbstractFilterParametersRe
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setFullyConnected(reader->readValue("FullyConnected", getFullyConnected()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
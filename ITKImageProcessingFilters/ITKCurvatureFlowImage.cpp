@@ -40,6 +40,8 @@ void ITKCurvatureFlowImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("TimeStep", TimeStep, FilterParameter::Category::Parameter, ITKCurvatureFlowImage));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("NumberOfIterations", NumberOfIterations, FilterParameter::Category::Parameter, ITKCurvatureFlowImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -65,6 +67,7 @@ void ITKCurvatureFlowImage::readFilterParameters(AbstractFilterParametersReader*
   setTimeStep(reader->readValue("TimeStep", getTimeStep()));
   setNumberOfIterations(reader->readValue("NumberOfIterations", getNumberOfIterations()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -50,6 +50,8 @@ void ITKDoubleThresholdImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("OutsideValue", OutsideValue, FilterParameter::Category::Parameter, ITKDoubleThresholdImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("FullyConnected", FullyConnected, FilterParameter::Category::Parameter, ITKDoubleThresholdImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -80,6 +82,7 @@ void ITKDoubleThresholdImage::readFilterParameters(AbstractFilterParametersReade
   setOutsideValue(reader->readValue("OutsideValue", getOutsideValue()));
   setFullyConnected(reader->readValue("FullyConnected", getFullyConnected()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -72,6 +72,14 @@ void ITKFFTNormalizedCorrelationImage::readFilterParameters(AbstractFilterParame
   reader->closeFilterGroup();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKFFTNormalizedCorrelationImage::supportsPipelineLink() const
+{
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
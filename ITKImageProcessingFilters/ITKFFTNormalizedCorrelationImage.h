@@ -127,6 +127,12 @@ public:
    */
   void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
 
+  /**
+   * @brief supportsPipelineLink Reimplemented from @see ITKImageBase class.  Both images are read directly
+   * from their DataArrays, so the filter cannot be chained.
+   */
+  bool supportsPipelineLink() const override;
+
 protected:
   ITKFFTNormalizedCorrelationImage();
 
@@ -38,6 +38,8 @@ void ITKGradientMagnitudeImage::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_BOOL_FP("UseImageSpacing", UseImageSpacing, FilterParameter::Category::Parameter, ITKGradientMagnitudeImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -62,9 +64,18 @@ void ITKGradientMagnitudeImage::readFilterParameters(AbstractFilterParametersRea
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setUseImageSpacing(reader->readValue("UseImageSpacing", getUseImageSpacing()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKGradientMagnitudeImage::supportsStreamOutput() const
+{
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
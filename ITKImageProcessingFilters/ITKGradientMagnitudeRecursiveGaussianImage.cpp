@@ -40,6 +40,8 @@ void ITKGradientMagnitudeRecursiveGaussianImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Sigma", Sigma, FilterParameter::Category::Parameter, ITKGradientMagnitudeRecursiveGaussianImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("NormalizeAcrossScale", NormalizeAcrossScale, FilterParameter::Category::Parameter, ITKGradientMagnitudeRecursiveGaussianImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -65,6 +67,7 @@ void ITKGradientMagnitudeRecursiveGaussianImage::readFilterParameters(AbstractFi
   setSigma(reader->readValue("Sigma", getSigma()));
   setNormalizeAcrossScale(reader->readValue("NormalizeAcrossScale", getNormalizeAcrossScale()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -4,6 +4,43 @@
 
 #include "ITKImageBase.h"
 
+#include <itkConfigure.h>
+#if ITK_VERSION_MAJOR >= 5
+#include <itkPoolMultiThreader.h>
+#if defined(ITK_USE_TBB)
+#include <itkTBBMultiThreader.h>
+#endif
+#endif
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+namespace
+{
+enum class MultiThreaderType : int
+{
+  Default = 0,
+  Pool = 1,
+  TBB = 2
+};
+
+// Parameters that change how the output is computed but not its values
+const QStringList k_ResultCacheIgnoredParameters = {"StreamOutput",      "StreamingDivisions", "StreamingMemoryBudget", "MaximumNumberOfThreads",
+                                                    "NumberOfWorkUnits", "MultiThreaderType",  "UseResultCache",        "ResultCacheSize"};
+
+// Large arrays are hashed in chunks so that the filter can be canceled
+constexpr size_t k_HashChunkSize = 64 * 1024 * 1024;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -33,7 +70,14 @@ void ITKImageBase::initialize()
 void ITKImageBase::execute()
 {
   initialize();
+  // Outputs that only feed the next filter of a pipeline segment are created without allocating them
+  const bool inPreflight = getInPreflight();
+  if(nullptr != m_PipelineLink && !m_PipelineLink->getWriteOutput())
+  {
+    setInPreflight(true);
+  }
   dataCheck();
+  setInPreflight(inPreflight);
   if(getErrorCode() < 0)
   {
     return;
@@ -42,7 +86,408 @@ void ITKImageBase::execute()
   {
     return;
   }
+
+  // Pipeline segments never write most outputs, so there is nothing to cache
+  const bool useResultCache = m_UseResultCache && nullptr == m_PipelineLink && getResultCacheOutputPath().isValid();
+  ITKResultCache::Key cacheKey;
+  if(useResultCache)
+  {
+    if(!computeResultCacheKey(cacheKey))
+    {
+      return;
+    }
+    if(restoreCachedResult(cacheKey))
+    {
+      notifyStatusMessage("Reused the cached result of a previous execution");
+      return;
+    }
+  }
+
   this->filterInternal();
+
+  if(useResultCache && getErrorCode() >= 0 && !getCancel())
+  {
+    cacheResult(cacheKey);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayPath ITKImageBase::getResultCacheOutputPath() const
+{
+  return DataArrayPath();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKImageBase::computeResultCacheKey(ITKResultCache::Key& key)
+{
+  ITKResultCache::Hasher hasher;
+
+  const QByteArray className = getNameOfClass().toUtf8();
+  hasher.add(className.constData(), static_cast<size_t>(className.size()));
+
+  QJsonObject parametersJson;
+  FilterParameterVectorType parameters = getFilterParameters();
+  for(const FilterParameter::Pointer& parameter : parameters)
+  {
+    parameter->writeJson(parametersJson);
+  }
+  for(const QString& name : k_ResultCacheIgnoredParameters)
+  {
+    parametersJson.remove(name);
+  }
+  const QByteArray parametersBytes = QJsonDocument(parametersJson).toJson(QJsonDocument::Compact);
+  hasher.add(parametersBytes.constData(), static_cast<size_t>(parametersBytes.size()));
+
+  // The paths are part of the parameters, the values and geometry of the arrays are hashed here
+  for(const FilterParameter::Pointer& parameter : parameters)
+  {
+    DataArraySelectionFilterParameter::Pointer selection = std::dynamic_pointer_cast<DataArraySelectionFilterParameter>(parameter);
+    if(nullptr == selection || !selection->getGetterCallback())
+    {
+      continue;
+    }
+    const DataArrayPath path = selection->getGetterCallback()();
+    AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(path);
+    IDataArray::Pointer array = (nullptr == am) ? IDataArray::NullPointer() : am->getAttributeArray(path.getDataArrayName());
+    if(nullptr == array)
+    {
+      continue;
+    }
+
+    const QByteArray type = array->getTypeAsString().toUtf8();
+    hasher.add(type.constData(), static_cast<size_t>(type.size()));
+    hasher.addValue(static_cast<uint64_t>(array->getNumberOfTuples()));
+    for(size_t dim : array->getComponentDimensions())
+    {
+      hasher.addValue(static_cast<uint64_t>(dim));
+    }
+
+    DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(path.getDataContainerName());
+    ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
+    if(nullptr != imageGeom)
+    {
+      const SizeVec3Type dims = imageGeom->getDimensions();
+      const FloatVec3Type spacing = imageGeom->getSpacing();
+      const FloatVec3Type origin = imageGeom->getOrigin();
+      for(size_t i = 0; i < 3; i++)
+      {
+        hasher.addValue(static_cast<uint64_t>(dims[i]));
+        hasher.addValue(spacing[i]);
+        hasher.addValue(origin[i]);
+      }
+    }
+
+    const auto* values = static_cast<const uint8_t*>(array->getVoidPointer(0));
+    const size_t bytes = ITKResultCache::GetArraySizeInBytes(*array);
+    for(size_t offset = 0; nullptr != values && offset < bytes; offset += k_HashChunkSize)
+    {
+      if(getCancel())
+      {
+        return false;
+      }
+      hasher.add(values + offset, std::min(k_HashChunkSize, bytes - offset));
+    }
+  }
+
+  key = hasher.finish();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKImageBase::restoreCachedResult(const ITKResultCache::Key& key)
+{
+  IDataArray::Pointer cached = ITKResultCache::Instance()->find(key);
+  if(nullptr == cached)
+  {
+    return false;
+  }
+
+  const DataArrayPath outputPath = getResultCacheOutputPath();
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(outputPath);
+  if(nullptr == am || am->getNumberOfTuples() != cached->getNumberOfTuples())
+  {
+    return false;
+  }
+
+  // The cached array stays untouched so later executions can reuse it as well
+  IDataArray::Pointer output = cached->deepCopy();
+  output->setName(outputPath.getDataArrayName());
+  am->insertOrAssign(output);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKImageBase::cacheResult(const ITKResultCache::Key& key)
+{
+  const DataArrayPath outputPath = getResultCacheOutputPath();
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(outputPath);
+  IDataArray::Pointer output = (nullptr == am) ? IDataArray::NullPointer() : am->getAttributeArray(outputPath.getDataArrayName());
+  if(nullptr == output)
+  {
+    return;
+  }
+  const size_t budget = static_cast<size_t>(m_ResultCacheSize) * 1024 * 1024;
+  if(ITKResultCache::GetArraySizeInBytes(*output) > budget)
+  {
+    return;
+  }
+  ITKResultCache::Instance()->insert(key, output->deepCopy(), budget);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKImageBase::addExecutionFilterParameters(FilterParameterVectorType& parameters)
+{
+  if(supportsStreamOutput())
+  {
+    parameters.push_back(SeparatorFilterParameter::Create("Streaming", FilterParameter::Category::Parameter));
+    std::vector<QString> linkedStreamingProps{"StreamingDivisions", "StreamingMemoryBudget"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stream Output", StreamOutput, FilterParameter::Category::Parameter, ITKImageBase, linkedStreamingProps));
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Number of Stream Divisions (0 = Use Memory Budget)", StreamingDivisions, FilterParameter::Category::Parameter, ITKImageBase));
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Streaming Memory Budget (MB)", StreamingMemoryBudget, FilterParameter::Category::Parameter, ITKImageBase));
+  }
+
+  parameters.push_back(SeparatorFilterParameter::Create("Threading", FilterParameter::Category::Parameter));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Maximum Number of Threads (0 = Default)", MaximumNumberOfThreads, FilterParameter::Category::Parameter, ITKImageBase));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Number of Work Units (0 = Default)", NumberOfWorkUnits, FilterParameter::Category::Parameter, ITKImageBase));
+  std::vector<QString> multiThreaderChoices{"Default", "Thread Pool", "TBB"};
+  parameters.push_back(SIMPL_NEW_CHOICE_FP("Multi-Threader", MultiThreaderType, FilterParameter::Category::Parameter, ITKImageBase, multiThreaderChoices, false));
+
+  parameters.push_back(SeparatorFilterParameter::Create("Result Cache", FilterParameter::Category::Parameter));
+  std::vector<QString> linkedCacheProps{"ResultCacheSize"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Result Cache", UseResultCache, FilterParameter::Category::Parameter, ITKImageBase, linkedCacheProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Result Cache Size (MB)", ResultCacheSize, FilterParameter::Category::Parameter, ITKImageBase));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKImageBase::supportsStreamOutput() const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKImageBase::readExecutionFilterParameters(AbstractFilterParametersReader* reader)
+{
+  if(supportsStreamOutput())
+  {
+    setStreamOutput(reader->readValue("StreamOutput", getStreamOutput()));
+    setStreamingDivisions(reader->readValue("StreamingDivisions", getStreamingDivisions()));
+    setStreamingMemoryBudget(reader->readValue("StreamingMemoryBudget", getStreamingMemoryBudget()));
+  }
+  setMaximumNumberOfThreads(reader->readValue("MaximumNumberOfThreads", getMaximumNumberOfThreads()));
+  setNumberOfWorkUnits(reader->readValue("NumberOfWorkUnits", getNumberOfWorkUnits()));
+  setMultiThreaderType(reader->readValue("MultiThreaderType", getMultiThreaderType()));
+  setUseResultCache(reader->readValue("UseResultCache", getUseResultCache()));
+  setResultCacheSize(reader->readValue("ResultCacheSize", getResultCacheSize()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKImageBase::checkExecutionParameters()
+{
+  if(m_StreamOutput)
+  {
+    if(m_StreamingDivisions < 0)
+    {
+      setErrorCondition(-55560, "The number of stream divisions must be 0 or greater");
+    }
+    else if(m_StreamingDivisions == 0 && m_StreamingMemoryBudget <= 0)
+    {
+      setErrorCondition(-55561, "The streaming memory budget must be greater than 0 MB when the number of stream divisions is 0");
+    }
+  }
+
+  if(m_MaximumNumberOfThreads < 0)
+  {
+    setErrorCondition(-55562, "The maximum number of threads must be 0 or greater");
+  }
+  if(m_NumberOfWorkUnits < 0)
+  {
+    setErrorCondition(-55563, "The number of work units must be 0 or greater");
+  }
+  if(m_MultiThreaderType < static_cast<int>(MultiThreaderType::Default) || m_MultiThreaderType > static_cast<int>(MultiThreaderType::TBB))
+  {
+    setErrorCondition(-55564, "Invalid multi-threader selection");
+  }
+#if ITK_VERSION_MAJOR < 5 || !defined(ITK_USE_TBB)
+  else if(m_MultiThreaderType == static_cast<int>(MultiThreaderType::TBB))
+  {
+    setWarningCondition(-55565, "ITK was built without TBB. The default multi-threader is used instead.");
+  }
+#endif
+
+  if(m_UseResultCache && m_ResultCacheSize <= 0)
+  {
+    setErrorCondition(-55566, "The result cache size must be greater than 0 MB");
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKImageBase::applyThreading(itk::ProcessObject* processObject) const
+{
+#if ITK_VERSION_MAJOR >= 5
+  itk::MultiThreaderBase::Pointer threader;
+  switch(static_cast<MultiThreaderType>(m_MultiThreaderType))
+  {
+  case MultiThreaderType::Pool:
+    threader = itk::PoolMultiThreader::New();
+    break;
+#if defined(ITK_USE_TBB)
+  case MultiThreaderType::TBB:
+    threader = itk::TBBMultiThreader::New();
+    break;
+#endif
+  default:
+    break;
+  }
+  if(nullptr != threader)
+  {
+    processObject->SetMultiThreader(threader);
+  }
+  if(m_MaximumNumberOfThreads > 0)
+  {
+    processObject->GetMultiThreader()->SetMaximumNumberOfThreads(static_cast<itk::ThreadIdType>(m_MaximumNumberOfThreads));
+  }
+  if(m_NumberOfWorkUnits > 0)
+  {
+    processObject->SetNumberOfWorkUnits(static_cast<itk::ThreadIdType>(m_NumberOfWorkUnits));
+  }
+#else
+  if(m_MaximumNumberOfThreads > 0)
+  {
+    processObject->SetNumberOfThreads(static_cast<itk::ThreadIdType>(m_MaximumNumberOfThreads));
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setPipelineLink(const ITKPipelineLink::Pointer& value)
+{
+  m_PipelineLink = value;
+}
+
+// -----------------------------------------------------------------------------
+ITKPipelineLink::Pointer ITKImageBase::getPipelineLink() const
+{
+  return m_PipelineLink;
+}
+
+// -----------------------------------------------------------------------------
+bool ITKImageBase::supportsPipelineLink() const
+{
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setStreamOutput(bool value)
+{
+  m_StreamOutput = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ITKImageBase::getStreamOutput() const
+{
+  return m_StreamOutput;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setStreamingDivisions(int value)
+{
+  m_StreamingDivisions = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKImageBase::getStreamingDivisions() const
+{
+  return m_StreamingDivisions;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setStreamingMemoryBudget(int value)
+{
+  m_StreamingMemoryBudget = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKImageBase::getStreamingMemoryBudget() const
+{
+  return m_StreamingMemoryBudget;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setMaximumNumberOfThreads(int value)
+{
+  m_MaximumNumberOfThreads = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKImageBase::getMaximumNumberOfThreads() const
+{
+  return m_MaximumNumberOfThreads;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setNumberOfWorkUnits(int value)
+{
+  m_NumberOfWorkUnits = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKImageBase::getNumberOfWorkUnits() const
+{
+  return m_NumberOfWorkUnits;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setMultiThreaderType(int value)
+{
+  m_MultiThreaderType = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKImageBase::getMultiThreaderType() const
+{
+  return m_MultiThreaderType;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setUseResultCache(bool value)
+{
+  m_UseResultCache = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ITKImageBase::getUseResultCache() const
+{
+  return m_UseResultCache;
+}
+
+// -----------------------------------------------------------------------------
+void ITKImageBase::setResultCacheSize(int value)
+{
+  m_ResultCacheSize = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKImageBase::getResultCacheSize() const
+{
+  return m_ResultCacheSize;
 }
 
 // -----------------------------------------------------------------------------
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include "SIMPLib/SIMPLib.h"
@@ -15,9 +17,13 @@
 
 #include <itkCastImageFilter.h>
 #include <itkNumericTraits.h>
+#include <itkStreamingImageFilter.h>
 #include "itkImageToImageFilter.h"
 
 #include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKDataArrayImageView.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKPipelineLink.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKResultCache.h"
 
 // There is a known overflow for the templates but the code seems to work correctly so disable the warning
 #if(_MSC_VER >= 1)
@@ -34,6 +40,14 @@ class ITKImageProcessing_EXPORT ITKImageBase : public AbstractFilter
   // Start Python bindings declarations
   PYB11_BEGIN_BINDINGS(ITKImageBase SUPERCLASS AbstractFilter)
   PYB11_SHARED_POINTERS(ITKImageBase)
+  PYB11_PROPERTY(bool StreamOutput READ getStreamOutput WRITE setStreamOutput)
+  PYB11_PROPERTY(int StreamingDivisions READ getStreamingDivisions WRITE setStreamingDivisions)
+  PYB11_PROPERTY(int StreamingMemoryBudget READ getStreamingMemoryBudget WRITE setStreamingMemoryBudget)
+  PYB11_PROPERTY(int MaximumNumberOfThreads READ getMaximumNumberOfThreads WRITE setMaximumNumberOfThreads)
+  PYB11_PROPERTY(int NumberOfWorkUnits READ getNumberOfWorkUnits WRITE setNumberOfWorkUnits)
+  PYB11_PROPERTY(int MultiThreaderType READ getMultiThreaderType WRITE setMultiThreaderType)
+  PYB11_PROPERTY(bool UseResultCache READ getUseResultCache WRITE setUseResultCache)
+  PYB11_PROPERTY(int ResultCacheSize READ getResultCacheSize WRITE setResultCacheSize)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -61,6 +75,114 @@ public:
    */
   void execute() override;
 
+  /**
+   * @brief Sets the link used to chain this filter's ITK filter to the previous and next filters of an
+   * ITKPipelineSegment.  Set to nullptr to read and write DataArrays as usual.
+   */
+  void setPipelineLink(const ITKPipelineLink::Pointer& value);
+  /**
+   * @brief Returns the pipeline link or nullptr if the filter runs on its own.
+   */
+  ITKPipelineLink::Pointer getPipelineLink() const;
+  /**
+   * @brief Returns whether the filter reads its input from and writes its output to the pipeline link.
+   * Filters that build their ITK input directly from DataArrays cannot be chained in an ITKPipelineSegment.
+   */
+  virtual bool supportsPipelineLink() const;
+
+  /**
+   * @brief Setter property for StreamOutput.  When true, the output is computed in chunks by an
+   * itk::StreamingImageFilter so that ITK only allocates buffers for one chunk at a time.
+   */
+  void setStreamOutput(bool value);
+  /**
+   * @brief Getter property for StreamOutput
+   * @return Value of StreamOutput
+   */
+  bool getStreamOutput() const;
+  Q_PROPERTY(bool StreamOutput READ getStreamOutput WRITE setStreamOutput)
+
+  /**
+   * @brief Setter property for StreamingDivisions.  0 computes the number of chunks from StreamingMemoryBudget.
+   */
+  void setStreamingDivisions(int value);
+  /**
+   * @brief Getter property for StreamingDivisions
+   * @return Value of StreamingDivisions
+   */
+  int getStreamingDivisions() const;
+  Q_PROPERTY(int StreamingDivisions READ getStreamingDivisions WRITE setStreamingDivisions)
+
+  /**
+   * @brief Setter property for StreamingMemoryBudget, in MB, for the ITK buffers of one chunk.
+   */
+  void setStreamingMemoryBudget(int value);
+  /**
+   * @brief Getter property for StreamingMemoryBudget
+   * @return Value of StreamingMemoryBudget
+   */
+  int getStreamingMemoryBudget() const;
+  Q_PROPERTY(int StreamingMemoryBudget READ getStreamingMemoryBudget WRITE setStreamingMemoryBudget)
+
+  /**
+   * @brief Setter property for MaximumNumberOfThreads.  0 uses ITK's global default.
+   */
+  void setMaximumNumberOfThreads(int value);
+  /**
+   * @brief Getter property for MaximumNumberOfThreads
+   * @return Value of MaximumNumberOfThreads
+   */
+  int getMaximumNumberOfThreads() const;
+  Q_PROPERTY(int MaximumNumberOfThreads READ getMaximumNumberOfThreads WRITE setMaximumNumberOfThreads)
+
+  /**
+   * @brief Setter property for NumberOfWorkUnits, the number of pieces each ITK filter splits its
+   * output in.  0 uses ITK's global default.
+   */
+  void setNumberOfWorkUnits(int value);
+  /**
+   * @brief Getter property for NumberOfWorkUnits
+   * @return Value of NumberOfWorkUnits
+   */
+  int getNumberOfWorkUnits() const;
+  Q_PROPERTY(int NumberOfWorkUnits READ getNumberOfWorkUnits WRITE setNumberOfWorkUnits)
+
+  /**
+   * @brief Setter property for MultiThreaderType.  0 uses ITK's global default, 1 the thread pool and
+   * 2 TBB.
+   */
+  void setMultiThreaderType(int value);
+  /**
+   * @brief Getter property for MultiThreaderType
+   * @return Value of MultiThreaderType
+   */
+  int getMultiThreaderType() const;
+  Q_PROPERTY(int MultiThreaderType READ getMultiThreaderType WRITE setMultiThreaderType)
+
+  /**
+   * @brief Setter property for UseResultCache.  When true, the output is stored in the ITKResultCache and
+   * reused when the filter is executed again on the same input values with the same parameters.
+   */
+  void setUseResultCache(bool value);
+  /**
+   * @brief Getter property for UseResultCache
+   * @return Value of UseResultCache
+   */
+  bool getUseResultCache() const;
+  Q_PROPERTY(bool UseResultCache READ getUseResultCache WRITE setUseResultCache)
+
+  /**
+   * @brief Setter property for ResultCacheSize, in MB.  Least recently used results are evicted from the
+   * cache once it exceeds this size.
+   */
+  void setResultCacheSize(int value);
+  /**
+   * @brief Getter property for ResultCacheSize
+   * @return Value of ResultCacheSize
+   */
+  int getResultCacheSize() const;
+  Q_PROPERTY(int ResultCacheSize READ getResultCacheSize WRITE setResultCacheSize)
+
   /**
    * @brief CastVec3ToITK Input type should be FloatVec3Type or IntVec3Type, Output
      type should be some kind of ITK "array" (itk::Size, itk::Index,...)
@@ -118,6 +240,45 @@ public:
 protected:
   ITKImageBase();
 
+  /**
+   * @brief Appends the parameters that control how the ITK pipeline is executed.
+   * @param parameters
+   */
+  void addExecutionFilterParameters(FilterParameterVectorType& parameters);
+
+  /**
+   * @brief Returns whether the output may be streamed.  Streaming is opt-in: only pointwise filters and filters
+   * that read a fixed neighborhood of the input override this to return true.  Filters that compute statistics
+   * over their input, such as the intensity rescaling and histogram equalization filters, or that iterate over
+   * the whole image, such as the diffusion filters, would give every chunk its own result and keep the default.
+   * The streaming parameters are not offered when this returns false.
+   */
+  virtual bool supportsStreamOutput() const;
+
+  /**
+   * @brief Reads the parameters added by addExecutionFilterParameters.
+   * @param reader
+   */
+  void readExecutionFilterParameters(AbstractFilterParametersReader* reader);
+
+  /**
+   * @brief Checks the parameters added by addExecutionFilterParameters.
+   */
+  void checkExecutionParameters();
+
+  /**
+   * @brief Applies the threading parameters to one ITK filter of the pipeline.
+   * @param processObject
+   */
+  void applyThreading(itk::ProcessObject* processObject) const;
+
+  /**
+   * @brief Returns the path of the array written by the filter.  The result cache is only used by filters
+   * that return a valid path.
+   * @return
+   */
+  virtual DataArrayPath getResultCacheOutputPath() const;
+
   /**
    * @brief imageCheck checks if data array contains an image.
    */
@@ -148,7 +309,186 @@ protected:
   }
 
   /**
-   * @brief Applies the filter
+   * @brief Returns an itk::Image that shares the buffer of the selected DataArray.
+   */
+  template <typename PixelType, unsigned int Dimension>
+  typename itk::Image<PixelType, Dimension>::Pointer createInputView(const DataContainer::Pointer& dc, const DataArrayPath& selectedArray)
+  {
+    using ValueType = typename itk::NumericTraits<PixelType>::ValueType;
+    ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
+    AttributeMatrix::Pointer am = dc->getAttributeMatrix(selectedArray.getAttributeMatrixName());
+    typename DataArray<ValueType>::Pointer inputArray = am->getAttributeArrayAs<DataArray<ValueType>>(selectedArray.getDataArrayName());
+    return ITKDataArrayImageView::wrapDataArray<PixelType, Dimension>(*imageGeom, *inputArray);
+  }
+
+  /**
+   * @brief Returns the image to filter: the previous filter's output when the filter is chained in an
+   * ITKPipelineSegment, otherwise a view of the selected DataArray.  Returns nullptr if the previous
+   * filter's output does not have the expected pixel type.
+   */
+  template <typename PixelType, unsigned int Dimension>
+  typename itk::Image<PixelType, Dimension>::Pointer getInputImage(const DataContainer::Pointer& dc, const DataArrayPath& selectedArray)
+  {
+    if(nullptr != m_PipelineLink && nullptr != m_PipelineLink->getImage())
+    {
+      return dynamic_cast<itk::Image<PixelType, Dimension>*>(m_PipelineLink->getImage());
+    }
+    return createInputView<PixelType, Dimension>(dc, selectedArray);
+  }
+
+  /**
+   * @brief Passes the output of the last ITK filter to the next filter of an ITKPipelineSegment.  Returns
+   * true if the output must not be written to its DataArray, in which case the ITK filters are left
+   * un-updated so that the next filter pulls the output through a single ITK pipeline.
+   */
+  template <typename OutputImageType>
+  bool linkOutput(OutputImageType* output, const std::vector<itk::ProcessObject*>& sources)
+  {
+    if(nullptr == m_PipelineLink)
+    {
+      return false;
+    }
+    m_PipelineLink->setImage(output, sources);
+    if(m_PipelineLink->getWriteOutput())
+    {
+      return false;
+    }
+    // Free the intermediate image as soon as the next ITK filter has consumed it
+    output->ReleaseDataFlagOn();
+    return true;
+  }
+
+  /**
+   * @brief Turns off in-place execution for filters derived from itk::InPlaceImageFilter so that the
+   * input view's DataArray is never overwritten.
+   */
+  template <typename FilterType>
+  static auto disableInPlace(FilterType* filter, int) -> decltype(filter->InPlaceOff(), void())
+  {
+    filter->InPlaceOff();
+  }
+
+  template <typename FilterType>
+  static void disableInPlace(FilterType*, long)
+  {
+  }
+
+  /**
+   * @brief Returns true if the pipeline that produces output only needs part of its input to compute part
+   * of its output.  This is the case for pointwise and neighborhood filters.  The output is probed with a
+   * request for a single slice.
+   */
+  template <unsigned int Dimension>
+  static bool supportsStreaming(itk::ImageBase<Dimension>* output, itk::ImageBase<Dimension>* input)
+  {
+    using RegionType = typename itk::ImageBase<Dimension>::RegionType;
+    const RegionType largest = output->GetLargestPossibleRegion();
+    int slowest = static_cast<int>(Dimension) - 1;
+    while(slowest >= 0 && largest.GetSize(slowest) < 2)
+    {
+      slowest--;
+    }
+    if(slowest < 0)
+    {
+      return false;
+    }
+
+    RegionType probe = largest;
+    probe.SetSize(slowest, 1);
+    output->SetRequestedRegion(probe);
+    output->PropagateRequestedRegion();
+    const bool streamable = output->GetRequestedRegion() != largest && input->GetRequestedRegion() != input->GetLargestPossibleRegion();
+    output->SetRequestedRegionToLargestPossibleRegion();
+    return streamable;
+  }
+
+  /**
+   * @brief Returns the number of chunks to stream region in, either set by the user or computed from the
+   * memory budget and an estimate of the bytes ITK allocates per output pixel.
+   */
+  template <unsigned int Dimension>
+  unsigned int getNumberOfStreamDivisions(const itk::ImageRegion<Dimension>& region, size_t bytesPerPixel) const
+  {
+    if(m_StreamingDivisions > 0)
+    {
+      return static_cast<unsigned int>(m_StreamingDivisions);
+    }
+    const double budget = static_cast<double>(m_StreamingMemoryBudget) * 1024.0 * 1024.0;
+    const double bytes = static_cast<double>(region.GetNumberOfPixels()) * static_cast<double>(bytesPerPixel);
+    return static_cast<unsigned int>(std::max(1.0, std::ceil(bytes / budget)));
+  }
+
+  /**
+   * @brief Updates the last filter of the pipeline so that it writes into the output DataArray created
+   * by dataCheck.  The DataArray is grafted onto the filter's output, so the filter does not allocate an
+   * output buffer of its own.  Returns false if the output does not have the size of the DataArray.  The
+   * filter has been updated in that case and the caller must move its output into the DataContainer.
+   * When StreamOutput is set, an itk::StreamingImageFilter writes the output into the DataArray chunk by
+   * chunk.  bytesPerPixel estimates the memory the pipeline allocates per output pixel of a chunk.
+   */
+  template <typename OutputPixelType, unsigned int Dimension, typename OutputFilterType>
+  bool updateIntoOutputArray(OutputFilterType* outputFilter, itk::ImageBase<Dimension>* inputImage, size_t bytesPerPixel, const DataContainer::Pointer& dc, const DataArrayPath& selectedArray,
+                             const std::string& outputArrayName)
+  {
+    using OutputImageType = itk::Image<OutputPixelType, Dimension>;
+    using OutputValueType = typename itk::NumericTraits<OutputPixelType>::ValueType;
+
+    AttributeMatrix::Pointer am = dc->getAttributeMatrix(selectedArray.getAttributeMatrixName());
+    typename DataArray<OutputValueType>::Pointer outputArray = am->getAttributeArrayAs<DataArray<OutputValueType>>(QString::fromStdString(outputArrayName));
+
+    outputFilter->UpdateOutputInformation();
+    OutputImageType* output = outputFilter->GetOutput();
+    const typename OutputImageType::RegionType region = output->GetLargestPossibleRegion();
+    if(nullptr == outputArray || !ITKDataArrayImageView::canWrapDataArray<OutputPixelType, Dimension>(*outputArray, region))
+    {
+      outputFilter->Update();
+      return false;
+    }
+
+    itk::ImageSource<OutputImageType>* source = outputFilter;
+    using StreamerType = itk::StreamingImageFilter<OutputImageType, OutputImageType>;
+    typename StreamerType::Pointer streamer;
+    if(m_StreamOutput)
+    {
+      if(supportsStreamOutput() && supportsStreaming<Dimension>(output, inputImage))
+      {
+        streamer = StreamerType::New();
+        streamer->SetInput(output);
+        streamer->SetNumberOfStreamDivisions(getNumberOfStreamDivisions<Dimension>(region, bytesPerPixel));
+        streamer->UpdateOutputInformation();
+        source = streamer.GetPointer();
+        output = streamer->GetOutput();
+      }
+      else
+      {
+        setWarningCondition(-55559, "This filter needs the whole input image to compute its output. The output is not streamed.");
+      }
+    }
+
+    typename OutputImageType::Pointer outputView = ITKDataArrayImageView::wrapDataArray<OutputPixelType, Dimension>(*outputArray, region);
+    outputView->CopyInformation(output);
+    source->GraftOutput(outputView);
+    // Keep the grafted buffer instead of releasing the output data before the filter runs
+    source->ReleaseDataBeforeUpdateFlagOff();
+    source->Update();
+
+    // Filters built from an internal pipeline graft that pipeline's output, replacing the buffer
+    const OutputPixelType* result = output->GetBufferPointer();
+    OutputPixelType* destination = outputView->GetBufferPointer();
+    if(result != destination)
+    {
+      if(output->GetBufferedRegion() != region)
+      {
+        return false;
+      }
+      std::copy(result, result + region.GetNumberOfPixels(), destination);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Applies the filter.  The input and output DataArrays are wrapped as itk::Images so the
+   * filter reads the selected array and writes the new array without intermediate copies.
    */
   template <typename InputPixelType, typename OutputPixelType, unsigned int Dimension, typename FilterType>
   void filter(FilterType* filter, const std::string& outputArrayName, const DataArrayPath& selectedArray)
@@ -158,21 +498,29 @@ protected:
       DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(selectedArray.getDataContainerName());
 
       using OutputImageType = itk::Image<OutputPixelType, Dimension>;
-      using toITKType = itk::InPlaceDream3DDataToImageFilter<InputPixelType, Dimension>;
-      // Create a Bridge to wrap an existing DREAM.3D array with an ItkImage container
-      typename toITKType::Pointer toITK = toITKType::New();
-      toITK->SetInput(dc);
-      toITK->SetInPlace(true);
-      toITK->SetAttributeMatrixArrayName(selectedArray.getAttributeMatrixName().toStdString());
-      toITK->SetDataArrayName(selectedArray.getDataArrayName().toStdString());
+      typename itk::Image<InputPixelType, Dimension>::Pointer inputImage = getInputImage<InputPixelType, Dimension>(dc, selectedArray);
+      if(nullptr == inputImage)
+      {
+        setErrorCondition(-55557, "The output of the previous filter in the pipeline segment does not match the input type of this filter");
+        return;
+      }
 
       itk::Dream3DFilterInterruption::Pointer interruption = itk::Dream3DFilterInterruption::New();
       interruption->SetFilter(this);
 
       // Set up filter
-      filter->SetInput(toITK->GetOutput());
+      filter->SetInput(inputImage);
       filter->AddObserver(itk::ProgressEvent(), interruption);
-      filter->Update();
+      disableInPlace(filter, 0);
+      applyThreading(filter);
+      if(linkOutput(filter->GetOutput(), {filter}))
+      {
+        return;
+      }
+      if(updateIntoOutputArray<OutputPixelType, Dimension>(filter, inputImage.GetPointer(), sizeof(OutputPixelType), dc, selectedArray, outputArrayName))
+      {
+        return;
+      }
 
       typename OutputImageType::Pointer image = OutputImageType::New();
       image = filter->GetOutput();
@@ -198,7 +546,8 @@ protected:
   }
 
   /**
-   * @brief Applies the filter, casting the input to float
+   * @brief Applies the filter, casting the input to float.  Only the float images between the casts
+   * are allocated; the input and output DataArrays are used in place.
    */
 
   template <typename InputPixelType, typename OutputPixelType, unsigned int Dimension, typename FilterType, typename FloatImageType>
@@ -208,21 +557,21 @@ protected:
     {
       DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(selectedArray.getDataContainerName());
 
-      using toITKType = itk::InPlaceDream3DDataToImageFilter<InputPixelType, Dimension>;
-      // Create a Bridge to wrap an existing DREAM.3D array with an ItkImage container
-      typename toITKType::Pointer toITK = toITKType::New();
-      toITK->SetInput(dc);
-      toITK->SetInPlace(true);
-      toITK->SetAttributeMatrixArrayName(selectedArray.getAttributeMatrixName().toStdString());
-      toITK->SetDataArrayName(selectedArray.getDataArrayName().toStdString());
+      using InputImageType = itk::Image<InputPixelType, Dimension>;
+      typename InputImageType::Pointer inputImage = getInputImage<InputPixelType, Dimension>(dc, selectedArray);
+      if(nullptr == inputImage)
+      {
+        setErrorCondition(-55558, "The output of the previous filter in the pipeline segment does not match the input type of this filter");
+        return;
+      }
 
       itk::Dream3DFilterInterruption::Pointer interruption = itk::Dream3DFilterInterruption::New();
       interruption->SetFilter(this);
 
-      using InputImageType = typename toITKType::ImageType;
       using CasterToType = itk::CastImageFilter<InputImageType, FloatImageType>;
       typename CasterToType::Pointer casterTo = CasterToType::New();
-      casterTo->SetInput(toITK->GetOutput());
+      casterTo->SetInput(inputImage);
+      casterTo->InPlaceOff();
 
       // Set up filter
       filter->SetInput(casterTo->GetOutput());
@@ -232,7 +581,19 @@ protected:
       using CasterFromType = itk::CastImageFilter<FloatImageType, OutputImageType>;
       typename CasterFromType::Pointer casterFrom = CasterFromType::New();
       casterFrom->SetInput(filter->GetOutput());
-      casterFrom->Update();
+      casterFrom->InPlaceOff();
+      applyThreading(casterTo);
+      applyThreading(filter);
+      applyThreading(casterFrom);
+      if(linkOutput(casterFrom->GetOutput(), {casterTo.GetPointer(), filter, casterFrom.GetPointer()}))
+      {
+        return;
+      }
+      const size_t bytesPerPixel = sizeof(OutputPixelType) + 2 * sizeof(typename FloatImageType::PixelType);
+      if(updateIntoOutputArray<OutputPixelType, Dimension>(casterFrom.GetPointer(), inputImage.GetPointer(), bytesPerPixel, dc, selectedArray, outputArrayName))
+      {
+        return;
+      }
 
       typename OutputImageType::Pointer image = OutputImageType::New();
       image = casterFrom->GetOutput();
@@ -334,4 +695,29 @@ public:
   ITKImageBase& operator=(ITKImageBase&&) = delete;      // Move Assignment Not Implemented
 
 private:
+  /**
+   * @brief Hashes the values and geometry of every selected input array together with the class name and
+   * parameters of the filter.  Returns false if the filter was canceled while hashing.
+   */
+  bool computeResultCacheKey(ITKResultCache::Key& key);
+
+  /**
+   * @brief Replaces the output array with a copy of the cached result for key.  Returns false on a miss.
+   */
+  bool restoreCachedResult(const ITKResultCache::Key& key);
+
+  /**
+   * @brief Stores a copy of the output array in the result cache.
+   */
+  void cacheResult(const ITKResultCache::Key& key);
+
+  ITKPipelineLink::Pointer m_PipelineLink = nullptr;
+  bool m_StreamOutput = false;
+  int m_StreamingDivisions = 0;
+  int m_StreamingMemoryBudget = 1024;
+  int m_MaximumNumberOfThreads = 0;
+  int m_NumberOfWorkUnits = 0;
+  int m_MultiThreaderType = 0;
+  bool m_UseResultCache = false;
+  int m_ResultCacheSize = 2048;
 };
@@ -1,5 +1,8 @@
 #include "ITKImageProcessingBase.h"
 
+#include <itkCastImageFilter.h>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 
 #include "ITKImageProcessing/ITKImageProcessingConstants.h"
@@ -74,6 +77,145 @@ void ITKImageProcessingBase::readFilterParameters(AbstractFilterParametersReader
   reader->closeFilterGroup();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayPath ITKImageProcessingBase::getResultCacheOutputPath() const
+{
+  return DataArrayPath(m_SelectedCellArrayPath.getDataContainerName(), m_SelectedCellArrayPath.getAttributeMatrixName(), m_NewCellArrayName);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKImageProcessingBase::dataCheckCastThroughFloat()
+{
+  IDataArray::Pointer inputArray = getDataContainerArray()->getPrereqIDataArrayFromPath(this, getSelectedCellArrayPath());
+  DataArrayPath tempPath;
+  tempPath.update(getSelectedCellArrayPath().getDataContainerName(), getSelectedCellArrayPath().getAttributeMatrixName(), getNewCellArrayName());
+  ITKPixelTypeList::dispatchPixelType(ITKPixelTypeList::AllScalarPixelTypes(), inputArray.get(), [&](auto pixelTag) {
+    using PixelType = typename decltype(pixelTag)::Type;
+    m_NewCellArrayPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<PixelType>>(this, tempPath, 0, std::vector<size_t>(1, 1));
+  });
+  if(nullptr != m_NewCellArrayPtr.lock())
+  {
+    m_NewCellArray = m_NewCellArrayPtr.lock()->getVoidPointer(0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename RealType, unsigned int Dimension>
+void ITKImageProcessingBase::filterCastThroughReal(const std::function<void()>& filterReal)
+{
+  const DataArrayPath selectedArray = getSelectedCellArrayPath();
+  const std::string outputArrayName = getNewCellArrayName().toStdString();
+  DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(selectedArray.getDataContainerName());
+  IDataArray::Pointer inputArray = getDataContainerArray()->getPrereqIDataArrayFromPath(this, selectedArray);
+
+  // The real instance of the filter reads the cast input from the pipeline link and leaves its output there.  A
+  // filter that is not chained in an ITKPipelineSegment gets a link of its own for the time of the call.
+  ITKPipelineLink::Pointer segmentLink = getPipelineLink();
+  ITKPipelineLink::Pointer link = (nullptr != segmentLink) ? segmentLink : std::make_shared<ITKPipelineLink>();
+  const bool writeOutput = link->getWriteOutput();
+
+  ITKPixelTypeList::dispatchPixelType(ITKPixelTypeList::AllScalarPixelTypes(), inputArray.get(), [&](auto pixelTag) {
+    using PixelType = typename decltype(pixelTag)::Type;
+    using ImageType = itk::Image<PixelType, Dimension>;
+    using RealImageType = itk::Image<RealType, Dimension>;
+    try
+    {
+      typename ImageType::Pointer inputImage = getInputImage<PixelType, Dimension>(dc, selectedArray);
+      if(nullptr == inputImage)
+      {
+        setErrorCondition(-55557, "The output of the previous filter in the pipeline segment does not match the input type of this filter");
+        return;
+      }
+
+      using CasterToType = itk::CastImageFilter<ImageType, RealImageType>;
+      typename CasterToType::Pointer casterTo = CasterToType::New();
+      casterTo->SetInput(inputImage);
+      casterTo->InPlaceOff();
+      applyThreading(casterTo);
+
+      link->setImage(casterTo->GetOutput(), {casterTo.GetPointer()});
+      link->setWriteOutput(false);
+      setPipelineLink(link);
+      filterReal();
+      setPipelineLink(segmentLink);
+      link->setWriteOutput(writeOutput);
+
+      if(getErrorCode() < 0)
+      {
+        return;
+      }
+      auto* realOutput = dynamic_cast<RealImageType*>(link->getImage());
+      if(nullptr == realOutput)
+      {
+        setErrorCondition(-55568, "The output of the filter does not have the type of its input and cannot be cast back to the input's type");
+        return;
+      }
+
+      using CasterFromType = itk::CastImageFilter<RealImageType, ImageType>;
+      typename CasterFromType::Pointer casterFrom = CasterFromType::New();
+      casterFrom->SetInput(realOutput);
+      casterFrom->InPlaceOff();
+      applyThreading(casterFrom);
+      if(linkOutput(casterFrom->GetOutput(), {casterFrom.GetPointer()}))
+      {
+        return;
+      }
+      const size_t bytesPerPixel = sizeof(PixelType) + 2 * sizeof(RealType);
+      if(updateIntoOutputArray<PixelType, Dimension>(casterFrom.GetPointer(), inputImage.GetPointer(), bytesPerPixel, dc, selectedArray, outputArrayName))
+      {
+        return;
+      }
+
+      typename ImageType::Pointer image = casterFrom->GetOutput();
+      image->DisconnectPipeline();
+
+      using toDream3DType = itk::InPlaceImageToDream3DDataFilter<PixelType, Dimension>;
+      typename toDream3DType::Pointer toDream3DFilter = toDream3DType::New();
+      toDream3DFilter->SetInput(image);
+      toDream3DFilter->SetInPlace(true);
+      toDream3DFilter->SetAttributeMatrixArrayName(selectedArray.getAttributeMatrixName().toStdString());
+      toDream3DFilter->SetDataArrayName(outputArrayName);
+      toDream3DFilter->SetDataContainer(dc);
+      toDream3DFilter->Update();
+    } catch(itk::ExceptionObject& err)
+    {
+      if(!getCancel())
+      {
+        QString errorMessage = "ITK exception was thrown while filtering input image: %1";
+        setErrorCondition(-55555, errorMessage.arg(err.GetDescription()));
+      }
+    }
+  });
+
+  setPipelineLink(segmentLink);
+  link->setWriteOutput(writeOutput);
+  if(nullptr == segmentLink)
+  {
+    link->clear();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKImageProcessingBase::filterCastThroughFloat(bool isDouble, unsigned int dimension, const std::function<void()>& filterReal)
+{
+  if(dimension == 2)
+  {
+    isDouble ? filterCastThroughReal<double, 2>(filterReal) : filterCastThroughReal<float, 2>(filterReal);
+  }
+  else
+  {
+    isDouble ? filterCastThroughReal<double, 3>(filterReal) : filterCastThroughReal<float, 3>(filterReal);
+  }
+}
+
 // -----------------------------------------------------------------------------
 ITKImageProcessingBase::Pointer ITKImageProcessingBase::NullPointer()
 {
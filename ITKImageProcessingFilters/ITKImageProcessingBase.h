@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <functional>
+#include <limits>
 #include <memory>
+#include <type_traits>
 
 #include "SIMPLib/SIMPLib.h"
 
@@ -14,6 +17,21 @@ using IDataArrayWkPtrType = std::weak_ptr<IDataArray>;
 #include "ITKImageBase.h"
 
 #include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKPixelTypeList.h"
+
+/**
+ * @brief ITKPixelTypeSwitchMacro calls call<PixelType, PixelType, Dimension>() for the scalar type and
+ * dimension of the array at path.  It replaces Dream3DArraySwitchMacro for filters that declare
+ * SupportedPixelTypes (an ITKPixelTypeList::TypeList) and SupportedDimensions (an
+ * ITKPixelTypeList::DimensionList), so that the filter is only instantiated for those types.
+ */
+#define ITKPixelTypeSwitchMacro(call, path, errorCode)                                                                                                                                                \
+  this->pixelTypeSwitch<SupportedPixelTypes, SupportedDimensions>(                                                                                                                                   \
+      [this](auto pixelTag, auto dimensionTag) {                                                                                                                                                     \
+        using SwitchPixelType = typename decltype(pixelTag)::Type;                                                                                                                                   \
+        call<SwitchPixelType, SwitchPixelType, decltype(dimensionTag)::value>();                                                                                                                     \
+      },                                                                                                                                                                                             \
+      path, errorCode)
 
 /**
  * @brief The ITKImageProcessingBase class. See [Filter documentation](@ref ITKImageProcessingBase) for details.
@@ -112,11 +130,31 @@ public:
 protected:
   ITKImageProcessingBase();
 
+  /**
+   * @brief getResultCacheOutputPath Reimplemented from @see ITKImageBase class
+   */
+  DataArrayPath getResultCacheOutputPath() const override;
+
   /**
    * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
    */
   template <typename InputPixelType, typename OutputPixelType, unsigned int Dimension>
   void dataCheckImpl()
+  {
+    checkExecutionParameters();
+    if(m_CastThroughFloat)
+    {
+      dataCheckCastThroughFloat();
+      return;
+    }
+    createOutputArray<InputPixelType, OutputPixelType, Dimension>();
+  }
+
+  /**
+   * @brief Checks the input array and creates the output array
+   */
+  template <typename InputPixelType, typename OutputPixelType, unsigned int Dimension>
+  void createOutputArray()
   {
     // typedef typename itk::NumericTraits<InputPixelType>::ValueType InputValueType;
     typedef typename itk::NumericTraits<OutputPixelType>::ValueType OutputValueType;
@@ -137,6 +175,96 @@ protected:
     } /* Now assign the raw pointer to data from the DataArray<T> object */
   }
 
+  /**
+   * @brief Creates an output array of the input's type for a filter that is run on real images by
+   * pixelTypeSwitch.  The input array was checked by pixelTypeSwitch.
+   */
+  void dataCheckCastThroughFloat();
+
+  /**
+   * @brief Calls call(PixelTag, DimensionTag) for the scalar type and dimension of the array at path.
+   * Scalar types that are not in PixelTypes run the float instance of the filter, casting the input to
+   * float and the output back to the input's type.  64 bit integers run the double instance when there is
+   * one so that values up to 2^53 are preserved.  A warning is set when the cast to float loses precision.
+   * Use ITKPixelTypeSwitchMacro rather than calling this directly.
+   */
+  template <typename PixelTypes, typename Dimensions, typename Functor>
+  void pixelTypeSwitch(Functor&& call, const DataArrayPath& path, int errorCode)
+  {
+    IDataArray::Pointer inputArray = getDataContainerArray()->getPrereqIDataArrayFromPath(this, path);
+    if(getErrorCode() < 0 || nullptr == inputArray)
+    {
+      return;
+    }
+    ImageGeom::Pointer imageGeom = getDataContainerArray()->getDataContainer(path.getDataContainerName())->getPrereqGeometry<ImageGeom>(this);
+    if(getErrorCode() < 0 || nullptr == imageGeom)
+    {
+      return;
+    }
+    if(inputArray->getNumberOfComponents() != 1)
+    {
+      setErrorCondition(errorCode, QString("%1 has %2 components. This filter only supports scalar arrays.").arg(path.serialize()).arg(inputArray->getNumberOfComponents()));
+      return;
+    }
+
+    const unsigned int dimension = (imageGeom->getDimensions()[2] == 1) ? 2 : 3;
+    const bool dimensionSupported = ITKPixelTypeList::dispatchDimension(Dimensions(), dimension, [&](auto dimensionTag) {
+      if(ITKPixelTypeList::dispatchPixelType(PixelTypes(), inputArray.get(), [&](auto pixelTag) { call(pixelTag, dimensionTag); }))
+      {
+        return;
+      }
+      if(!ITKPixelTypeList::dispatchPixelType(ITKPixelTypeList::AllScalarPixelTypes(), inputArray.get(), [](auto) {}))
+      {
+        setErrorCondition(errorCode, QString("%1 has an unsupported type: %2").arg(path.serialize()).arg(inputArray->getTypeAsString()));
+        return;
+      }
+      m_CastThroughFloat = true;
+      castThroughReal<PixelTypes>(call, dimensionTag, inputArray.get(), path, std::integral_constant<bool, ITKPixelTypeList::Contains<double, PixelTypes>::value>());
+      m_CastThroughFloat = false;
+    });
+    if(!dimensionSupported)
+    {
+      setErrorCondition(errorCode, QString("This filter does not support %1D images").arg(dimension));
+    }
+  }
+
+  /**
+   * @brief Runs the double instance of the filter for 64 bit integers and the float instance for every
+   * other type that is not in PixelTypes.
+   */
+  template <typename PixelTypes, typename Functor, typename DimensionTag>
+  void castThroughReal(Functor& call, DimensionTag dimensionTag, const IDataArray* inputArray, const DataArrayPath& path, std::true_type /* hasDoubleInstance */)
+  {
+    if(ITKPixelTypeList::dispatchPixelType(ITKPixelTypeList::TypeList<int64_t, uint64_t>(), inputArray, [](auto) {}))
+    {
+      call(ITKPixelTypeList::PixelTag<double>(), dimensionTag);
+      return;
+    }
+    castThroughReal<PixelTypes>(call, dimensionTag, inputArray, path, std::false_type());
+  }
+
+  template <typename PixelTypes, typename Functor, typename DimensionTag>
+  void castThroughReal(Functor& call, DimensionTag dimensionTag, const IDataArray* inputArray, const DataArrayPath& path, std::false_type /* hasDoubleInstance */)
+  {
+    ITKPixelTypeList::dispatchPixelType(ITKPixelTypeList::AllScalarPixelTypes(), inputArray, [&](auto pixelTag) {
+      using PixelType = typename decltype(pixelTag)::Type;
+      if(std::numeric_limits<PixelType>::digits > std::numeric_limits<float>::digits)
+      {
+        QString message = "%1 is filtered as float. Values with a magnitude above 2^%2 lose precision.";
+        setWarningCondition(-55567, message.arg(path.serialize()).arg(std::numeric_limits<float>::digits));
+      }
+    });
+    call(ITKPixelTypeList::PixelTag<float>(), dimensionTag);
+  }
+
+  /**
+   * @brief Runs the float or double instance of a filter, filterReal, on an input whose type is not in the
+   * filter's PixelTypes.  The input is cast to the real type and the output back to the input's type by ITK
+   * filters that are compiled once in ITKImageProcessingBase.cpp and joined to the filter through the pipeline
+   * link, so that every filter only compiles its real instance.
+   */
+  void filterCastThroughFloat(bool isDouble, unsigned int dimension, const std::function<void()>& filterReal);
+
   /**
    * @brief Applies the filter
    */
@@ -147,6 +275,12 @@ protected:
 
     outputArrayName = getNewCellArrayName().toStdString();
 
+    if(m_CastThroughFloat)
+    {
+      filterCastThroughFloat(std::is_same<InputPixelType, double>::value, Dimension,
+                             [&]() { ITKImageBase::filter<InputPixelType, OutputPixelType, Dimension, FilterType>(filter, outputArrayName, getSelectedCellArrayPath()); });
+      return;
+    }
     ITKImageBase::filter<InputPixelType, OutputPixelType, Dimension, FilterType>(filter, outputArrayName, getSelectedCellArrayPath());
   }
 
@@ -160,6 +294,13 @@ protected:
 
     outputArrayName = getNewCellArrayName().toStdString();
 
+    if(m_CastThroughFloat)
+    {
+      filterCastThroughFloat(std::is_same<InputPixelType, double>::value, Dimension, [&]() {
+        ITKImageBase::filterCastToFloat<InputPixelType, OutputPixelType, Dimension, FilterType, FloatImageType>(filter, outputArrayName, getSelectedCellArrayPath());
+      });
+      return;
+    }
     ITKImageBase::filterCastToFloat<InputPixelType, OutputPixelType, Dimension, FilterType, FloatImageType>(filter, outputArrayName, getSelectedCellArrayPath());
   }
 
@@ -169,8 +310,16 @@ protected:
   void initialize();
 
 private:
+  /**
+   * @brief Runs filterReal between a cast of the input to RealType and a cast of its output back to the
+   * input's type.  See filterCastThroughFloat.
+   */
+  template <typename RealType, unsigned int Dimension>
+  void filterCastThroughReal(const std::function<void()>& filterReal);
+
   IDataArrayWkPtrType m_NewCellArrayPtr;
   void* m_NewCellArray = nullptr;
+  bool m_CastThroughFloat = false;
 
   DataArrayPath m_SelectedCellArrayPath = {};
   QString m_NewCellArrayName = {};
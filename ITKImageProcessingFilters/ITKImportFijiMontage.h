@@ -45,6 +45,7 @@
 
 // our PIMPL private class
 class ITKImportFijiMontagePrivate;
+class ITKPhaseTimer;
 
 /**
  * @brief The ITKImportFijiMontage class. See [Filter documentation](@ref ITKImportFijiMontage) for details.
@@ -402,8 +403,9 @@ protected:
 
   /**
    * @brief readImages
+   * @param timer Records the time spent reading, converting and attaching the tiles
    */
-  void readImages();
+  void readImages(ITKPhaseTimer& timer);
 
   /**
    * @brief generateDataStructure
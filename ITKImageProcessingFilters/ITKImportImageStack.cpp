@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ITKImportImageStack.h"
 
+#include <algorithm>
+#include <mutex>
+
 #include <QtCore/QFileInfo>
 
 #include "SIMPLib/Common/Constants.h"
@@ -49,12 +52,14 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/ITK/itkInPlaceImageToDream3DDataFilter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "ITKImageProcessing/ITKImageProcessingConstants.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/ITKImageReader.h"
 #include "ITKImageProcessing/ITKImageProcessingVersion.h"
 #include "ITKImageProcessingPlugin.h"
 
+#include <itkConfigure.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOBase.h>
 
@@ -269,11 +274,124 @@ void ITKImportImageStack::dataCheck()
   cellAttrMat->addOrReplaceAttributeArray(resizedImageDataPtr);
 }
 
+namespace
+{
+/**
+ * @brief Returns the lock held while an ImageIO is created.  Creating an ImageIO walks the global list of ImageIO factories.
+ */
+std::mutex& imageIOFactoryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/**
+ * @brief Reads the image at filePath with an ITKImageReader, which converts the pixels like the reader that read the
+ * first image of the stack, and copies it into buffer.  The reader creates its own ImageIO, so these reads are not run
+ * in parallel.
+ */
+template <typename TPixel>
+bool readSliceWithReader(const QString& filePath, const SizeVec3Type& dims, size_t componentCount, TPixel* buffer, QString& errorMessage)
+{
+  std::lock_guard<std::mutex> lock(imageIOFactoryMutex());
+
+  const DataArrayPath sliceArrayPath("Slice", "CellData", "ImageData");
+  ITKImageReader::Pointer imageReader = ITKImageReader::New();
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  imageReader->setDataContainerArray(dca);
+  imageReader->setDataContainerName(DataArrayPath(sliceArrayPath.getDataContainerName(), "", ""));
+  imageReader->setCellAttributeMatrixName(sliceArrayPath.getAttributeMatrixName());
+  imageReader->setImageDataArrayName(sliceArrayPath.getDataArrayName());
+  imageReader->setFileName(filePath);
+  imageReader->execute();
+  if(imageReader->getErrorCode() < 0)
+  {
+    errorMessage = QString("Error reading image %1").arg(filePath);
+    return false;
+  }
+
+  typename DataArray<TPixel>::Pointer sliceData = dca->getAttributeMatrix(sliceArrayPath)->getAttributeArrayAs<DataArray<TPixel>>(sliceArrayPath.getDataArrayName());
+  if(nullptr == sliceData || sliceData->getNumberOfTuples() != dims[0] * dims[1] || sliceData->getNumberOfComponents() != componentCount)
+  {
+    errorMessage = QString("Image %1 does not have the same dimensions and pixel type as the first image of the stack").arg(filePath);
+    return false;
+  }
+  std::copy_n(sliceData->getPointer(0), sliceData->getSize(), buffer);
+  return true;
+}
+
+/**
+ * @brief Reads the image at filePath straight into buffer, which points at the slice of the output array that receives
+ * it.  Images whose components are not stored as TPixel, such as 64 bit integers on platforms where long is 32 bits,
+ * and palette images are read by readSliceWithReader instead.  Returns false and sets errorMessage if the image cannot
+ * be read or does not match the size and pixel type of the first image of the stack.  Safe to call from several threads
+ * at once.
+ */
+template <typename TPixel>
+bool readSlice(const QString& filePath, const SizeVec3Type& dims, itk::ImageIOBase::IOComponentType componentType, size_t componentCount, TPixel* buffer, QString& errorMessage)
+{
+  itk::ImageIOBase::Pointer imageIO = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(imageIOFactoryMutex());
+    imageIO = itk::ImageIOFactory::CreateImageIO(filePath.toLatin1(), itk::ImageIOFactory::ReadMode);
+  }
+  if(nullptr == imageIO)
+  {
+    errorMessage = QString("Error reading image %1. No ImageIO can read the file.").arg(filePath);
+    return false;
+  }
+
+  try
+  {
+    imageIO->SetFileName(filePath.toLatin1());
+    imageIO->ReadImageInformation();
+
+    // The ImageIO reads the file as it is stored, while ImageFileReader converts the components to the pixel type
+    // and expands palettes
+    bool readRaw = imageIO->GetComponentSize() == sizeof(TPixel);
+#if ITK_VERSION_MAJOR > 5 || (ITK_VERSION_MAJOR == 5 && ITK_VERSION_MINOR >= 1)
+    readRaw = readRaw && !imageIO->GetIsReadAsScalarPlusPalette();
+#endif
+    if(!readRaw)
+    {
+      imageIO = nullptr;
+      return readSliceWithReader<TPixel>(filePath, dims, componentCount, buffer, errorMessage);
+    }
+
+    const unsigned int dimensionCount = imageIO->GetNumberOfDimensions();
+    bool matches = dimensionCount >= 2 && imageIO->GetDimensions(0) == dims[0] && imageIO->GetDimensions(1) == dims[1];
+    for(unsigned int d = 2; d < dimensionCount; d++)
+    {
+      matches = matches && imageIO->GetDimensions(d) == 1;
+    }
+    if(!matches || imageIO->GetComponentType() != componentType || imageIO->GetNumberOfComponents() != componentCount)
+    {
+      errorMessage = QString("Image %1 does not have the same dimensions and pixel type as the first image of the stack").arg(filePath);
+      return false;
+    }
+
+    itk::ImageIORegion region(dimensionCount);
+    for(unsigned int d = 0; d < dimensionCount; d++)
+    {
+      region.SetIndex(d, 0);
+      region.SetSize(d, imageIO->GetDimensions(d));
+    }
+    imageIO->SetIORegion(region);
+    imageIO->Read(buffer);
+  } catch(itk::ExceptionObject& err)
+  {
+    errorMessage = QString("Error reading image %1: %2").arg(filePath).arg(err.GetDescription());
+    return false;
+  }
+  return true;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename TPixel>
-void readImageStack(ITKImportImageStack* filter, const QVector<QString>& fileList)
+void readImageStack(ITKImportImageStack* filter, const QVector<QString>& fileList, itk::ImageIOBase::IOComponentType componentType)
 {
 
   DataArrayPath dcName = filter->getDataContainerName();
@@ -298,58 +416,59 @@ void readImageStack(ITKImportImageStack* filter, const QVector<QString>& fileLis
 
   outputData->allocate(); // This most likely didn't happen during the preflight because how we are doing things is a bit unorthodox so make sure the data array is allocated.
 
-  // Variables for the progress Reporting
-  size_t slice = 0;
-  int32_t progress = 0;
-  int64_t zStartIndex = 0;
-  int64_t z = zStartIndex;
-  float total = static_cast<float>(fileList.size() - zStartIndex);
-  // Loop over all the files importing them one by one and copying the data into the data array
-  for(const auto& filePath : fileList)
-  {
-    // Do some progress message
-    progress = static_cast<int32_t>(z - zStartIndex);
-    progress = static_cast<int32_t>(100.0f * static_cast<float>(progress) / total);
-    QString msg = "Importing: " + filePath;
-    filter->notifyStatusMessage(msg.toLatin1().data());
-
-    // Create a subfilter to read each image, although for preflight we are going to read the first image in the
-    // list and hope the rest are correct.
-    ITKImageReader::Pointer imageReader = ITKImageReader::New();
-    DataContainerArray::Pointer dca = DataContainerArray::New();
-    imageReader->setDataContainerArray(dca);
-    imageReader->setDataContainerName(dcName);
-    imageReader->setCellAttributeMatrixName(attrMatName);
-    imageReader->setImageDataArrayName(arrayName);
-    imageReader->setFileName(filePath);
-    imageReader->execute();
-    if(imageReader->getErrorCode() < 0)
-    {
-      QString msg = QString("Error reading image %1").arg(filePath);
-      filter->setErrorCondition(imageReader->getErrorCode(), msg);
-      return;
-    }
+  // Each image is read by its own ImageIO straight into its slice of the output array, so the slices are read in
+  // parallel without a temporary array or a copy per slice.
+  const size_t componentCount = outputData->getNumberOfComponents();
+  const size_t valuesPerSlice = tuplesPerSlice * componentCount;
+  const size_t sliceCount = static_cast<size_t>(fileList.size());
 
-    // Compute the Tuple Index we are at:
-    size_t tupleIndex = (slice * dims[0] * dims[1]);
-    // get the current Slice data...
-    DataArrayPointerType tempData = dca->getDataContainer(dcName)->getAttributeMatrix(attrMatName)->getAttributeArrayAs<DataArrayType>(arrayName);
-    // Copy that into the output array...
-    if(!outputData->copyFromArray(tupleIndex, tempData, 0, tuplesPerSlice))
-    {
-      QString msg = QString("Error copying source image data into destination array.    Slice:%1    TupleIndex:%2    MaxTupleIndex:%3").arg(slice).arg(tupleIndex).arg(outputData->getSize());
-      filter->setErrorCondition(imageReader->getErrorCode(), msg);
-      return;
-    }
-
-    slice++;
+  std::mutex mutex;
+  int32_t errorCode = 0;
+  QString errorMessage;
 
-    // Check to see if the filter got canceled.
-    if(filter->getCancel())
+  // The slices are read in batches so that progress is reported from the calling thread between batches
+  constexpr size_t k_SlicesPerBatch = 64;
+  ParallelDataAlgorithm dataAlg;
+  for(size_t first = 0; first < sliceCount && errorCode == 0 && !filter->getCancel(); first += k_SlicesPerBatch)
+  {
+    const size_t last = std::min(first + k_SlicesPerBatch, sliceCount);
+    dataAlg.setRange(first, last);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t slice = range.min(); slice < range.max(); slice++)
+      {
+        // Check to see if the filter got canceled or another slice failed.
+        if(filter->getCancel())
+        {
+          return;
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if(errorCode < 0)
+          {
+            return;
+          }
+        }
+
+        QString sliceError;
+        if(!readSlice<TPixel>(fileList[static_cast<int>(slice)], dims, componentType, componentCount, outputData->getPointer(slice * valuesPerSlice), sliceError))
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          errorCode = -64505;
+          errorMessage = sliceError;
+          return;
+        }
+      }
+    });
+    if(errorCode == 0 && !filter->getCancel())
     {
-      return;
+      filter->notifyStatusMessage(QString("Imported %1 of %2 images").arg(last).arg(sliceCount));
     }
   }
+
+  if(errorCode < 0)
+  {
+    filter->setErrorCondition(errorCode, errorMessage);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -377,34 +496,34 @@ void ITKImportImageStack::execute()
   switch(component)
   {
   case itk::ImageIOBase::UCHAR:
-    readImageStack<uint8_t>(this, fileList);
+    readImageStack<uint8_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::CHAR:
-    readImageStack<int8_t>(this, fileList);
+    readImageStack<int8_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::USHORT:
-    readImageStack<uint16_t>(this, fileList);
+    readImageStack<uint16_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::SHORT:
-    readImageStack<int16_t>(this, fileList);
+    readImageStack<int16_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::UINT:
-    readImageStack<uint32_t>(this, fileList);
+    readImageStack<uint32_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::INT:
-    readImageStack<int32_t>(this, fileList);
+    readImageStack<int32_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::ULONG:
-    readImageStack<uint64_t>(this, fileList);
+    readImageStack<uint64_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::LONG:
-    readImageStack<int64_t>(this, fileList);
+    readImageStack<int64_t>(this, fileList, component);
     break;
   case itk::ImageIOBase::FLOAT:
-    readImageStack<float>(this, fileList);
+    readImageStack<float>(this, fileList, component);
     break;
   case itk::ImageIOBase::DOUBLE:
-    readImageStack<double>(this, fileList);
+    readImageStack<double>(this, fileList, component);
     break;
   default:
     QString errorMessage = QString("Unsupported pixel component: %1.").arg(imageIO->GetComponentTypeAsString(component).c_str());
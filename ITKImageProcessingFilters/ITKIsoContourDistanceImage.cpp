@@ -40,6 +40,8 @@ void ITKIsoContourDistanceImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("LevelSetValue", LevelSetValue, FilterParameter::Category::Parameter, ITKIsoContourDistanceImage));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("FarValue", FarValue, FilterParameter::Category::Parameter, ITKIsoContourDistanceImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -65,6 +67,7 @@ void ITKIsoContourDistanceImage::readFilterParameters(AbstractFilterParametersRe
   setLevelSetValue(reader->readValue("LevelSetValue", getLevelSetValue()));
   setFarValue(reader->readValue("FarValue", getFarValue()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
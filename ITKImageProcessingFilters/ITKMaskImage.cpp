@@ -40,6 +40,8 @@ void ITKMaskImage::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("OutsideValue", OutsideValue, FilterParameter::Category::Parameter, ITKMaskImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -66,9 +68,18 @@ void ITKMaskImage::readFilterParameters(AbstractFilterParametersReader* reader,
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setOutsideValue(reader->readValue("OutsideValue", getOutsideValue()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKMaskImage::supportsStreamOutput() const
+{
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -38,6 +38,8 @@ void ITKMeanProjectionImage::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("ProjectionDimension", ProjectionDimension, FilterParameter::Category::Parameter, ITKMeanProjectionImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -62,6 +64,7 @@ void ITKMeanProjectionImage::readFilterParameters(AbstractFilterParametersReader
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setProjectionDimension(reader->readValue("ProjectionDimension", getProjectionDimension()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -20,7 +20,11 @@
 #include <itkHessianToObjectnessMeasureImageFilter.h>
 #include <itkMultiScaleHessianBasedMeasureImageFilter.h>
 
-#include "SIMPLib/ITK/Dream3DTemplateAliasMacro.h"
+namespace
+{
+using SupportedPixelTypes = ITKPixelTypeList::StandardPixelTypes;
+using SupportedDimensions = ITKPixelTypeList::AllDimensions;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -61,6 +65,8 @@ void ITKMultiScaleHessianBasedObjectnessImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("SigmaMaximum", SigmaMaximum, FilterParameter::Category::Parameter, ITKMultiScaleHessianBasedObjectnessImage));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("NumberOfSigmaSteps", NumberOfSigmaSteps, FilterParameter::Category::Parameter, ITKMultiScaleHessianBasedObjectnessImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -93,6 +99,7 @@ void ITKMultiScaleHessianBasedObjectnessImage::readFilterParameters(AbstractFilt
   setSigmaMaximum(reader->readValue("SigmaMaximum", getSigmaMaximum()));
   setNumberOfSigmaSteps(reader->readValue("NumberOfSigmaSteps", getNumberOfSigmaSteps()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -117,7 +124,7 @@ void ITKMultiScaleHessianBasedObjectnessImage::dataCheck()
 {
   clearErrorCode();
   clearWarningCode();
-  Dream3DArraySwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->dataCheckImpl, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
@@ -159,7 +166,7 @@ void ITKMultiScaleHessianBasedObjectnessImage::filter()
 // -----------------------------------------------------------------------------
 void ITKMultiScaleHessianBasedObjectnessImage::filterInternal()
 {
-  Dream3DArraySwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
+  ITKPixelTypeSwitchMacro(this->filter, getSelectedCellArrayPath(), -4);
 }
 
 // -----------------------------------------------------------------------------
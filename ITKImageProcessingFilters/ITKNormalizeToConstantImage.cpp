@@ -38,6 +38,8 @@ void ITKNormalizeToConstantImage::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Constant", Constant, FilterParameter::Category::Parameter, ITKNormalizeToConstantImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -62,6 +64,7 @@ void ITKNormalizeToConstantImage::readFilterParameters(AbstractFilterParametersR
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setConstant(reader->readValue("Constant", getConstant()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -44,6 +44,8 @@ void ITKOtsuMultipleThresholdsImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("NumberOfHistogramBins", NumberOfHistogramBins, FilterParameter::Category::Parameter, ITKOtsuMultipleThresholdsImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("ValleyEmphasis", ValleyEmphasis, FilterParameter::Category::Parameter, ITKOtsuMultipleThresholdsImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -71,6 +73,7 @@ void ITKOtsuMultipleThresholdsImage::readFilterParameters(AbstractFilterParamete
   setNumberOfHistogramBins(reader->readValue("NumberOfHistogramBins", getNumberOfHistogramBins()));
   setValleyEmphasis(reader->readValue("ValleyEmphasis", getValleyEmphasis()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -80,6 +80,8 @@ void ITKPatchBasedDenoisingImage::setupFilterParameters()
   parameters.push_back(
       SIMPL_NEW_DOUBLE_FP("KernelBandwidthFractionPixelsForEstimation", KernelBandwidthFractionPixelsForEstimation, FilterParameter::Category::Parameter, ITKPatchBasedDenoisingImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -115,6 +117,7 @@ void ITKPatchBasedDenoisingImage::readFilterParameters(AbstractFilterParametersR
   setKernelBandwidthUpdateFrequency(reader->readValue("KernelBandwidthUpdateFrequency", getKernelBandwidthUpdateFrequency()));
   setKernelBandwidthFractionPixelsForEstimation(reader->readValue("KernelBandwidthFractionPixelsForEstimation", getKernelBandwidthFractionPixelsForEstimation()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
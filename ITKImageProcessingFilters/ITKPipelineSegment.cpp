@@ -0,0 +1,412 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#include "ITKImageProcessing/ITKImageProcessingFilters/ITKPipelineSegment.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSet>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/IFilterFactory.hpp"
+
+#include "ITKImageProcessing/ITKImageProcessingConstants.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKPipelineLink.h"
+#include "ITKImageProcessing/ITKImageProcessingVersion.h"
+
+namespace
+{
+const QString k_FilterNameKey = "Filter_Name";
+const QString k_KeepOutputKey = "Keep_Output";
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKPipelineSegment::ITKPipelineSegment()
+{
+  initialize();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKPipelineSegment::~ITKPipelineSegment() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::initialize()
+{
+  clearErrorCode();
+  clearWarningCode();
+  setCancel(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::setupFilterParameters()
+{
+  FilterParameterVectorType parameters;
+
+  parameters.push_back(SIMPL_NEW_STRING_FP("Filter Chain (JSON)", FilterChain, FilterParameter::Category::Parameter, ITKPipelineSegment));
+
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to filter", SelectedCellArrayPath, FilterParameter::Category::RequiredArray, ITKPipelineSegment, req));
+  }
+
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setSelectedCellArrayPath(reader->readDataArrayPath("SelectedCellArrayPath", getSelectedCellArrayPath()));
+  setFilterChain(reader->readString("FilterChain", getFilterChain()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKPipelineSegment::createStages()
+{
+  m_Stages.clear();
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(m_FilterChain.toUtf8(), &parseError);
+  if(parseError.error != QJsonParseError::NoError || !doc.isArray())
+  {
+    setErrorCondition(-66900, QString("The filter chain must be a JSON array of filters: %1").arg(parseError.errorString()));
+    return false;
+  }
+
+  QJsonArray chain = doc.array();
+  if(chain.isEmpty())
+  {
+    setErrorCondition(-66901, "The filter chain must contain at least one filter");
+    return false;
+  }
+
+  FilterManager* fm = FilterManager::Instance();
+  QSet<QString> outputNames;
+  for(int i = 0; i < chain.size(); i++)
+  {
+    QJsonObject filterObj = chain[i].toObject();
+    const QString filterName = filterObj[k_FilterNameKey].toString();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filterName);
+    if(nullptr == factory)
+    {
+      setErrorCondition(-66902, QString("Filter %1 of the chain: '%2' is not a known filter").arg(i + 1).arg(filterName));
+      return false;
+    }
+
+    ITKImageProcessingBase::Pointer filter = std::dynamic_pointer_cast<ITKImageProcessingBase>(factory->create());
+    if(nullptr == filter)
+    {
+      setErrorCondition(-66903, QString("Filter %1 of the chain: '%2' is not an ITK image filter").arg(i + 1).arg(filterName));
+      return false;
+    }
+    if(!filter->supportsPipelineLink())
+    {
+      setErrorCondition(-66905, QString("Filter %1 of the chain: '%2' reads its images directly from the data structure and cannot be chained").arg(i + 1).arg(filterName));
+      return false;
+    }
+
+    filter->readFilterParameters(filterObj);
+
+    // Each output is read by the next filter and intermediate outputs are removed by name, so the names must not
+    // collide with each other or with the input array.  A missing name is reported by the filter's own preflight.
+    const QString arrayName = filter->getNewCellArrayName();
+    if(!arrayName.isEmpty() && (arrayName == m_SelectedCellArrayPath.getDataArrayName() || outputNames.contains(arrayName)))
+    {
+      setErrorCondition(-66906, QString("Filter %1 of the chain: the output array name '%2' is already used by the input or an earlier filter. Set a unique NewCellArrayName").arg(i + 1).arg(arrayName));
+      return false;
+    }
+    outputNames.insert(arrayName);
+
+    connect(filter.get(), &AbstractFilter::messageGenerated, this, &AbstractFilter::messageGenerated);
+
+    Stage stage;
+    stage.filter = filter;
+    stage.keepOutput = filterObj[k_KeepOutputKey].toBool(false);
+    m_Stages.push_back(stage);
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::connectStages()
+{
+  DataArrayPath inputPath = m_SelectedCellArrayPath;
+  for(const auto& stage : m_Stages)
+  {
+    stage.filter->setDataContainerArray(getDataContainerArray());
+    stage.filter->setSelectedCellArrayPath(inputPath);
+    inputPath = DataArrayPath(m_SelectedCellArrayPath.getDataContainerName(), m_SelectedCellArrayPath.getAttributeMatrixName(), stage.filter->getNewCellArrayName());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::removeIntermediateArrays()
+{
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(m_SelectedCellArrayPath);
+  if(nullptr == am)
+  {
+    return;
+  }
+
+  // The last output is always kept
+  for(size_t i = 0; i + 1 < m_Stages.size(); i++)
+  {
+    const QString arrayName = m_Stages[i].filter->getNewCellArrayName();
+    if(!m_Stages[i].keepOutput && am->doesAttributeArrayExist(arrayName))
+    {
+      am->removeAttributeArray(arrayName);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+
+  if(!createStages())
+  {
+    return;
+  }
+
+  getDataContainerArray()->getPrereqIDataArrayFromPath(this, m_SelectedCellArrayPath);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  // During execute each filter checks its own arrays as it runs
+  if(!getInPreflight())
+  {
+    return;
+  }
+
+  connectStages();
+  for(size_t i = 0; i < m_Stages.size(); i++)
+  {
+    const ITKImageProcessingBase::Pointer& filter = m_Stages[i].filter;
+    filter->preflight();
+    if(filter->getErrorCode() < 0)
+    {
+      setErrorCondition(-66904, QString("Filter %1 of the chain (%2) failed with error %3").arg(i + 1).arg(filter->getHumanLabel()).arg(filter->getErrorCode()));
+      break;
+    }
+  }
+  removeIntermediateArrays();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::execute()
+{
+  initialize();
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  connectStages();
+
+  // Every filter hands its ITK output to the next one through the link.  Outputs that are not kept are
+  // only created as placeholders, and their ITK filters run when the next kept output is updated.
+  ITKPipelineLink::Pointer link = std::make_shared<ITKPipelineLink>();
+  for(size_t i = 0; i < m_Stages.size(); i++)
+  {
+    if(getCancel())
+    {
+      break;
+    }
+
+    const Stage& stage = m_Stages[i];
+    const bool lastStage = (i + 1 == m_Stages.size());
+    link->setWriteOutput(lastStage || stage.keepOutput);
+    notifyStatusMessage(QString("Filter %1 of %2: %3").arg(i + 1).arg(m_Stages.size()).arg(stage.filter->getHumanLabel()));
+
+    stage.filter->setPipelineLink(link);
+    stage.filter->execute();
+    stage.filter->setPipelineLink(nullptr);
+
+    if(stage.filter->getErrorCode() < 0)
+    {
+      setErrorCondition(-66904, QString("Filter %1 of the chain (%2) failed with error %3").arg(i + 1).arg(stage.filter->getHumanLabel()).arg(stage.filter->getErrorCode()));
+      break;
+    }
+  }
+
+  link->clear();
+  removeIntermediateArrays();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::setCancel(bool value)
+{
+  AbstractFilter::setCancel(value);
+  // Filters whose output is not kept run inside the update of a later filter, so every filter of the chain
+  // may be running when the cancel arrives
+  for(const auto& stage : m_Stages)
+  {
+    stage.filter->setCancel(value);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer ITKPipelineSegment::newFilterInstance(bool copyFilterParameters) const
+{
+  ITKPipelineSegment::Pointer filter = ITKPipelineSegment::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getCompiledLibraryName() const
+{
+  return ITKImageProcessingConstants::ITKImageProcessingBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getBrandingString() const
+{
+  return ITKImageProcessingConstants::ITKImageProcessingBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << ITKImageProcessing::Version::Major() << "." << ITKImageProcessing::Version::Minor() << "." << ITKImageProcessing::Version::Patch();
+  return version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getGroupName() const
+{
+  return "ITK Image Processing";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getSubGroupName() const
+{
+  return "ITK Pipeline";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getHumanLabel() const
+{
+  return "ITK::Pipeline Segment";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUuid ITKPipelineSegment::getUuid() const
+{
+  return QUuid("{e5687ca3-37f4-4904-91c0-580069009732}");
+}
+
+// -----------------------------------------------------------------------------
+ITKPipelineSegment::Pointer ITKPipelineSegment::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<ITKPipelineSegment> ITKPipelineSegment::New()
+{
+  struct make_shared_enabler : public ITKPipelineSegment
+  {
+  };
+  std::shared_ptr<make_shared_enabler> val = std::make_shared<make_shared_enabler>();
+  val->setupFilterParameters();
+  return val;
+}
+
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getNameOfClass() const
+{
+  return QString("ITKPipelineSegment");
+}
+
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::ClassName()
+{
+  return QString("ITKPipelineSegment");
+}
+
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::setSelectedCellArrayPath(const DataArrayPath& value)
+{
+  m_SelectedCellArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath ITKPipelineSegment::getSelectedCellArrayPath() const
+{
+  return m_SelectedCellArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void ITKPipelineSegment::setFilterChain(const QString& value)
+{
+  m_FilterChain = value;
+}
+
+// -----------------------------------------------------------------------------
+QString ITKPipelineSegment::getFilterChain() const
+{
+  return m_FilterChain;
+}
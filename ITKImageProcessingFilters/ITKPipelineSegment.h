@@ -0,0 +1,193 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/ITKImageProcessingBase.h"
+
+/**
+ * @brief The ITKPipelineSegment class runs an ordered list of ITK image filters as a single ITK pipeline.
+ * See [Filter documentation](@ref ITKPipelineSegment) for details.
+ */
+class ITKImageProcessing_EXPORT ITKPipelineSegment : public AbstractFilter
+{
+  Q_OBJECT
+
+  // Start Python bindings declarations
+  PYB11_BEGIN_BINDINGS(ITKPipelineSegment SUPERCLASS AbstractFilter)
+  PYB11_FILTER()
+  PYB11_SHARED_POINTERS(ITKPipelineSegment)
+  PYB11_FILTER_NEW_MACRO(ITKPipelineSegment)
+  PYB11_PROPERTY(DataArrayPath SelectedCellArrayPath READ getSelectedCellArrayPath WRITE setSelectedCellArrayPath)
+  PYB11_PROPERTY(QString FilterChain READ getFilterChain WRITE setFilterChain)
+  PYB11_END_BINDINGS()
+  // End Python bindings declarations
+
+public:
+  using Self = ITKPipelineSegment;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  static std::shared_ptr<ITKPipelineSegment> New();
+
+  /**
+   * @brief Returns the name of the class for ITKPipelineSegment
+   */
+  QString getNameOfClass() const override;
+  /**
+   * @brief Returns the name of the class for ITKPipelineSegment
+   */
+  static QString ClassName();
+
+  ~ITKPipelineSegment() override;
+
+  /**
+   * @brief Setter property for SelectedCellArrayPath
+   */
+  void setSelectedCellArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for SelectedCellArrayPath
+   * @return Value of SelectedCellArrayPath
+   */
+  DataArrayPath getSelectedCellArrayPath() const;
+  Q_PROPERTY(DataArrayPath SelectedCellArrayPath READ getSelectedCellArrayPath WRITE setSelectedCellArrayPath)
+
+  /**
+   * @brief Setter property for FilterChain.  The chain is a JSON array with one object per filter.  Each
+   * object holds the filter's class name under "Filter_Name" and its parameters in the same format as a
+   * pipeline file.  Setting "Keep_Output" to true writes that filter's output array as well as the last one.
+   */
+  void setFilterChain(const QString& value);
+  /**
+   * @brief Getter property for FilterChain
+   * @return Value of FilterChain
+   */
+  QString getFilterChain() const;
+  Q_PROPERTY(QString FilterChain READ getFilterChain WRITE setFilterChain)
+
+  /**
+   * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+   */
+  QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+   */
+  QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  QString getFilterVersion() const override;
+
+  /**
+   * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+   */
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+  /**
+   * @brief getGroupName Reimplemented from @see AbstractFilter class
+   */
+  QString getGroupName() const override;
+
+  /**
+   * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+   */
+  QString getSubGroupName() const override;
+
+  /**
+   * @brief getUuid Return the unique identifier for this filter.
+   * @return A QUuid object.
+   */
+  QUuid getUuid() const override;
+
+  /**
+   * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+   */
+  QString getHumanLabel() const override;
+
+  /**
+   * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void setupFilterParameters() override;
+
+  /**
+   * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
+
+  /**
+   * @brief execute Reimplemented from @see AbstractFilter class
+   */
+  void execute() override;
+
+  /**
+   * @brief setCancel Reimplemented from @see AbstractFilter class to cancel every filter of the chain.
+   * @param value
+   */
+  void setCancel(bool value) override;
+
+protected:
+  ITKPipelineSegment();
+
+  /**
+   * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+   */
+  void dataCheck() override;
+
+  /**
+   * @brief Initializes all the private instance variables.
+   */
+  void initialize();
+
+  /**
+   * @brief Creates the filters of the chain from the FilterChain JSON.  Returns false and sets an
+   * error condition if the chain is invalid.
+   * @return
+   */
+  bool createStages();
+
+  /**
+   * @brief Points each filter of the chain at the output array of the previous filter.
+   */
+  void connectStages();
+
+  /**
+   * @brief Removes the placeholder arrays created for filter outputs that are not kept.
+   */
+  void removeIntermediateArrays();
+
+public:
+  ITKPipelineSegment(const ITKPipelineSegment&) = delete;            // Copy Constructor Not Implemented
+  ITKPipelineSegment(ITKPipelineSegment&&) = delete;                 // Move Constructor Not Implemented
+  ITKPipelineSegment& operator=(const ITKPipelineSegment&) = delete; // Copy Assignment Not Implemented
+  ITKPipelineSegment& operator=(ITKPipelineSegment&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  struct Stage
+  {
+    ITKImageProcessingBase::Pointer filter;
+    bool keepOutput = false;
+  };
+
+  DataArrayPath m_SelectedCellArrayPath = {};
+  QString m_FilterChain = {};
+
+  std::vector<Stage> m_Stages;
+};
@@ -73,6 +73,7 @@ void ITKRefineTileCoordinates::setupFilterParameters()
   }
 
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Tile Overlap (Percent)", TileOverlap, FilterParameter::Category::RequiredArray, ITKRefineTileCoordinates));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Minimum Correlation Confidence", MinimumConfidence, FilterParameter::Category::Parameter, ITKRefineTileCoordinates));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Apply Refined Origin to Geometries", ApplyRefinedOrigin, FilterParameter::Category::Parameter, ITKRefineTileCoordinates));
 
   MultiDataContainerSelectionFilterParameter::RequirementType req;
@@ -215,6 +216,12 @@ void ITKRefineTileCoordinates::dataCheck()
     return;
   }
 
+  if(m_MinimumConfidence < -1.0f || m_MinimumConfidence > 1.0f)
+  {
+    setErrorCondition(-53009, "The 'Minimum Correlation Confidence' must be between -1 and 1.");
+    return;
+  }
+
   DataContainerArray::Pointer dca = getDataContainerArray();
   std::vector<size_t> cDims = {1};
 
@@ -271,7 +278,7 @@ void executeRefinement(ITKRefineTileCoordinates* filter)
   // Otherwise, we're not using the zeiss data method so call this and let everything work itself out
   IntVec3Type tileDims = filter->getMontageSize();
   FloatArrayType::Pointer coordsPtr =
-      DetermineStitching::FindGlobalOrigins<T, 3>(filter, tileDims[0], tileDims[1], filter->getImportMode(), filter->getTileOverlap(), pointers, udims, origin, spacing, dataContainerNames);
+      DetermineStitching::FindGlobalOrigins<T, 3>(filter, tileDims[0], tileDims[1], filter->getImportMode(), filter->getTileOverlap(), filter->getMinimumConfidence(), pointers, udims, origin, spacing, dataContainerNames);
 
   // Check for cancel...
   if(filter->getCancel())
@@ -527,6 +534,18 @@ float ITKRefineTileCoordinates::getTileOverlap() const
   return m_TileOverlap;
 }
 
+// -----------------------------------------------------------------------------
+void ITKRefineTileCoordinates::setMinimumConfidence(float value)
+{
+  m_MinimumConfidence = value;
+}
+
+// -----------------------------------------------------------------------------
+float ITKRefineTileCoordinates::getMinimumConfidence() const
+{
+  return m_MinimumConfidence;
+}
+
 // -----------------------------------------------------------------------------
 void ITKRefineTileCoordinates::setApplyRefinedOrigin(bool value)
 {
@@ -36,6 +36,7 @@ class ITKImageProcessing_EXPORT ITKRefineTileCoordinates : public AbstractFilter
   PYB11_PROPERTY(QString CommonDataArrayName READ getCommonDataArrayName WRITE setCommonDataArrayName)
   PYB11_PROPERTY(int ImportMode READ getImportMode WRITE setImportMode)
   PYB11_PROPERTY(float TileOverlap READ getTileOverlap WRITE setTileOverlap)
+  PYB11_PROPERTY(float MinimumConfidence READ getMinimumConfidence WRITE setMinimumConfidence)
   PYB11_PROPERTY(bool ApplyRefinedOrigin READ getApplyRefinedOrigin WRITE setApplyRefinedOrigin)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
@@ -127,6 +128,17 @@ public:
   float getTileOverlap() const;
   Q_PROPERTY(float TileOverlap READ getTileOverlap WRITE setTileOverlap)
 
+  /**
+   * @brief Setter property for MinimumConfidence
+   */
+  void setMinimumConfidence(float value);
+  /**
+   * @brief Getter property for MinimumConfidence
+   * @return Value of MinimumConfidence
+   */
+  float getMinimumConfidence() const;
+  Q_PROPERTY(float MinimumConfidence READ getMinimumConfidence WRITE setMinimumConfidence)
+
   /**
    * @brief Setter property for ApplyRefinedOrigin
    */
@@ -237,6 +249,7 @@ private:
   QString m_CommonDataArrayName = {ITKImageProcessing::Montage::k_TileDataArrayDefaultName};
   int m_ImportMode = {};
   float m_TileOverlap = {10.0f};
+  float m_MinimumConfidence = {0.0f};
   bool m_ApplyRefinedOrigin = {};
   std::weak_ptr<DataArray<ITKImageProcessingConstants::DefaultPixelType>> m_SelectedCellArrayPtr;
   ITKImageProcessingConstants::DefaultPixelType* m_SelectedCellArray = nullptr;
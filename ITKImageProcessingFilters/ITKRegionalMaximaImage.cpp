@@ -44,6 +44,8 @@ void ITKRegionalMaximaImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_BOOL_FP("FullyConnected", FullyConnected, FilterParameter::Category::Parameter, ITKRegionalMaximaImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("FlatIsMaxima", FlatIsMaxima, FilterParameter::Category::Parameter, ITKRegionalMaximaImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -71,6 +73,7 @@ void ITKRegionalMaximaImage::readFilterParameters(AbstractFilterParametersReader
   setFullyConnected(reader->readValue("FullyConnected", getFullyConnected()));
   setFlatIsMaxima(reader->readValue("FlatIsMaxima", getFlatIsMaxima()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -44,6 +44,8 @@ void ITKRegionalMinimaImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_BOOL_FP("FullyConnected", FullyConnected, FilterParameter::Category::Parameter, ITKRegionalMinimaImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("FlatIsMinima", FlatIsMinima, FilterParameter::Category::Parameter, ITKRegionalMinimaImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -71,6 +73,7 @@ void ITKRegionalMinimaImage::readFilterParameters(AbstractFilterParametersReader
   setFullyConnected(reader->readValue("FullyConnected", getFullyConnected()));
   setFlatIsMinima(reader->readValue("FlatIsMinima", getFlatIsMinima()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
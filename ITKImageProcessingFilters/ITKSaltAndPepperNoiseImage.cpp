@@ -41,6 +41,8 @@ void ITKSaltAndPepperNoiseImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Probability", Probability, FilterParameter::Category::Parameter, ITKSaltAndPepperNoiseImage));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Seed", Seed, FilterParameter::Category::Parameter, ITKSaltAndPepperNoiseImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -66,6 +68,7 @@ void ITKSaltAndPepperNoiseImage::readFilterParameters(AbstractFilterParametersRe
   setProbability(reader->readValue("Probability", getProbability()));
   setSeed(reader->readValue("Seed", getSeed()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
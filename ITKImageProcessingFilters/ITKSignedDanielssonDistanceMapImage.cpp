@@ -42,6 +42,8 @@ void ITKSignedDanielssonDistanceMapImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_BOOL_FP("SquaredDistance", SquaredDistance, FilterParameter::Category::Parameter, ITKSignedDanielssonDistanceMapImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("UseImageSpacing", UseImageSpacing, FilterParameter::Category::Parameter, ITKSignedDanielssonDistanceMapImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -68,6 +70,7 @@ void ITKSignedDanielssonDistanceMapImage::readFilterParameters(AbstractFilterPar
   setSquaredDistance(reader->readValue("SquaredDistance", getSquaredDistance()));
   setUseImageSpacing(reader->readValue("UseImageSpacing", getUseImageSpacing()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -44,6 +44,8 @@ void ITKSignedMaurerDistanceMapImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_BOOL_FP("UseImageSpacing", UseImageSpacing, FilterParameter::Category::Parameter, ITKSignedMaurerDistanceMapImage));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("BackgroundValue", BackgroundValue, FilterParameter::Category::Parameter, ITKSignedMaurerDistanceMapImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -71,6 +73,7 @@ void ITKSignedMaurerDistanceMapImage::readFilterParameters(AbstractFilterParamet
   setUseImageSpacing(reader->readValue("UseImageSpacing", getUseImageSpacing()));
   setBackgroundValue(reader->readValue("BackgroundValue", getBackgroundValue()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -41,6 +41,8 @@ void ITKSmoothingRecursiveGaussianImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Sigma", Sigma, FilterParameter::Category::Parameter, ITKSmoothingRecursiveGaussianImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("NormalizeAcrossScale", NormalizeAcrossScale, FilterParameter::Category::Parameter, ITKSmoothingRecursiveGaussianImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -66,6 +68,7 @@ void ITKSmoothingRecursiveGaussianImage::readFilterParameters(AbstractFilterPara
   setSigma(reader->readFloatVec3("Sigma", getSigma()));
   setNormalizeAcrossScale(reader->readValue("NormalizeAcrossScale", getNormalizeAcrossScale()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -38,6 +38,8 @@ void ITKStandardDeviationProjectionImage::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("ProjectionDimension", ProjectionDimension, FilterParameter::Category::Parameter, ITKStandardDeviationProjectionImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -62,6 +64,7 @@ void ITKStandardDeviationProjectionImage::readFilterParameters(AbstractFilterPar
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setProjectionDimension(reader->readValue("ProjectionDimension", getProjectionDimension()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -34,7 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ITKStitchMontage.h"
 
+#include <algorithm>
 #include <sstream>
+#include <type_traits>
+
+#include <QtCore/QFileInfo>
 
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/Common/Constants.h"
@@ -46,6 +50,7 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/MontageSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/MultiDataContainerSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/PreflightUpdatedValueFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -58,12 +63,14 @@
 #include "SIMPLib/ITK/itkProgressObserver.hpp"
 #include "SIMPLib/ITK/itkTransformToDream3DITransformContainer.h"
 #include "SIMPLib/ITK/itkTransformToDream3DTransformContainer.h"
+#include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "ITKImageProcessing/ITKImageProcessingConstants.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/util/MontageImportHelper.h"
 #include "ITKImageProcessing/ITKImageProcessingVersion.h"
 
 #include "util/MontageImportHelper.h"
+#include "util/TiledTiffWriter.h"
 
 #include "itkImageFileWriter.h"
 #include "itkStreamingImageFilter.h"
@@ -214,6 +221,12 @@ void ITKStitchMontage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_STRING_FP("Montage Attribute Matrix Name", MontageAttributeMatrixName, FilterParameter::Category::CreatedArray, ITKStitchMontage));
   parameters.push_back(SIMPL_NEW_STRING_FP("Montage Data Array Name", MontageDataArrayName, FilterParameter::Category::CreatedArray, ITKStitchMontage));
 
+  std::vector<QString> linkedStreamProps{"OutputFilePath", "BandHeight", "PyramidLevels"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stream Montage to Tiled TIFF File", StreamToFile, FilterParameter::Category::Parameter, ITKStitchMontage, linkedStreamProps));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFilePath, FilterParameter::Category::Parameter, ITKStitchMontage, "*.tif"));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Band Height (Rows)", BandHeight, FilterParameter::Category::Parameter, ITKStitchMontage));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Pyramid Levels", PyramidLevels, FilterParameter::Category::Parameter, ITKStitchMontage));
+
   setFilterParameters(parameters);
 }
 
@@ -355,6 +368,42 @@ void ITKStitchMontage::dataCheck()
     }
   }
 
+  m_MontageSize[0] = m_MontageSelection.getColEnd() - m_MontageSelection.getColStart() + 1;
+  m_MontageSize[1] = m_MontageSelection.getRowEnd() - m_MontageSelection.getRowStart() + 1;
+
+  // A streamed montage only exists in the output file
+  if(m_StreamToFile)
+  {
+    QFileInfo fi(getOutputFilePath());
+    if(fi.suffix().isEmpty())
+    {
+      setOutputFilePath(getOutputFilePath().append(".tif"));
+    }
+    else if(fi.suffix().compare("tif", Qt::CaseInsensitive) != 0 && fi.suffix().compare("tiff", Qt::CaseInsensitive) != 0)
+    {
+      QString ss = QObject::tr("The Output File '%1' must be a TIFF file with a .tif or .tiff extension.").arg(getOutputFilePath());
+      setErrorCondition(-11021, ss);
+      return;
+    }
+    FileSystemPathHelper::CheckOutputFile(this, "Output File", getOutputFilePath(), true);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    if(getBandHeight() < 1)
+    {
+      QString ss = QObject::tr("The Band Height (%1) must be at least 1 row.").arg(getBandHeight());
+      setErrorCondition(-11022, ss);
+      return;
+    }
+    if(getPyramidLevels() < 0 || getPyramidLevels() > 16)
+    {
+      QString ss = QObject::tr("The number of Pyramid Levels (%1) must be between 0 and 16.").arg(getPyramidLevels());
+      setErrorCondition(-11025, ss);
+    }
+    return;
+  }
+
   if(getMontageDataContainerName().isEmpty())
   {
     QString ss = QObject::tr("Montage Data Container is empty.");
@@ -385,9 +434,6 @@ void ITKStitchMontage::dataCheck()
     return;
   }
 
-  m_MontageSize[0] = m_MontageSelection.getColEnd() - m_MontageSelection.getColStart() + 1;
-  m_MontageSize[1] = m_MontageSelection.getRowEnd() - m_MontageSelection.getRowStart() + 1;
-
   size_t montageArrayXSize = tileTupleDims[0] * m_MontageSize[0];
   size_t montageArrayYSize = tileTupleDims[1] * m_MontageSize[1];
 
@@ -488,6 +534,12 @@ void ITKStitchMontage::stitchMontage(int peakMethodToUse, unsigned streamSubdivi
   // Initialize the resampler
   initializeResampler<PixelType, MontageType, Resampler>(resampler);
 
+  if(m_StreamToFile)
+  {
+    writeStitchedBands<PixelType, Resampler>(resampler);
+    return;
+  }
+
   // Execute the stitching algorithm
   executeStitching<PixelType, Resampler>(resampler, streamSubdivisions);
 
@@ -605,6 +657,89 @@ void ITKStitchMontage::executeStitching(typename Resampler::Pointer resampler, u
   resampler->RemoveObserver(progressObsTag);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename PixelType, typename Resampler>
+void ITKStitchMontage::writeStitchedBands(typename Resampler::Pointer resampler)
+{
+  using OriginalImageType = itk::Image<PixelType, Dimension>;
+  using ScalarPixelType = typename itk::NumericTraits<PixelType>::ValueType;
+
+  resampler->UpdateOutputInformation();
+  OriginalImageType* output = resampler->GetOutput();
+  const typename OriginalImageType::RegionType largestRegion = output->GetLargestPossibleRegion();
+  const uint32_t width = static_cast<uint32_t>(largestRegion.GetSize(0));
+  const uint32_t height = static_cast<uint32_t>(largestRegion.GetSize(1));
+
+  TiledTiffWriter::SampleFormat sampleFormat = TiledTiffWriter::SampleFormat::UnsignedInteger;
+  if(std::is_floating_point<ScalarPixelType>::value)
+  {
+    sampleFormat = TiledTiffWriter::SampleFormat::Float;
+  }
+  else if(std::is_signed<ScalarPixelType>::value)
+  {
+    sampleFormat = TiledTiffWriter::SampleFormat::SignedInteger;
+  }
+  const uint16_t componentCount = static_cast<uint16_t>(sizeof(PixelType) / sizeof(ScalarPixelType));
+
+  TiledTiffWriter writer;
+  if(!writer.open(getOutputFilePath()) || !writer.beginImage(width, height, componentCount, sizeof(ScalarPixelType), sampleFormat, static_cast<uint32_t>(getPyramidLevels())))
+  {
+    setErrorCondition(-11023, writer.getErrorMessage());
+    writer.discard();
+    return;
+  }
+
+  // Every band but the last must cover whole rows of file tiles
+  const uint32_t tileSize = TiledTiffWriter::k_TileSize;
+  const uint32_t bandHeight = (static_cast<uint32_t>(getBandHeight()) + tileSize - 1) / tileSize * tileSize;
+
+  for(uint32_t firstRow = 0; firstRow < height; firstRow += bandHeight)
+  {
+    if(getCancel())
+    {
+      writer.discard();
+      QString ss = QString("The stitching was canceled and the partial file '%1' was deleted").arg(getOutputFilePath());
+      setWarningCondition(-11026, ss);
+      return;
+    }
+    const uint32_t rowCount = std::min(bandHeight, height - firstRow);
+    notifyStatusMessage(QString("Stitching rows %1 to %2 of %3").arg(firstRow).arg(firstRow + rowCount).arg(height));
+
+    // Request only this band from the resampler, the same way itk::StreamingImageFilter requests its pieces
+    typename OriginalImageType::RegionType bandRegion = largestRegion;
+    bandRegion.SetIndex(1, largestRegion.GetIndex(1) + firstRow);
+    bandRegion.SetSize(1, rowCount);
+    output->SetRequestedRegion(bandRegion);
+    output->PropagateRequestedRegion();
+    output->UpdateOutputData();
+
+    // The buffer spans whole montage rows, so the band's rows follow each other from the first pixel of the band
+    const PixelType* bandData = output->GetBufferPointer() + output->ComputeOffset(bandRegion.GetIndex());
+    if(!writer.writeBand(firstRow, rowCount, bandData))
+    {
+      setErrorCondition(-11024, writer.getErrorMessage());
+      writer.discard();
+      return;
+    }
+  }
+  output->ReleaseData();
+
+  // Closing the file appends the pyramid levels, which were averaged down from the bands as they were written
+  if(getPyramidLevels() > 0)
+  {
+    notifyStatusMessage(QString("Writing %1 pyramid levels").arg(getPyramidLevels()));
+  }
+  if(!writer.close())
+  {
+    setErrorCondition(-11024, writer.getErrorMessage());
+    writer.discard();
+    return;
+  }
+  notifyStatusMessage(QString("Wrote the %1 x %2 montage to '%3'").arg(width).arg(height).arg(getOutputFilePath()));
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -816,6 +951,54 @@ QString ITKStitchMontage::getMontageDataArrayName() const
   return m_MontageDataArrayName;
 }
 
+// -----------------------------------------------------------------------------
+void ITKStitchMontage::setStreamToFile(bool value)
+{
+  m_StreamToFile = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ITKStitchMontage::getStreamToFile() const
+{
+  return m_StreamToFile;
+}
+
+// -----------------------------------------------------------------------------
+void ITKStitchMontage::setOutputFilePath(const QString& value)
+{
+  m_OutputFilePath = value;
+}
+
+// -----------------------------------------------------------------------------
+QString ITKStitchMontage::getOutputFilePath() const
+{
+  return m_OutputFilePath;
+}
+
+// -----------------------------------------------------------------------------
+void ITKStitchMontage::setBandHeight(int value)
+{
+  m_BandHeight = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKStitchMontage::getBandHeight() const
+{
+  return m_BandHeight;
+}
+
+// -----------------------------------------------------------------------------
+void ITKStitchMontage::setPyramidLevels(int value)
+{
+  m_PyramidLevels = value;
+}
+
+// -----------------------------------------------------------------------------
+int ITKStitchMontage::getPyramidLevels() const
+{
+  return m_PyramidLevels;
+}
+
 // -----------------------------------------------------------------------------
 MontageSelection ITKStitchMontage::getMontageSelection() const
 {
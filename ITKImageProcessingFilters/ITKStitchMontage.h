@@ -74,6 +74,10 @@ class ITKImageProcessing_EXPORT ITKStitchMontage : public AbstractFilter
   PYB11_PROPERTY(QString MontageDataContainerName READ getMontageDataContainerName WRITE setMontageDataContainerName)
   PYB11_PROPERTY(QString MontageAttributeMatrixName READ getMontageAttributeMatrixName WRITE setMontageAttributeMatrixName)
   PYB11_PROPERTY(QString MontageDataArrayName READ getMontageDataArrayName WRITE setMontageDataArrayName)
+  PYB11_PROPERTY(bool StreamToFile READ getStreamToFile WRITE setStreamToFile)
+  PYB11_PROPERTY(QString OutputFilePath READ getOutputFilePath WRITE setOutputFilePath)
+  PYB11_PROPERTY(int BandHeight READ getBandHeight WRITE setBandHeight)
+  PYB11_PROPERTY(int PyramidLevels READ getPyramidLevels WRITE setPyramidLevels)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -165,6 +169,53 @@ public:
   QString getMontageDataArrayName() const;
   Q_PROPERTY(QString MontageDataArrayName READ getMontageDataArrayName WRITE setMontageDataArrayName)
 
+  /**
+   * @brief Setter property for StreamToFile.  When set the montage is written band by band to the tiled
+   * BigTIFF file OutputFilePath instead of being stored in a data array.
+   */
+  void setStreamToFile(bool value);
+  /**
+   * @brief Getter property for StreamToFile
+   * @return Value of StreamToFile
+   */
+  bool getStreamToFile() const;
+  Q_PROPERTY(bool StreamToFile READ getStreamToFile WRITE setStreamToFile)
+
+  /**
+   * @brief Setter property for OutputFilePath
+   */
+  void setOutputFilePath(const QString& value);
+  /**
+   * @brief Getter property for OutputFilePath
+   * @return Value of OutputFilePath
+   */
+  QString getOutputFilePath() const;
+  Q_PROPERTY(QString OutputFilePath READ getOutputFilePath WRITE setOutputFilePath)
+
+  /**
+   * @brief Setter property for BandHeight.  The number of montage rows stitched at a time when streaming to
+   * a file, rounded up to a multiple of the file's tile size.
+   */
+  void setBandHeight(int value);
+  /**
+   * @brief Getter property for BandHeight
+   * @return Value of BandHeight
+   */
+  int getBandHeight() const;
+  Q_PROPERTY(int BandHeight READ getBandHeight WRITE setBandHeight)
+
+  /**
+   * @brief Setter property for PyramidLevels.  The number of reduced resolution levels, each half the size of
+   * the previous one, written after the montage when streaming to a file.
+   */
+  void setPyramidLevels(int value);
+  /**
+   * @brief Getter property for PyramidLevels
+   * @return Value of PyramidLevels
+   */
+  int getPyramidLevels() const;
+  Q_PROPERTY(int PyramidLevels READ getPyramidLevels WRITE setPyramidLevels)
+
   /**
    * @brief getMontageInformation
    * @return
@@ -260,6 +311,10 @@ private:
   QString m_MontageDataContainerName = {ITKImageProcessing::Montage::k_MontageDataContainerDefaultName};
   QString m_MontageAttributeMatrixName = {ITKImageProcessing::Montage::k_MontageAttributeMatrixDefaultName};
   QString m_MontageDataArrayName = {ITKImageProcessing::Montage::k_MontageDataArrayDefaultName};
+  bool m_StreamToFile = {false};
+  QString m_OutputFilePath = {};
+  int m_BandHeight = {2048};
+  int m_PyramidLevels = {0};
 
   // QString m_DataContainerList;
 
@@ -286,6 +341,14 @@ private:
   template <typename PixelType, typename Resampler>
   void executeStitching(typename Resampler::Pointer resampler, unsigned streamSubdivisions);
 
+  /**
+   * @brief writeStitchedBands Stitches the montage one band of rows at a time and writes each band to the
+   * output file, so only one band of the montage is held in memory.
+   * @param resampler
+   */
+  template <typename PixelType, typename Resampler>
+  void writeStitchedBands(typename Resampler::Pointer resampler);
+
   /**
    * @brief convertMontageToD3D
    */
@@ -44,6 +44,8 @@ void ITKThresholdMaximumConnectedComponentsImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("InsideValue", InsideValue, FilterParameter::Category::Parameter, ITKThresholdMaximumConnectedComponentsImage));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("OutsideValue", OutsideValue, FilterParameter::Category::Parameter, ITKThresholdMaximumConnectedComponentsImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -71,6 +73,7 @@ void ITKThresholdMaximumConnectedComponentsImage::readFilterParameters(AbstractF
   setInsideValue(reader->readValue("InsideValue", getInsideValue()));
   setOutsideValue(reader->readValue("OutsideValue", getOutsideValue()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
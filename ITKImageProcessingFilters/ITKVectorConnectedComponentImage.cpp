@@ -54,6 +54,8 @@ void ITKVectorConnectedComponentImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("DistanceThreshold", DistanceThreshold, FilterParameter::Category::Parameter, ITKVectorConnectedComponentImage));
   parameters.push_back(SIMPL_NEW_BOOL_FP("FullyConnected", FullyConnected, FilterParameter::Category::Parameter, ITKVectorConnectedComponentImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -79,6 +81,7 @@ void ITKVectorConnectedComponentImage::readFilterParameters(AbstractFilterParame
   setDistanceThreshold(reader->readValue("DistanceThreshold", getDistanceThreshold()));
   setFullyConnected(reader->readValue("FullyConnected", getFullyConnected()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
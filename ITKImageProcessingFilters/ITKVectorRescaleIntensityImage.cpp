@@ -95,6 +95,8 @@ void ITKVectorRescaleIntensityImage::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("OutputMaximumMagnitude", OutputMaximumMagnitude, FilterParameter::Category::Parameter, ITKVectorRescaleIntensityImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -119,6 +121,7 @@ void ITKVectorRescaleIntensityImage::readFilterParameters(AbstractFilterParamete
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setOutputMaximumMagnitude(reader->readValue("OutputMaximumMagnitude", getOutputMaximumMagnitude()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
@@ -40,6 +40,8 @@ void ITKZeroCrossingImage::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("ForegroundValue", ForegroundValue, FilterParameter::Category::Parameter, ITKZeroCrossingImage));
   parameters.push_back(SIMPL_NEW_INTEGER_FP("BackgroundValue", BackgroundValue, FilterParameter::Category::Parameter, ITKZeroCrossingImage));
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -65,6 +67,7 @@ void ITKZeroCrossingImage::readFilterParameters(AbstractFilterParametersReader*
   setForegroundValue(reader->readValue("ForegroundValue", getForegroundValue()));
   setBackgroundValue(reader->readValue("BackgroundValue", getBackgroundValue()));
 
+  readExecutionFilterParameters(reader);
   reader->closeFilterGroup();
 }
 
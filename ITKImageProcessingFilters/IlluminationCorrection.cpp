@@ -69,6 +69,7 @@
 #include "ITKImageProcessing/ITKImageProcessingConstants.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/ITKImageWriter.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/ITKMedianImage.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKPhaseTimer.h"
 #include "ITKImageProcessing/ITKImageProcessingVersion.h"
 #include "ITKImageProcessing/ZeissXml/ZeissTagMapping.h"
 
@@ -102,11 +103,12 @@ class ProcessInputImagesImpl
 public:
   using AccumDataArrayType = DataArray<AccumType>;
 
-  ProcessInputImagesImpl(IlluminationCorrection* filter, QString dcName, AccumType average, const AccumDataArrayType& accumArray)
+  ProcessInputImagesImpl(IlluminationCorrection* filter, QString dcName, AccumType average, const AccumDataArrayType& accumArray, ITKPhaseTimer* timer)
   : m_Filter(filter)
   , m_DcName(std::move(dcName))
   , m_Average(average)
   , m_AccumArray(accumArray)
+  , m_Timer(timer)
   {
   }
   ~ProcessInputImagesImpl() = default;
@@ -132,28 +134,32 @@ public:
 
     size_t totalPoints = inputImage.getNumberOfTuples();
 
-    for(size_t t = 0; t < totalPoints; t++)
     {
-      AccumType numerator = static_cast<AccumType>(inputImage[t]);
-      AccumType denominator = m_AccumArray[t];
-
-      AccumType temp = m_Average * numerator;
-      if(denominator != 0)
-      {
-        temp = temp / denominator;
-      }
-      if(temp < 0)
+      ITKPhaseTimer::Scope scope(m_Timer, "correct");
+      for(size_t t = 0; t < totalPoints; t++)
       {
-        temp = 0;
-      }
-      if(temp > std::numeric_limits<OutArrayType>::max())
-      {
-        temp = std::numeric_limits<OutArrayType>::max();
+        AccumType numerator = static_cast<AccumType>(inputImage[t]);
+        AccumType denominator = m_AccumArray[t];
+
+        AccumType temp = m_Average * numerator;
+        if(denominator != 0)
+        {
+          temp = temp / denominator;
+        }
+        if(temp < 0)
+        {
+          temp = 0;
+        }
+        if(temp > std::numeric_limits<OutArrayType>::max())
+        {
+          temp = std::numeric_limits<OutArrayType>::max();
+        }
+        correctedImage[t] = temp;
       }
-      correctedImage[t] = temp;
     }
     if(m_Filter->getExportCorrectedImages())
     {
+      ITKPhaseTimer::Scope scope(m_Timer, "write");
       ITKImageWriter::Pointer imageWriter = ITKImageWriter::New();
       imageWriter->setDataContainerArray(m_Filter->getDataContainerArray());
       QString outputPath = QString("%1/%2%3").arg(m_Filter->getOutputPath()).arg(m_DcName).arg(m_Filter->getFileExtension());
@@ -176,13 +182,14 @@ private:
   QString m_DcName;
   AccumType m_Average;
   const DataArray<AccumType>& m_AccumArray;
+  ITKPhaseTimer* m_Timer = nullptr;
 };
 
 /**
  * @brief Calculates the output values using the templated output IDataArray output type
  */
 template <typename OutArrayType, typename GeomType, typename AccumType>
-void calculateOutputValues(IlluminationCorrection* filter)
+void calculateOutputValues(IlluminationCorrection* filter, ITKPhaseTimer& timer)
 {
 
   using OutputDataArrayType = DataArray<OutArrayType>;
@@ -219,6 +226,7 @@ void calculateOutputValues(IlluminationCorrection* filter)
   QStringList dcNames = filter->getMontageSelection().getDataContainerNamesCombOrder();
   for(const auto& dcName : dcNames)
   {
+    ITKPhaseTimer::Scope scope(&timer, "accumulate");
     DataArrayPath imageArrayPath(dcName, filter->getCellAttributeMatrixName(), filter->getImageDataArrayName());
     OutputDataArrayPointerType imageArrayPtr = dca->getAttributeMatrix(imageArrayPath)->getAttributeArrayAs<OutputDataArrayType>(imageArrayPath.getDataArrayName());
     OutputDataArrayType& imageArray = *imageArrayPtr;
@@ -249,6 +257,7 @@ void calculateOutputValues(IlluminationCorrection* filter)
   {
     QString progressMessage = QString("Applying Median Filter to Background Image...");
     filter->notifyStatusMessage(progressMessage);
+    ITKPhaseTimer::Scope scope(&timer, "median");
 
     ITKMedianImage::Pointer imageProcessingFilter = ITKMedianImage::New();
     DataContainerArray::Pointer dca = filter->getDataContainerArray();
@@ -300,7 +309,7 @@ void calculateOutputValues(IlluminationCorrection* filter)
     for(const auto& dcName : dcNames)
     {
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      g->run(ProcessInputImagesImpl<OutArrayType, AccumType>(filter, dcName, average, newAccumArray));
+      g->run(ProcessInputImagesImpl<OutArrayType, AccumType>(filter, dcName, average, newAccumArray, &timer));
       threadCount++;
       if(threadCount == nthreads)
       {
@@ -308,7 +317,7 @@ void calculateOutputValues(IlluminationCorrection* filter)
         threadCount = 0;
       }
 #else
-      ProcessInputImagesImpl<OutArrayType, AccumType> impl(filter, dcName, average, accumArray);
+      ProcessInputImagesImpl<OutArrayType, AccumType> impl(filter, dcName, average, accumArray, &timer);
       impl();
 #endif
     }
@@ -699,7 +708,9 @@ void IlluminationCorrection::execute()
 
   ArrayType arrayType = getArrayType();
   GeomType geomType = getGeomType();
-  calculateOutputValues(arrayType, geomType);
+  ITKPhaseTimer timer(getNameOfClass());
+  calculateOutputValues(arrayType, geomType, timer);
+  timer.report(this);
 }
 
 // -----------------------------------------------------------------------------
@@ -744,7 +755,7 @@ IGeometryGrid::Pointer IlluminationCorrection::checkInputArrays(ArrayType arrayT
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void IlluminationCorrection::calculateOutputValues(ArrayType arrayType, GeomType geomType)
+void IlluminationCorrection::calculateOutputValues(ArrayType arrayType, GeomType geomType, ITKPhaseTimer& timer)
 {
 
   if(geomType != GeomType::ImageGeom && geomType != GeomType::RectGridGeom)
@@ -755,27 +766,27 @@ void IlluminationCorrection::calculateOutputValues(ArrayType arrayType, GeomType
 
   if(arrayType == ArrayType::UInt8 && geomType == GeomType::ImageGeom)
   {
-    ::calculateOutputValues<uint8_t, ImageGeom, uint64_t>(this);
+    ::calculateOutputValues<uint8_t, ImageGeom, uint64_t>(this, timer);
   }
   if(arrayType == ArrayType::UInt16 && geomType == GeomType::ImageGeom)
   {
-    ::calculateOutputValues<uint16_t, ImageGeom, uint64_t>(this);
+    ::calculateOutputValues<uint16_t, ImageGeom, uint64_t>(this, timer);
   }
   if(arrayType == ArrayType::Float32 && geomType == GeomType::ImageGeom)
   {
-    ::calculateOutputValues<float, ImageGeom, double>(this);
+    ::calculateOutputValues<float, ImageGeom, double>(this, timer);
   }
   if(arrayType == ArrayType::UInt8 && geomType == GeomType::RectGridGeom)
   {
-    ::calculateOutputValues<uint8_t, RectGridGeom, uint64_t>(this);
+    ::calculateOutputValues<uint8_t, RectGridGeom, uint64_t>(this, timer);
   }
   if(arrayType == ArrayType::UInt16 && geomType == GeomType::RectGridGeom)
   {
-    ::calculateOutputValues<uint16_t, RectGridGeom, uint64_t>(this);
+    ::calculateOutputValues<uint16_t, RectGridGeom, uint64_t>(this, timer);
   }
   if(arrayType == ArrayType::Float32 && geomType == GeomType::RectGridGeom)
   {
-    ::calculateOutputValues<float, RectGridGeom, double>(this);
+    ::calculateOutputValues<float, RectGridGeom, double>(this, timer);
   }
 }
 
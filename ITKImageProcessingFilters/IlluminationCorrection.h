@@ -46,6 +46,8 @@
 #include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
 #include "ITKImageProcessing/ZeissXml/ZeissTagsXmlSection.h"
 
+class ITKPhaseTimer;
+
 /**
  * @class IlluminationCorrection IlluminationCorrection.h ZeissImport/IlluminationCorrections/IlluminationCorrection.h
  * @brief
@@ -402,9 +404,10 @@ protected:
    * @brief Calls the corresponding calculateOutputValues based on the array and geometry type.
    * @param arrayType
    * @param geomType
+   * @param timer Records the time spent in each phase of the correction
    * @return
    */
-  void calculateOutputValues(ArrayType arrayType, GeomType geomType);
+  void calculateOutputValues(ArrayType arrayType, GeomType geomType, ITKPhaseTimer& timer);
 
   /**
    * @brief Checks the input arrays' type and geometry type and returns a deep copy of the geometry.
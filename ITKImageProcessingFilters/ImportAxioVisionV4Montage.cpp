@@ -857,14 +857,13 @@ void ImportAxioVisionV4Montage::addRootMetaData(const AttributeMatrix::Pointer&
 void ImportAxioVisionV4Montage::readImages()
 {
   std::vector<BoundsType>& bounds = d_ptr->m_BoundsCache;
-  // Import Each Image
-  DataContainerArray::Pointer dca = getDataContainerArray();
 
   //  int imageCountPadding = MetaXmlUtils::CalculatePaddingDigits(bounds.size());
   int32_t rowCountPadding = MetaXmlUtils::CalculatePaddingDigits(m_RowCount);
   int32_t colCountPadding = MetaXmlUtils::CalculatePaddingDigits(m_ColumnCount);
   int charPaddingCount = std::max(rowCountPadding, colCountPadding);
 
+  std::vector<MontageImportHelper::TileImport> tiles;
   for(const auto& bound : bounds)
   {
     if(bound.Row < m_MontageStart[1] || bound.Row > m_MontageEnd[1] || bound.Col < m_MontageStart[0] || bound.Col > m_MontageEnd[0])
@@ -872,87 +871,14 @@ void ImportAxioVisionV4Montage::readImages()
       continue;
     }
 
-    QString msg;
-    QTextStream out(&msg);
-    out << "Importing " << bound.Filename;
-    notifyStatusMessage(msg);
     // Create our DataContainer Name using a Prefix and a rXXcYY format.
-    QString dcName = getDataContainerPath().getDataContainerName();
-    QTextStream dcNameStream(&dcName);
-    dcNameStream << "r";
-    dcNameStream.setFieldWidth(charPaddingCount);
-    dcNameStream.setFieldAlignment(QTextStream::AlignRight);
-    dcNameStream.setPadChar('0');
-    dcNameStream << bound.Row;
-    dcNameStream.setFieldWidth(0);
-    dcNameStream << "c";
-    dcNameStream.setFieldWidth(charPaddingCount);
-    dcNameStream << bound.Col;
-
-    // The DataContainer with a name based on the ROW & COLUMN indices is already created in the preflight
-    DataContainer::Pointer dc = dca->getDataContainer(dcName);
-    // So is the Geometry
-    ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
-
-    // Create the Image Geometry
-    SizeVec3Type dims = image->getDimensions();
-    // FloatVec3Type origin = image->getOrigin();
-    // FloatVec3Type spacing = image->getSpacing();
-
-    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
-    // The Cell AttributeMatrix is also already created at this point
-    AttributeMatrix::Pointer cellAttrMat = dc->getAttributeMatrix(getCellAttributeMatrixName());
-    // Instantiate the Image Import Filter to actually read the image into a data array
-    DataArrayPath dap(::k_DCName, ITKImageProcessing::Montage::k_AMName, getImageDataArrayName()); // This is just a temp path for the subfilter to use
-    AbstractFilter::Pointer imageImportFilter = MontageImportHelper::CreateImageImportFilter(this, bound.Filename, dap);
-    if(nullptr == imageImportFilter.get())
-    {
-      continue;
-    }
-    // This same filter was used to preflight so as long as nothing changes on disk this really should work....
-    imageImportFilter->execute();
-    if(imageImportFilter->getErrorCode() < 0)
-    {
-      setErrorCondition(imageImportFilter->getErrorCode(), "Error Executing Image Import Filter.");
-      continue;
-    }
-    // Now transfer the image data from the actual image data read from disk into our existing Attribute Matrix
-    DataContainerArray::Pointer importImageDca = imageImportFilter->getDataContainerArray();
-    DataContainer::Pointer fromDc = importImageDca->getDataContainer(::k_DCName);
-    AttributeMatrix::Pointer fromCellAttrMat = fromDc->getAttributeMatrix(ITKImageProcessing::Montage::k_AMName);
-    // IDataArray::Pointer fromImageData = fromCellAttrMat->getAttributeArray(getImageDataArrayName());
+    QString dcName = MontageImportHelper::GenerateDataContainerName(getDataContainerPath().getDataContainerName(), charPaddingCount, bound.Row, bound.Col);
 
-    if(getConvertToGrayScale())
-    {
-      AbstractFilter::Pointer grayScaleFilter = MontageImportHelper::CreateColorToGrayScaleFilter(this, dap, getColorWeights(), ITKImageProcessing::Montage::k_GrayScaleTempArrayName);
-      grayScaleFilter->setDataContainerArray(importImageDca); // Use the Data COntainer array that was use for the import. It is setup and ready to go
-      connect(grayScaleFilter.get(), SIGNAL(messageGenerated(AbstractMessage::Pointer)), this, SIGNAL(messageGenerated(AbstractMessage::Pointer)));
-      grayScaleFilter->execute();
-      if(grayScaleFilter->getErrorCode() < 0)
-      {
-        setErrorCondition(grayScaleFilter->getErrorCode(), "Error Executing Color to GrayScale filter");
-        continue;
-      }
-
-      DataContainerArray::Pointer c2gDca = grayScaleFilter->getDataContainerArray();
-      DataContainer::Pointer c2gDc = c2gDca->getDataContainer(::k_DCName);
-      AttributeMatrix::Pointer c2gAttrMat = c2gDc->getAttributeMatrix(ITKImageProcessing::Montage::k_AMName);
-
-      QString grayScaleArrayName = ITKImageProcessing::Montage::k_GrayScaleTempArrayName + getImageDataArrayName();
-      // IDataArray::Pointer fromGrayScaleData = fromCellAttrMat->getAttributeArray(grayScaleArrayName);
-
-      IDataArray::Pointer rgbImageArray = c2gAttrMat->removeAttributeArray(ITKImageProcessing::Montage::k_AAName);
-      IDataArray::Pointer gray = c2gAttrMat->removeAttributeArray(grayScaleArrayName);
-      gray->setName(getImageDataArrayName());
-      cellAttrMat->addOrReplaceAttributeArray(gray);
-    }
-    else
-    {
-      // Copy the IDataArray (which contains the image data) from the temp data container array into our persistent data structure
-      IDataArray::Pointer gray = fromCellAttrMat->removeAttributeArray(getImageDataArrayName());
-      cellAttrMat->addOrReplaceAttributeArray(gray);
-    }
+    tiles.push_back({bound.Filename, dcName});
   }
+
+  // The tiles are decoded in parallel and attached to the DataContainers created in the preflight
+  MontageImportHelper::ImportTiles(this, tiles, getCellAttributeMatrixName(), getImageDataArrayName(), getConvertToGrayScale(), getColorWeights(), nullptr);
 }
 
 // -----------------------------------------------------------------------------
@@ -31,6 +31,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "DetermineStitching.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "itkImage.h"
 
 #include "SIMPLib/ITK/itkBridge.h"
@@ -195,3 +199,167 @@ std::vector<size_t> DetermineStitching::ReturnProperIndex(int InputMode, int xDi
 
   return newIndices;
 }
+
+namespace
+{
+// Weight of the nominal displacement that every image pair gets.  It keeps the system solvable when the
+// measurements of a pair are rejected without pulling on the measurements that are kept.
+constexpr double k_NominalWeight = 1.0E-3;
+// A measurement is an outlier when its residual is more than this many robust standard deviations...
+constexpr double k_OutlierScale = 3.0;
+// ...and more than this many pixels.
+constexpr double k_MinimumOutlierResidual = 2.0;
+constexpr size_t k_MaxRejectionPasses = 10;
+
+// -----------------------------------------------------------------------------
+// Solves the weighted graph Laplacian system for one axis with conjugate gradients.  Tile 0 is held at 0 so the
+// system is positive definite.  'positions' holds the starting guess and receives the solution.
+// -----------------------------------------------------------------------------
+void solveAxis(const std::vector<DetermineStitching::TileDisplacement>& displacements, const std::vector<double>& weights, const std::vector<double>& targets, std::vector<double>& positions)
+{
+  size_t numTiles = positions.size();
+  auto multiply = [&](const std::vector<double>& x, std::vector<double>& y) {
+    std::fill(y.begin(), y.end(), 0.0);
+    for(size_t e = 0; e < displacements.size(); e++)
+    {
+      double flow = weights[e] * (x[displacements[e].toTile] - x[displacements[e].fromTile]);
+      y[displacements[e].toTile] += flow;
+      y[displacements[e].fromTile] -= flow;
+    }
+    y[0] = 0.0;
+  };
+  auto dot = [](const std::vector<double>& a, const std::vector<double>& b) { return std::inner_product(a.begin(), a.end(), b.begin(), 0.0); };
+
+  std::vector<double> rhs(numTiles, 0.0);
+  for(size_t e = 0; e < displacements.size(); e++)
+  {
+    rhs[displacements[e].toTile] += weights[e] * targets[e];
+    rhs[displacements[e].fromTile] -= weights[e] * targets[e];
+  }
+  rhs[0] = 0.0;
+  positions[0] = 0.0;
+
+  std::vector<double> residual(numTiles);
+  std::vector<double> direction(numTiles);
+  std::vector<double> product(numTiles);
+  multiply(positions, product);
+  for(size_t t = 0; t < numTiles; t++)
+  {
+    residual[t] = rhs[t] - product[t];
+  }
+  direction = residual;
+
+  double tolerance = 1.0E-12 * std::max(dot(rhs, rhs), 1.0);
+  double residualNorm = dot(residual, residual);
+  for(size_t iteration = 0; iteration < 10 * numTiles && residualNorm > tolerance; iteration++)
+  {
+    multiply(direction, product);
+    double alpha = residualNorm / dot(direction, product);
+    for(size_t t = 0; t < numTiles; t++)
+    {
+      positions[t] += alpha * direction[t];
+      residual[t] -= alpha * product[t];
+    }
+    double newResidualNorm = dot(residual, residual);
+    double beta = newResidualNorm / residualNorm;
+    residualNorm = newResidualNorm;
+    for(size_t t = 0; t < numTiles; t++)
+    {
+      direction[t] = residual[t] + beta * direction[t];
+    }
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<float> DetermineStitching::SolveGlobalPositions(size_t numTiles, const std::vector<TileDisplacement>& displacements, float minimumConfidence, size_t& rejectedCount)
+{
+  std::vector<double> xPositions(numTiles, 0.0);
+  std::vector<double> yPositions(numTiles, 0.0);
+
+  std::vector<bool> confident(displacements.size());
+  for(size_t e = 0; e < displacements.size(); e++)
+  {
+    confident[e] = displacements[e].confidence >= minimumConfidence;
+  }
+  std::vector<bool> accepted = confident;
+
+  std::vector<double> weights(displacements.size());
+  std::vector<double> xTargets(displacements.size());
+  std::vector<double> yTargets(displacements.size());
+  for(size_t pass = 0; pass < k_MaxRejectionPasses; pass++)
+  {
+    // The measured and nominal displacements of a pair constrain the same difference of positions, so they
+    // combine into one equation whose target is their weighted mean
+    for(size_t e = 0; e < displacements.size(); e++)
+    {
+      const TileDisplacement& displacement = displacements[e];
+      double measuredWeight = accepted[e] ? std::max(static_cast<double>(displacement.confidence), k_NominalWeight) : 0.0;
+      weights[e] = measuredWeight + k_NominalWeight;
+      xTargets[e] = (measuredWeight * displacement.dx + k_NominalWeight * displacement.nominalDx) / weights[e];
+      yTargets[e] = (measuredWeight * displacement.dy + k_NominalWeight * displacement.nominalDy) / weights[e];
+    }
+    solveAxis(displacements, weights, xTargets, xPositions);
+    solveAxis(displacements, weights, yTargets, yPositions);
+    if(pass + 1 == k_MaxRejectionPasses)
+    {
+      break;
+    }
+
+    // Reject the measurements that disagree with the solution much more than the typical accepted measurement does.
+    // A large outlier distorts the solution around it, so only the worst measurement around each tile is rejected in a
+    // pass, and measurements rejected in an earlier pass are accepted again once they agree with the new solution.
+    std::vector<double> residuals(displacements.size(), 0.0);
+    std::vector<double> worstResiduals(numTiles, 0.0);
+    std::vector<double> acceptedResiduals;
+    for(size_t e = 0; e < displacements.size(); e++)
+    {
+      const TileDisplacement& displacement = displacements[e];
+      double rx = xPositions[displacement.toTile] - xPositions[displacement.fromTile] - displacement.dx;
+      double ry = yPositions[displacement.toTile] - yPositions[displacement.fromTile] - displacement.dy;
+      residuals[e] = std::sqrt(rx * rx + ry * ry);
+      if(accepted[e])
+      {
+        acceptedResiduals.push_back(residuals[e]);
+        worstResiduals[displacement.fromTile] = std::max(worstResiduals[displacement.fromTile], residuals[e]);
+        worstResiduals[displacement.toTile] = std::max(worstResiduals[displacement.toTile], residuals[e]);
+      }
+    }
+    if(acceptedResiduals.empty())
+    {
+      break;
+    }
+    auto middle = acceptedResiduals.begin() + acceptedResiduals.size() / 2;
+    std::nth_element(acceptedResiduals.begin(), middle, acceptedResiduals.end());
+    double limit = std::max(k_OutlierScale * 1.4826 * (*middle), k_MinimumOutlierResidual);
+
+    bool changed = false;
+    for(size_t e = 0; e < displacements.size(); e++)
+    {
+      bool accept = confident[e] && residuals[e] <= limit;
+      if(accepted[e] && !accept && confident[e])
+      {
+        const TileDisplacement& displacement = displacements[e];
+        accept = residuals[e] < worstResiduals[displacement.fromTile] || residuals[e] < worstResiduals[displacement.toTile];
+      }
+      changed = changed || accept != accepted[e];
+      accepted[e] = accept;
+    }
+    if(!changed)
+    {
+      break;
+    }
+  }
+
+  rejectedCount = std::count(accepted.begin(), accepted.end(), false);
+
+  std::vector<float> positions(2 * numTiles);
+  for(size_t t = 0; t < numTiles; t++)
+  {
+    positions[2 * t] = static_cast<float>(xPositions[t]);
+    positions[2 * t + 1] = static_cast<float>(yPositions[t]);
+  }
+  return positions;
+}
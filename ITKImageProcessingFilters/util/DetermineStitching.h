@@ -40,6 +40,7 @@
 #endif
 #endif
 
+#include <algorithm>
 #include <vector>
 
 #include <QtCore/QDir>
@@ -52,12 +53,12 @@
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/ITK/itkBridge.h"
 #include "SIMPLib/ITK/itkSupportConstants.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
-#include "itkChangeInformationImageFilter.h"
 #include "itkImageFileWriter.h"
+#include "itkImage.h"
 #include "itkMaskedFFTNormalizedCorrelationImageFilter.h"
 #include "itkMinimumMaximumImageCalculator.h"
-#include "itkRegionOfInterestImageFilter.h"
 
 #define WRITE_DEBUG_IMAGES 0
 
@@ -69,12 +70,41 @@ class DetermineStitching
 public:
   virtual ~DetermineStitching();
 
+  /**
+   * @brief The TileDisplacement struct holds the offset of one image from a neighbor as measured by cross correlation,
+   * the offset the rough overlap predicts and the maximum correlation value of the measurement.
+   */
+  struct TileDisplacement
+  {
+    size_t fromTile = 0;
+    size_t toTile = 0;
+    float dx = 0.0f;
+    float dy = 0.0f;
+    float nominalDx = 0.0f;
+    float nominalDy = 0.0f;
+    float confidence = 0.0f;
+  };
+
+  /**
+   * @brief SolveGlobalPositions Places all the tiles at once by solving the weighted least squares system formed by the
+   * displacements, with tile 0 at the origin.  Each measurement is weighted by its confidence.  Measurements below the
+   * minimum confidence and measurements that disagree with the solution much more than the others are rejected, and
+   * the pairs they belong to fall back to their nominal displacement.
+   * @param numTiles
+   * @param displacements
+   * @param minimumConfidence
+   * @param rejectedCount Receives the number of rejected measurements
+   * @return The X and Y position of each tile
+   */
+  static std::vector<float> SolveGlobalPositions(size_t numTiles, const std::vector<TileDisplacement>& displacements, float minimumConfidence, size_t& rejectedCount);
+
   /**
    * @brief FindGlobalOrigins
    * @param xTileCount
    * @param yTileCount
    * @param ImportMode
    * @param overlapPer
+   * @param minimumConfidence
    * @param dataArrayList
    * @param udims
    * @param sampleOrigin
@@ -82,13 +112,10 @@ public:
    * @return
    */
   template <typename T, unsigned int ImageDimension>
-  static FloatArrayType::Pointer FindGlobalOrigins(AbstractFilter* filter, int xTileCount, int yTileCount, int importMode, float overlapPer,
+  static FloatArrayType::Pointer FindGlobalOrigins(AbstractFilter* filter, int xTileCount, int yTileCount, int importMode, float overlapPer, float minimumConfidence,
                                                    const std::vector<typename DataArray<T>::Pointer>& dataArrayList, const SizeVec3Type& udims, const FloatVec3Type& sampleOrigin,
                                                    const FloatVec3Type& spacing, const std::vector<QString>& dataContainerNames)
   {
-    // The assumption is that we are working on a 2D image where the XY dims are in the 0 and 1 index of the udims variable
-    size_t totalPoints = udims[0] * udims[1];
-
     std::vector<size_t> cDims(1, 2); // a dimension for the xvalues and one for the y values
     std::vector<size_t> tDims(1);
 
@@ -98,226 +125,133 @@ public:
     FloatArrayType::Pointer xyStitchedGlobalListPtr = FloatArrayType::CreateArray(tDims, cDims, "xyGlobalList", true);
     FloatArrayType::Pointer xyStitchedGlobalListPtr_orig = FloatArrayType::CreateArray(tDims, cDims, "xyGlobalList_orig", true);
 
-    int32_t numXtiles = xTileCount;
+    size_t numXtiles = static_cast<size_t>(xTileCount);
 
     // Make sure the combIndexList is large enough to store every value
     std::vector<size_t> combIndexList(numTiles);
 
     combIndexList = ReturnProperIndex(importMode, xTileCount, yTileCount);
 
-    using PixelType = T;
-    using ImageType = itk::Image<PixelType, ImageDimension>;
-    using ImportFilterType = itk::ImportImageFilter<PixelType, ImageDimension>;
-
-    ImageType* currentImage = nullptr;
-    ImageType* leftImage = nullptr;
-    ImageType* aboveImage = nullptr;
-
-    typename ImportFilterType::Pointer importFilter;
-    typename ImportFilterType::Pointer importFilter2;
-
-    std::vector<float> cropSpecsIm1Im2(12, 0);
-    std::vector<float> newXYOrigin(2, 0);
-    std::vector<float> newXYOrigin2(2, 0);
-
-    // set the stitched global coordinates of the first tile to the top left corner
-    xyStitchedGlobalListPtr->setValue(0, 0);
-    xyStitchedGlobalListPtr->setValue(1, 0);
-    xyStitchedGlobalListPtr_orig->setValue(0, 0);
-    xyStitchedGlobalListPtr_orig->setValue(1, 0);
-
-    // helper variables to store previous stitched global values
-    float previousXleft = 0;
-    float previousYleft = 0;
-
-    float previousXtop = 0;
-    float previousYtop = 0;
-
-    float newXfromleft = 0;
-    float newYfromleft = 0;
-
-    float newXfromtop = 0;
-    float newYfromtop = 0;
-
-    using ItkBridgeType = ItkBridge<T>;
-
     // IMPORTANT:
     // This method is set up a bit weird so hopefully this will help
     // cropSpecIm1Im2 is a rather important variable so it's good to understand what each value means
     // The first 6 values in the array are the crop origin that we'll be looking at (starts at the top left)
     // The last 6 values in the array are the crop dimensions (size) that we'll look at (goes down to bottom right)
-    // The CropAndCrossCorrelate method crops the images and compares them with each other looking for a spike in similar values (a simplified explanation)
-    // The loop compares 2 images at once, so if you have a 3 x 3 image, the loop will only go through 8 times. You'll compare the second image with the first image
-    //		first thing so the first if statement will only trigger twice before triggering the second if statement
-
+    // The first 3 values of each half describe the window of the fixed (left or top) image and the last 3 the window of the current image
+    // The strips cut out with these windows are cross correlated looking for a spike in similar values (a simplified explanation)
+    // Every image is compared with the image to its left and/or the image above it, so a 3 x 3 montage has 12 pairs of images to compare.
+    std::vector<float> leftCropSpecs(12, 0);
+    leftCropSpecs[0] =
+        udims[0] - (udims[0] * (overlapPer / 100)); // Width of the image * the percentage (say 20%) = the size of the crop we're looking at. Subtract that from the width of the image and you have the origin
+    leftCropSpecs[6] = udims[0] * (overlapPer / 100); // left image X Size
+    leftCropSpecs[7] = udims[1];                      // left image Y Size
+    leftCropSpecs[8] = 1;                             // left image Z Size
+    leftCropSpecs[9] = udims[0] * (overlapPer / 100); // current image X Size
+    leftCropSpecs[10] = udims[1];                     // current image Y Size
+    leftCropSpecs[11] = 1;                            // current image Z Size
+
+    std::vector<float> topCropSpecs(12, 0);
+    topCropSpecs[1] = udims[1] - (udims[1] * (overlapPer / 100)); // top image Y Origin
+    topCropSpecs[6] = udims[0];                                   // top image X Size
+    topCropSpecs[7] = udims[1] * (overlapPer / 100);              // top image Y Size
+    topCropSpecs[8] = 1;                                          // top image Z Size
+    topCropSpecs[9] = udims[0];                                   // current image X Size
+    topCropSpecs[10] = udims[1] * (overlapPer / 100);             // current image Y Size
+    topCropSpecs[11] = 1;                                         // current image Z Size
+
+    // The first phase cross correlates every image with its left and top neighbors.  The pairs are independent so
+    // they run in parallel.
+    struct TilePair
+    {
+      size_t index = 0; // Position of the current image in comb order
+      size_t neighborIndex = 0;
+      bool left = true;
+      std::vector<float> newXYOrigin;
+    };
+    std::vector<TilePair> pairs;
     for(size_t i = 1; i < combIndexList.size(); i++)
     {
-      if(filter->getCancel())
-      {
-        break;
-      }
-
-      filter->notifyStatusMessage(QString("Refining Origin For Image %1").arg(i));
-      if(i < numXtiles) // if the image is in the top row of images, we need only the image to the left
+      if(i % numXtiles != 0) // everything but the left most column has an image to the left
       {
-#if WRITE_DEBUG_IMAGES
-        qDebug() << "LEFT: DataContainer: " << dataContainerNames[combIndexList[i]] << ", " << dataContainerNames[combIndexList[i - 1]];
-        qDebug() << "\t" << combIndexList[i] << "\t" << combIndexList[i - 1];
-#endif
-        importFilter = ItkBridgeType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i]]);
-        currentImage = importFilter->GetOutput();
-        importFilter2 = ItkBridgeType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i - 1]]);
-        leftImage = importFilter2->GetOutput();
-
-        // Determine the windows to be cross correlated depending on the rough overlap as found from the global coordinates
-        cropSpecsIm1Im2[0] =
-            udims[0] -
-            (udims[0] * (overlapPer / 100)); // Width of the image * the percentage (say 20%) = the size of the crop we're looking at. Subtract that from the width of the image and you have the origin
-        cropSpecsIm1Im2[1] = 0;              // left image Y Origin
-        cropSpecsIm1Im2[2] = 0;              // left image Z Origin
-        cropSpecsIm1Im2[3] = 0;              // current image X Origin
-        cropSpecsIm1Im2[4] = 0;              // current image Y Origin
-        cropSpecsIm1Im2[5] = 0;              // current image Z Origin
-
-        cropSpecsIm1Im2[6] = udims[0] * (overlapPer / 100); // left image X Size
-        cropSpecsIm1Im2[7] = udims[1];                      // left image Y Size
-        cropSpecsIm1Im2[8] = 1;                             // left image Z Size
-        cropSpecsIm1Im2[9] = udims[0] * (overlapPer / 100); // current image X Size
-        cropSpecsIm1Im2[10] = udims[1];                     // current image Y Size
-        cropSpecsIm1Im2[11] = 1;                            // current image Z Size
-
-        // Cross correlate the image windows and return the local shifts between the two images
-        newXYOrigin = CropAndCrossCorrelate(cropSpecsIm1Im2, currentImage, leftImage);
-
-        previousXleft = xyStitchedGlobalListPtr->getValue(2 * (i - 1));
-        previousYleft = xyStitchedGlobalListPtr->getValue(2 * (i - 1) + 1);
-
-        newXfromleft = previousXleft + cropSpecsIm1Im2[0] + newXYOrigin[0];
-        newYfromleft = previousYleft + newXYOrigin[1];
-
-        xyStitchedGlobalListPtr->setValue(2 * i, newXfromleft);
-        xyStitchedGlobalListPtr->setValue(2 * i + 1, newYfromleft);
+        pairs.push_back({i, i - 1, true, {}});
       }
-      else if(i % numXtiles == 0) // if the image is in the first (left most) column of images, we only need the top image
+      if(i >= numXtiles) // everything but the top row has an image above it
       {
-#if WRITE_DEBUG_IMAGES
-        qDebug() << "TOP: DataContainer: " << dataContainerNames[combIndexList[i]] << ", " << dataContainerNames[combIndexList[i - numXtiles]];
-        qDebug() << "\t" << combIndexList[i] << "\t" << combIndexList[i - numXtiles];
-#endif
-        importFilter = ItkBridgeType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i]]);
-        currentImage = importFilter->GetOutput();
-        importFilter2 = ItkBridgeType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i - numXtiles]]);
-        aboveImage = importFilter2->GetOutput();
-
-        // Determine the windows to be cross correlated depending on the rough overlap as found from the global coordinates
-        cropSpecsIm1Im2[0] = 0; // top image X Origin
-        cropSpecsIm1Im2[1] =
-            udims[1] - (udims[1] * (overlapPer / 100)); // yGlobCoordsList[combIndexList[i]] - xyStitchedGlobalListPtr->getValue(2*(i-numXtiles)+1) - yGlobCoordsList[0]; //top image Y Origin
-        cropSpecsIm1Im2[2] = 0;                         // top image Z Origin
-        cropSpecsIm1Im2[3] = 0;                         // current image X Origin
-        cropSpecsIm1Im2[4] = 0;                         // current image Y Origin
-        cropSpecsIm1Im2[5] = 0;                         // current image Z Origin
-
-        cropSpecsIm1Im2[6] = udims[0];                       // top image X Size
-        cropSpecsIm1Im2[7] = udims[1] * (overlapPer / 100);  // top image Y Size
-        cropSpecsIm1Im2[8] = 1;                              // top image Z Size
-        cropSpecsIm1Im2[9] = udims[0];                       // current image X Size
-        cropSpecsIm1Im2[10] = udims[1] * (overlapPer / 100); // current image Y Size
-        cropSpecsIm1Im2[11] = 1;                             // current image Z Size
-
-        // Cross correlate the image windows and return the local shifts between the two images
-        newXYOrigin = CropAndCrossCorrelate(cropSpecsIm1Im2, currentImage, aboveImage);
-
-        previousXtop = xyStitchedGlobalListPtr->getValue(2 * (i - numXtiles));
-        previousYtop = xyStitchedGlobalListPtr->getValue(2 * (i - numXtiles) + 1);
-
-        // Add the local shifts to the preivous global value to get the current stitched global shift
-        newXfromtop = previousXtop + newXYOrigin[0];
-        newYfromtop = previousYtop + newXYOrigin[1] + cropSpecsIm1Im2[1];
-
-        xyStitchedGlobalListPtr->setValue(2 * i, newXfromtop);
-        xyStitchedGlobalListPtr->setValue(2 * i + 1, newYfromtop);
+        pairs.push_back({i, i - numXtiles, false, {}});
       }
-      else // for all other images, we need to match to the top and the left
-      {
-#if WRITE_DEBUG_IMAGES
-        qDebug() << "TOP/LEFT: DataContainer: " << dataContainerNames[combIndexList[i]] << ", " << dataContainerNames[combIndexList[i - numXtiles]];
-        qDebug() << "\t" << combIndexList[i] << "\t" << combIndexList[i - numXtiles];
-#endif
-        /// TOP IMAGE FIRST
-        importFilter = ItkBridgeType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i]]);
-        currentImage = importFilter->GetOutput();
-        importFilter2 = ItkBridgeType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i - numXtiles]]);
-        aboveImage = importFilter2->GetOutput();
-
-        // Determine the windows to be cross correlated depending on the rough overlap as found from the global coordinates
-        cropSpecsIm1Im2[0] = 0; // top image X Origin
-        cropSpecsIm1Im2[1] =
-            udims[1] - (udims[1] * (overlapPer / 100)); // yGlobCoordsList[combIndexList[i]] - xyStitchedGlobalListPtr->getValue(2*(i-numXtiles)+1) - yGlobCoordsList[0]; //top image Y Origin
-        cropSpecsIm1Im2[2] = 0;                         // top image Z Origin
-        cropSpecsIm1Im2[3] = 0;                         // current image X Origin
-        cropSpecsIm1Im2[4] = 0;                         // current image Y Origin
-        cropSpecsIm1Im2[5] = 0;                         // current image Z Origin
-
-        cropSpecsIm1Im2[6] = udims[0];                       // top image X Size
-        cropSpecsIm1Im2[7] = udims[1] * (overlapPer / 100);  // top image Y Size
-        cropSpecsIm1Im2[8] = 1;                              // top image Z Size
-        cropSpecsIm1Im2[9] = udims[0];                       // current image X Size
-        cropSpecsIm1Im2[10] = udims[1] * (overlapPer / 100); // current image Y Size
-        cropSpecsIm1Im2[11] = 1;                             // current image Z Size
-
-        // Cross correlate the image windows and return the local shifts between the two images
-        newXYOrigin2 = CropAndCrossCorrelate(cropSpecsIm1Im2, currentImage, aboveImage);
-
-        previousXtop = xyStitchedGlobalListPtr->getValue(2 * (i - numXtiles));
-        previousYtop = xyStitchedGlobalListPtr->getValue(2 * (i - numXtiles) + 1);
-
-        // Add the local shifts to the preivous global value to get the current stitched global shift
-        newXfromtop = previousXtop + newXYOrigin2[0];
-        newYfromtop = previousYtop + newXYOrigin2[1] + cropSpecsIm1Im2[1];
+    }
 
+    // The overlap strips are extracted straight from the data arrays as float images when their pair is correlated,
+    // so only the strips of the pairs in flight are in memory.  The pairs run in batches and progress is reported
+    // from the calling thread between batches.
+    using StripImageType = itk::Image<float, ImageDimension>;
+    constexpr size_t k_PairsPerBatch = 64;
+    ParallelDataAlgorithm dataAlg;
+    for(size_t first = 0; first < pairs.size() && !filter->getCancel(); first += k_PairsPerBatch)
+    {
+      const size_t last = std::min(first + k_PairsPerBatch, pairs.size());
+      dataAlg.setRange(first, last);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        for(size_t p = range.min(); p < range.max(); p++)
+        {
+          if(filter->getCancel())
+          {
+            return;
+          }
+          TilePair& pair = pairs[p];
 #if WRITE_DEBUG_IMAGES
-        qDebug() << "TOP/LEFT: DataContainer: " << dataContainerNames[combIndexList[i]] << ", " << dataContainerNames[combIndexList[i - 1]];
-        qDebug() << "\t" << combIndexList[i] << "\t" << combIndexList[i - 1];
+          qDebug() << (pair.left ? "LEFT: DataContainer: " : "TOP: DataContainer: ") << dataContainerNames[combIndexList[pair.index]] << ", " << dataContainerNames[combIndexList[pair.neighborIndex]];
+          qDebug() << "\t" << combIndexList[pair.index] << "\t" << combIndexList[pair.neighborIndex];
 #endif
-        // BOTTOM IMAGE NEXT
-        importFilter = ITKUtilitiesType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i]]);
-        currentImage = importFilter->GetOutput();
-        importFilter2 = ITKUtilitiesType::template Dream3DtoITKImportFilterDataArray<PixelType>(totalPoints, udims, sampleOrigin, spacing, dataArrayList[combIndexList[i - 1]]);
-        leftImage = importFilter2->GetOutput();
-
-        cropSpecsIm1Im2[0] = udims[0] - (udims[0] * (overlapPer / 100)); // xGlobCoordsList[combIndexList[i]] - xyStitchedGlobalListPtr->getValue(2*(i-1)) - xGlobCoordsList[0]; //left image X Origin
-        cropSpecsIm1Im2[1] = 0;                                          // left image Y Origin
-        cropSpecsIm1Im2[2] = 0;                                          // left image Z Origin
-        cropSpecsIm1Im2[3] = 0;                                          // current image X Origin
-        cropSpecsIm1Im2[4] = 0;                                          // current image Y Origin
-        cropSpecsIm1Im2[5] = 0;                                          // current image Z Origin
-
-        cropSpecsIm1Im2[6] = udims[0] * (overlapPer / 100); // left image X Size
-        cropSpecsIm1Im2[7] = udims[1];                      // left image Y Size
-        cropSpecsIm1Im2[8] = 1;                             // left image Z Size
-        cropSpecsIm1Im2[9] = udims[0] * (overlapPer / 100); // current image X Size
-        cropSpecsIm1Im2[10] = udims[1];                     // current image Y Size
-        cropSpecsIm1Im2[11] = 1;                            // current image Z Size
-
-        // Cross correlate the image windows and return the local shifts between the two images
-        newXYOrigin = CropAndCrossCorrelate(cropSpecsIm1Im2, currentImage, leftImage);
-
-        previousXleft = xyStitchedGlobalListPtr->getValue(2 * (i - 1));
-        previousYleft = xyStitchedGlobalListPtr->getValue(2 * (i - 1) + 1);
-
-        // Add the local shifts to the preivous global value to get the current stitched global shift
-        newXfromleft = previousXleft + cropSpecsIm1Im2[0] + newXYOrigin[0];
-        newYfromleft = previousYleft + newXYOrigin[1];
-
-        // AVERAGE the two new locations
-        xyStitchedGlobalListPtr->setValue(2 * i, (newXfromtop + newXfromleft) / 2.0);
-        xyStitchedGlobalListPtr->setValue(2 * i + 1, (newYfromtop + newYfromleft) / 2.0);
+          // The fixed window is the right or bottom strip of the neighbor and the moving window the left or top strip
+          // of the current image
+          const std::vector<float>& cropSpecs = pair.left ? leftCropSpecs : topCropSpecs;
+          typename StripImageType::Pointer fixedStrip = ExtractStrip<T, ImageDimension>(dataArrayList[combIndexList[pair.neighborIndex]]->getPointer(0), udims, spacing, cropSpecs, 0);
+          typename StripImageType::Pointer movingStrip = ExtractStrip<T, ImageDimension>(dataArrayList[combIndexList[pair.index]]->getPointer(0), udims, spacing, cropSpecs, 3);
+
+          // Cross correlate the strips and return the local shifts between the two images
+          pair.newXYOrigin = CrossCorrelateWindows<float, ImageDimension>(fixedStrip, movingStrip);
+        }
+      });
+      if(!filter->getCancel())
+      {
+        filter->notifyStatusMessage(QString("Cross correlated %1 of %2 image pairs").arg(last).arg(pairs.size()));
       }
+    }
+    if(filter->getCancel())
+    {
+      return xyStitchedGlobalListPtr_orig;
+    }
+
+    // The second phase places every image at once from the measured offsets between neighbors.  Offsets are taken
+    // relative to the overlap windows, so a pair that cross correlates to no shift sits at its nominal overlap.
+    std::vector<TileDisplacement> displacements;
+    displacements.reserve(pairs.size());
+    for(const TilePair& pair : pairs)
+    {
+      TileDisplacement displacement;
+      displacement.fromTile = pair.neighborIndex;
+      displacement.toTile = pair.index;
+      displacement.nominalDx = pair.left ? leftCropSpecs[0] : 0.0f;
+      displacement.nominalDy = pair.left ? 0.0f : topCropSpecs[1];
+      displacement.dx = displacement.nominalDx + pair.newXYOrigin[0];
+      displacement.dy = displacement.nominalDy + pair.newXYOrigin[1];
+      displacement.confidence = pair.newXYOrigin[2];
+      displacements.push_back(displacement);
+    }
+
+    size_t rejectedCount = 0;
+    std::vector<float> positions = SolveGlobalPositions(combIndexList.size(), displacements, minimumConfidence, rejectedCount);
+    filter->notifyStatusMessage(QString("Placed %1 images using %2 of %3 image pairs").arg(combIndexList.size()).arg(displacements.size() - rejectedCount).arg(displacements.size()));
+
+    for(size_t i = 0; i < combIndexList.size(); i++)
+    {
+      xyStitchedGlobalListPtr->setValue(2 * i, positions[2 * i]);
+      xyStitchedGlobalListPtr->setValue(2 * i + 1, positions[2 * i + 1]);
 
       // Put the values found in from going in the comb order into another data array which represents the original order the images came in as
-      xyStitchedGlobalListPtr_orig->setValue(2 * combIndexList[i], xyStitchedGlobalListPtr->getValue(2 * i));
-      xyStitchedGlobalListPtr_orig->setValue(2 * combIndexList[i] + 1, xyStitchedGlobalListPtr->getValue(2 * i + 1));
+      xyStitchedGlobalListPtr_orig->setValue(2 * combIndexList[i], positions[2 * i]);
+      xyStitchedGlobalListPtr_orig->setValue(2 * combIndexList[i] + 1, positions[2 * i + 1]);
     }
 
     return xyStitchedGlobalListPtr_orig;
@@ -341,82 +275,74 @@ public:
   static std::vector<size_t> ReturnProperIndex(int InputMode, int xDims, int yDims);
 
   /**
-   * @brief CropAndCrossCorrelate
+   * @brief ExtractStrip Copies one overlap window of a tile into a new float image whose index and origin are zero,
+   * which is what the cross correlation filter expects of the windows.  The window origin is read from
+   * cropSpecsIm1Im2[indexOffset] and its size from cropSpecsIm1Im2[6 + indexOffset], so an offset of 0 extracts the
+   * fixed window and an offset of 3 the moving window.  The tile is only read, so several threads can extract strips
+   * from the same tile.
+   * @param tileData
+   * @param udims
+   * @param spacing
    * @param cropSpecsIm1Im2
-   * @param currentImage
-   * @param fixedImage
+   * @param indexOffset
    * @return
    */
-  // clang-format off
-  template<typename PixelType, unsigned int ImageDimension>
-  static std::vector<float> CropAndCrossCorrelate(std::vector<float> cropSpecsIm1Im2,
-                                              itk::Image<PixelType, ImageDimension>* currentImage,
-                                              itk::Image<PixelType, ImageDimension>* fixedImage)
+  template <typename PixelType, unsigned int ImageDimension>
+  static typename itk::Image<float, ImageDimension>::Pointer ExtractStrip(const PixelType* tileData, const SizeVec3Type& udims, const FloatVec3Type& spacing,
+                                                                         const std::vector<float>& cropSpecsIm1Im2, size_t indexOffset)
+  {
+    using StripImageType = itk::Image<float, ImageDimension>;
+
+    size_t index[3] = {0, 0, 0};
+    size_t size[3] = {1, 1, 1};
+    typename StripImageType::RegionType stripRegion;
+    typename StripImageType::SpacingType stripSpacing;
+    for(size_t d = 0; d < 3 && d < ImageDimension; d++)
+    {
+      index[d] = static_cast<size_t>(cropSpecsIm1Im2[indexOffset + d]);
+      size[d] = static_cast<size_t>(cropSpecsIm1Im2[6 + indexOffset + d]);
+      stripRegion.SetSize(d, size[d]);
+      stripSpacing[d] = spacing[d];
+    }
+
+    typename StripImageType::PointType origin;
+    origin.Fill(0);
+
+    typename StripImageType::Pointer strip = StripImageType::New();
+    strip->SetRegions(stripRegion);
+    strip->SetOrigin(origin);
+    strip->SetSpacing(stripSpacing);
+    strip->Allocate();
+
+    float* stripData = strip->GetBufferPointer();
+    for(size_t z = 0; z < size[2]; z++)
+    {
+      for(size_t y = 0; y < size[1]; y++)
+      {
+        const PixelType* row = tileData + ((index[2] + z) * udims[1] + index[1] + y) * udims[0] + index[0];
+        for(size_t x = 0; x < size[0]; x++)
+        {
+          *stripData++ = static_cast<float>(row[x]);
+        }
+      }
+    }
+    return strip;
+  }
+
+  /**
+   * @brief CrossCorrelateWindows Cross correlates two windows of the same size and returns the X and Y shift of the
+   * current window relative to the fixed window along with the maximum correlation value.
+   * @param fixedImageWindow
+   * @param currentImageWindow
+   * @return
+   */
+  template <typename PixelType, unsigned int ImageDimension>
+  static std::vector<float> CrossCorrelateWindows(itk::Image<PixelType, ImageDimension>* fixedImageWindow, itk::Image<PixelType, ImageDimension>* currentImageWindow)
   {
-    // clang-format on
     std::vector<float> newXYOrigin(3, 0);
     using ImageType = itk::Image<PixelType, ImageDimension>;
     using FloatImageType = itk::Image<float, ImageDimension>;
 
-    //////FIRST IMAGE CROP
-    ImageProcessingConstants::UInt8ImageType::RegionType cropRegion;
-
-    cropRegion.SetIndex(0, cropSpecsIm1Im2[0]);
-    cropRegion.SetIndex(1, cropSpecsIm1Im2[1]);
-    cropRegion.SetIndex(2, cropSpecsIm1Im2[2]);
-
-    cropRegion.SetSize(0, cropSpecsIm1Im2[6]);
-    cropRegion.SetSize(1, cropSpecsIm1Im2[7]);
-    cropRegion.SetSize(2, cropSpecsIm1Im2[8]);
-
-    // Extract window from first image
-    using exImFilterType = itk::RegionOfInterestImageFilter<ImageType, ImageType>;
-    typename exImFilterType::Pointer exImfilter = exImFilterType::New();
-    exImfilter->SetRegionOfInterest(cropRegion);
-    exImfilter->SetInput(fixedImage);
-    exImfilter->Update();
-    ImageType* fixedImageWindow = exImfilter->GetOutput();
-
-    /////////////////////SECOND IMAGE CROP
-    typename ImageType::RegionType cropRegion2;
-    cropRegion2.SetIndex(0, cropSpecsIm1Im2[3]);
-    cropRegion2.SetIndex(1, cropSpecsIm1Im2[4]);
-    cropRegion2.SetIndex(2, cropSpecsIm1Im2[5]);
-
-    cropRegion2.SetSize(0, cropSpecsIm1Im2[9]);
-    cropRegion2.SetSize(1, cropSpecsIm1Im2[10]);
-    cropRegion2.SetSize(2, cropSpecsIm1Im2[11]);
-
-    // Extract window from second image
-    typename exImFilterType::Pointer exImfilter2 = exImFilterType::New();
-    exImfilter2->SetRegionOfInterest(cropRegion2);
-    exImfilter2->SetInput(currentImage);
-    exImfilter2->Update();
-    ImageType* currentImageWindow = exImfilter2->GetOutput();
-
-    /// CHANGE THE ORIGIN OF THE IMAGES SO THEY MATCH - the cross correlation filter will not work unless this is done
-    using ChangeInfoFilterType = itk::ChangeInformationImageFilter<ImageType>;
-    typename ImageType::PointType origin = fixedImageWindow->GetOrigin();
-    origin[0] = 0;
-    origin[1] = 0;
-    origin[2] = 0;
-
-    // First the Fixed image
-    typename ChangeInfoFilterType::Pointer changeInfo = ChangeInfoFilterType::New();
-    changeInfo->SetInput(fixedImageWindow);
-    changeInfo->SetOutputOrigin(origin);
-    changeInfo->ChangeOriginOn();
-    changeInfo->UpdateOutputInformation();
-    ImageType* fixedImageWindow2 = changeInfo->GetOutput();
-
-    // Next the Current Image
-    typename ChangeInfoFilterType::Pointer changeInfo2 = ChangeInfoFilterType::New();
-    changeInfo2->SetInput(currentImageWindow);
-    changeInfo2->SetOutputOrigin(origin);
-    changeInfo2->ChangeOriginOn();
-    changeInfo2->UpdateOutputInformation();
-    ImageType* currentImageWindow2 = changeInfo2->GetOutput();
-
     /////WRITING THE IMAGES FOR TESTING
 #if WRITE_DEBUG_IMAGES
     using WriterType = itk::ImageFileWriter<ImageType>;
@@ -424,13 +350,13 @@ public:
     QString imagePath = QDir::homePath() + QDir::separator() + "Desktop" + QDir::separator() + "ImageWindow_Fixed.tif";
     typename WriterType::Pointer writer = WriterType::New();
     writer->SetFileName(imagePath.toLatin1().constData());
-    writer->SetInput(fixedImageWindow2);
+    writer->SetInput(fixedImageWindow);
     writer->Update();
 
     imagePath = QDir::homePath() + QDir::separator() + "Desktop" + QDir::separator() + "ImageWindow_Moving.tif";
     typename WriterType::Pointer writer2 = WriterType::New();
     writer2->SetFileName(imagePath.toLatin1().constData());
-    writer2->SetInput(currentImageWindow2);
+    writer2->SetInput(currentImageWindow);
     writer2->Update();
 #endif
 
@@ -438,11 +364,11 @@ public:
     // Note: It is much faster to cross correlate the extracted windows than to cross correlate the full windows with a mask applied
     using XCFilterType = itk::MaskedFFTNormalizedCorrelationImageFilter<ImageType, FloatImageType, ImageType>;
     typename XCFilterType::Pointer xCorrFilter = XCFilterType::New();
-    xCorrFilter->SetFixedImage(fixedImageWindow2);
-    xCorrFilter->SetMovingImage(currentImageWindow2);
+    xCorrFilter->SetFixedImage(fixedImageWindow);
+    xCorrFilter->SetMovingImage(currentImageWindow);
     xCorrFilter->SetRequiredFractionOfOverlappingPixels(0.5); // currently require that the windows overlap at least 50percent. Might want to make this a user controlled variable
     xCorrFilter->Update();
-    ImageProcessingConstants::FloatImageType* xcoutputImage = xCorrFilter->GetOutput();
+    FloatImageType* xcoutputImage = xCorrFilter->GetOutput();
 
     // Create and initialize the calculator
     using MinMaxCalculatorType = itk::MinimumMaximumImageCalculator<FloatImageType>;
@@ -450,15 +376,6 @@ public:
     calculator->SetImage(xcoutputImage);
     calculator->Compute();
 
-    //    // Return minimum of intensity
-    //    float minimumResult = calculator->GetMinimum();
-    //    std::cout << "The Minimum intensity value is : " << minimumResult << std::endl;
-    //    std::cout << "Its index position is : " << calculator->GetIndexOfMinimum() << std::endl;
-
-    //    float maximumResult = calculator->GetMaximum();
-    //    std::cout << "The Maximum intensity value is : " << maximumResult << std::endl;
-    //    std::cout << "Its index position is : " << calculator->GetIndexOfMaximum() << std::endl;
-    //    std::cout << "Real Max" << xcoutputImage->GetPixel(calculator->GetIndexOfMaximum()) << std::endl;
     if(calculator->GetMinimum() == calculator->GetMaximum())
     {
       newXYOrigin[0] = 0.0f;
@@ -466,15 +383,14 @@ public:
     }
     else
     {
-      newXYOrigin[0] = float(calculator->GetIndexOfMaximum()[0]) - float(fixedImageWindow2->GetLargestPossibleRegion().GetSize()[0]);
-      newXYOrigin[1] = float(calculator->GetIndexOfMaximum()[1]) - float(fixedImageWindow2->GetLargestPossibleRegion().GetSize()[1]);
+      newXYOrigin[0] = float(calculator->GetIndexOfMaximum()[0]) - float(fixedImageWindow->GetLargestPossibleRegion().GetSize()[0]);
+      newXYOrigin[1] = float(calculator->GetIndexOfMaximum()[1]) - float(fixedImageWindow->GetLargestPossibleRegion().GetSize()[1]);
     }
     newXYOrigin[2] = calculator->GetMaximum(); // add this for when more than one image pair has to be xcorrelated - want ot use this value to find best fit location
 
-    // xcoutputImage->SetPixel(calculator->GetIndexOfMaximum(), 0); //just testing to make the brightest pixel dark so I could see which one it is
 #if WRITE_DEBUG_IMAGES
-    using nWriterType = itk::ImageFileWriter<ImageProcessingConstants::FloatImageType>;
-    nWriterType::Pointer writer3 = nWriterType::New();
+    using nWriterType = itk::ImageFileWriter<FloatImageType>;
+    typename nWriterType::Pointer writer3 = nWriterType::New();
     imagePath = QDir::homePath() + QDir::separator() + "Desktop" + QDir::separator() + "ImageWindow_CrossCorrelation.tif";
     writer3->SetFileName(imagePath.toLatin1().constData());
     writer3->SetInput(xcoutputImage);
@@ -15,6 +15,8 @@
 #include <vnl/vnl_least_squares_function.h>
 #include <vnl/vnl_math.h>
 
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
 #include "ITKImageProcessing/ITKImageProcessingFilters/CalcDewarpParameters.h"
 
 bool fft_amoeba::default_verbose = false;
@@ -27,6 +29,7 @@ fft_amoeba::fft_amoeba(vnl_cost_function& f)
   maxiter = f.get_number_of_unknowns() * 200;
   X_tolerance = 1e-8;
   F_tolerance = 1e-4;
+  parallel_evaluation = false;
   relative_diameter = 0.05;
   zero_term_delta = 0.00025;
 }
@@ -69,10 +72,34 @@ struct fft_amoebaFit : public fft_amoeba
   }
   void set_corner_a_plus_bl(fft_amoeba_SimplexCorner* s, const vnl_vector<double>& vbar, const vnl_vector<double>& v, double lambda)
   {
-    s->v = (1 - lambda) * vbar + lambda * v;
+    set_point_a_plus_bl(s, vbar, v, lambda);
     s->fv = f(s->v);
     cnt++;
   }
+
+  //: Set the position of the corner without evaluating it
+  void set_point_a_plus_bl(fft_amoeba_SimplexCorner* s, const vnl_vector<double>& vbar, const vnl_vector<double>& v, double lambda)
+  {
+    s->v = (1 - lambda) * vbar + lambda * v;
+  }
+
+  //: Evaluate the function at each corner, concurrently if parallel_evaluation is set
+  void evaluate_corners(const std::vector<fft_amoeba_SimplexCorner*>& corners)
+  {
+    if(!parallel_evaluation || corners.size() < 2)
+    {
+      for(fft_amoeba_SimplexCorner* corner : corners)
+        corner->fv = f(corner->v);
+      return;
+    }
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, corners.size());
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t i = range.min(); i < range.max(); i++)
+        corners[i]->fv = f(corners[i]->v);
+    });
+  }
 };
 
 int fft_amoeba_SimplexCorner::compare(fft_amoeba_SimplexCorner const& s1, fft_amoeba_SimplexCorner const& s2)
@@ -163,7 +190,6 @@ void fft_amoebaFit::set_up_simplex_relative(std::vector<fft_amoeba_SimplexCorner
   int n = x.size();
 
   simplex[0].v = x;
-  simplex[0].fv = f(x);
 
   // Following improvement suggested by L.Pfeffer at Stanford
   const double usual_delta = relative_diameter; // 5 percent deltas for non-zero terms
@@ -179,9 +205,12 @@ void fft_amoebaFit::set_up_simplex_relative(std::vector<fft_amoeba_SimplexCorner
       s->v[j] = (1 + usual_delta) * s->v[j];
     else
       s->v[j] = zero_term_delta;
-
-    s->fv = f(s->v);
   }
+
+  std::vector<fft_amoeba_SimplexCorner*> corners;
+  for(auto& corner : simplex)
+    corners.push_back(&corner);
+  evaluate_corners(corners);
 }
 
 //: Initialise the simplex given one corner, x and displacements of others
@@ -190,7 +219,6 @@ void fft_amoebaFit::set_up_simplex_absolute(std::vector<fft_amoeba_SimplexCorner
   int n = x.size();
 
   simplex[0].v = x;
-  simplex[0].fv = f(x);
 
   for(int j = 0; j < n; ++j)
   {
@@ -199,9 +227,12 @@ void fft_amoebaFit::set_up_simplex_absolute(std::vector<fft_amoeba_SimplexCorner
 
     // perturb s->v(j)
     s->v[j] = s->v[j] + dx[j];
-
-    s->fv = f(s->v);
   }
+
+  std::vector<fft_amoeba_SimplexCorner*> corners;
+  for(auto& corner : simplex)
+    corners.push_back(&corner);
+  evaluate_corners(corners);
 }
 
 //: FMINS Minimize a function of several variables.
@@ -269,6 +300,7 @@ void fft_amoebaFit::amoeba(vnl_vector<double>& x, std::vector<fft_amoeba_Simplex
   fft_amoeba_SimplexCorner reflect(n);
   fft_amoeba_SimplexCorner expand(n);
   fft_amoeba_SimplexCorner contract(n);
+  fft_amoeba_SimplexCorner contract_outside(n);
   fft_amoeba_SimplexCorner shrink(n);
   fft_amoeba_SimplexCorner* next;
 
@@ -288,7 +320,21 @@ void fft_amoebaFit::amoeba(vnl_vector<double>& x, std::vector<fft_amoeba_Simplex
       vbar[k] /= n;
     }
 
-    set_corner_a_plus_bl(&reflect, vbar, simplex[n].v, -1);
+    if(parallel_evaluation)
+    {
+      // Evaluate every candidate the step might need at once.  Only the evaluations
+      // the serial search would have made are counted below.
+      set_point_a_plus_bl(&reflect, vbar, simplex[n].v, -1);
+      set_point_a_plus_bl(&expand, vbar, reflect.v, 2);
+      set_point_a_plus_bl(&contract_outside, vbar, reflect.v, 0.5);
+      set_point_a_plus_bl(&contract, vbar, simplex[n].v, 0.5);
+      evaluate_corners({&reflect, &expand, &contract_outside, &contract});
+      cnt++;
+    }
+    else
+    {
+      set_corner_a_plus_bl(&reflect, vbar, simplex[n].v, -1);
+    }
 
     next = &reflect;
     const char* how = "reflect ";
@@ -298,7 +344,10 @@ void fft_amoebaFit::amoeba(vnl_vector<double>& x, std::vector<fft_amoeba_Simplex
       if(reflect.fv < simplex[0].fv)
       {
         // Reflection actually the best, try expanding
-        set_corner_a_plus_bl(&expand, vbar, reflect.v, 2);
+        if(parallel_evaluation)
+          cnt++;
+        else
+          set_corner_a_plus_bl(&expand, vbar, reflect.v, 2);
 
         if(expand.fv < simplex[0].fv)
         {
@@ -315,7 +364,14 @@ void fft_amoebaFit::amoeba(vnl_vector<double>& x, std::vector<fft_amoeba_Simplex
         if(reflect.fv < tmp->fv)
           // replace simplex[n] by reflection as at least it's better than that
           tmp = &reflect;
-        set_corner_a_plus_bl(&contract, vbar, tmp->v, 0.5);
+        if(parallel_evaluation)
+        {
+          if(tmp == &reflect)
+            contract = contract_outside;
+          cnt++;
+        }
+        else
+          set_corner_a_plus_bl(&contract, vbar, tmp->v, 0.5);
       }
 
       if(contract.fv < simplex[0].fv)
@@ -327,10 +383,16 @@ void fft_amoebaFit::amoeba(vnl_vector<double>& x, std::vector<fft_amoeba_Simplex
       else
       {
         // The contraction point was only average, shrink the entire simplex.
+        std::vector<fft_amoeba_SimplexCorner*> corners;
         for(int j = 1; j < n; ++j)
-
-          set_corner_a_plus_bl(&simplex[j], simplex[0].v, simplex[j].v, 0.5);
-        set_corner_a_plus_bl(&shrink, simplex[0].v, simplex[n].v, 0.5);
+        {
+          set_point_a_plus_bl(&simplex[j], simplex[0].v, simplex[j].v, 0.5);
+          corners.push_back(&simplex[j]);
+        }
+        set_point_a_plus_bl(&shrink, simplex[0].v, simplex[n].v, 0.5);
+        corners.push_back(&shrink);
+        evaluate_corners(corners);
+        cnt += n;
 
         next = &shrink;
         how = "shrink  ";
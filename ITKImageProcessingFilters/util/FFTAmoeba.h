@@ -52,6 +52,7 @@ public:
   int maxiter;
   double X_tolerance;
   double F_tolerance;
+  bool parallel_evaluation;
 
   //: Define maximum number of iterations to use
   void set_max_iterations(int n)
@@ -71,6 +72,17 @@ public:
     F_tolerance = tol;
   }
 
+  //: Evaluate the initial simplex, the candidate points of each step and
+  //  shrinks concurrently.  The reflection, expansion and both contractions
+  //  are evaluated together before choosing the step, so each step costs one
+  //  round of concurrent evaluations.  The path taken and the number of
+  //  evaluations counted against maxiter are the same as the serial search.
+  //  The cost function must be safe to call from several threads.
+  void set_parallel_evaluation(bool parallel)
+  {
+    parallel_evaluation = parallel;
+  }
+
   //: Define scaling used to select starting vertices relative to initial x0.
   //  I.e. the i'th vertex has x[i] = x0[i]*(1+relative_diameter)
   void set_relative_diameter(double r)
@@ -18,7 +18,59 @@
 
 #include "FFTAmoebaOptimizer.h"
 
+#include <algorithm>
+#include <random>
+
+#include <vnl/vnl_cost_function.h>
+
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
+
+namespace
+{
+/**
+ * @brief The ConcurrentCostFunction class adapts an itk::SingleValuedCostFunction for the vnl optimizer
+ * like itk::SingleValuedVnlCostFunctionAdaptor, but without caching the last value and position or
+ * reporting iteration events, so that it can be evaluated from several threads at once.
+ */
+class ConcurrentCostFunction : public vnl_cost_function
+{
+public:
+  using ParametersType = itk::SingleValuedCostFunction::ParametersType;
+  using ScalesType = itk::Optimizer::ScalesType;
+
+  ConcurrentCostFunction(const itk::SingleValuedCostFunction* costFunction, unsigned int numberOfParameters, bool negate, const ScalesType* scales)
+  : vnl_cost_function(numberOfParameters)
+  , m_CostFunction(costFunction)
+  , m_Negate(negate)
+  , m_UseScales(nullptr != scales)
+  {
+    if(m_UseScales)
+    {
+      m_Scales = *scales;
+    }
+  }
+
+  ~ConcurrentCostFunction() override = default;
+
+  double f(const vnl_vector<double>& x) override
+  {
+    ParametersType parameters(x.size());
+    for(unsigned int i = 0; i < x.size(); i++)
+    {
+      parameters[i] = m_UseScales ? x[i] / m_Scales[i] : x[i];
+    }
+    const double value = m_CostFunction->GetValue(parameters);
+    return m_Negate ? -value : value;
+  }
+
+private:
+  const itk::SingleValuedCostFunction* m_CostFunction;
+  bool m_Negate;
+  bool m_UseScales;
+  ScalesType m_Scales;
+};
+} // namespace
 
 namespace itk
 {
@@ -51,6 +103,8 @@ void FFTAmoebaOptimizer::PrintSelf(std::ostream& os, Indent indent) const
   os << indent << "FractionalTolerance: " << this->m_FractionalTolerance << std::endl;
   os << indent << "AutomaticInitialSimplex: " << (this->m_AutomaticInitialSimplex ? "On" : "Off") << std::endl;
   os << indent << "InitialSimplexDelta: " << this->m_InitialSimplexDelta << std::endl;
+  os << indent << "ParallelEvaluation: " << (this->m_ParallelEvaluation ? "On" : "Off") << std::endl;
+  os << indent << "NumberOfStarts: " << this->m_NumberOfStarts << std::endl;
 }
 
 FFTAmoebaOptimizer::MeasureType FFTAmoebaOptimizer::GetValue() const
@@ -135,25 +189,50 @@ void FFTAmoebaOptimizer::StartOptimization()
 
   // configure the vnl optimizer
   CostFunctionAdaptorType* adaptor = GetNonConstCostFunctionAdaptor();
-  // get rid of previous instance of the internal optimizer and create a
-  // new one
-  delete m_VnlOptimizer;
-  m_VnlOptimizer = new fft_amoeba(*adaptor);
-  m_VnlOptimizer->set_max_iterations(static_cast<int>(m_MaximumNumberOfIterations));
-  m_VnlOptimizer->set_f_tolerance(m_FractionalTolerance);
-
-  m_StopConditionDescription.str("");
-  m_StopConditionDescription << this->GetNameOfClass() << ": Running";
-
   if(GetMaximize())
   {
     adaptor->NegateCostFunctionOn();
   }
 
+  // The adaptor caches the last evaluation, so concurrent searches use their own adaptor
+  const bool concurrent = m_ParallelEvaluation || m_NumberOfStarts > 1;
+  m_ConcurrentCostFunction.reset();
+  if(concurrent)
+  {
+    m_ConcurrentCostFunction = std::make_unique<ConcurrentCostFunction>(adaptor->GetCostFunction(), n, GetMaximize(), m_ScalesInitialized ? &scales : nullptr);
+  }
+  vnl_cost_function& searchCostFunction = concurrent ? *m_ConcurrentCostFunction : static_cast<vnl_cost_function&>(*adaptor);
+
+  // get rid of previous instances of the internal optimizer and create new ones
+  delete m_VnlOptimizer;
+  m_VnlOptimizer = nullptr;
+  m_AdditionalOptimizers.clear();
+  std::vector<fft_amoeba*> optimizers;
+  for(unsigned int i = 0; i < m_NumberOfStarts; i++)
+  {
+    auto* optimizer = new fft_amoeba(searchCostFunction);
+    optimizer->set_max_iterations(static_cast<int>(m_MaximumNumberOfIterations));
+    optimizer->set_f_tolerance(m_FractionalTolerance);
+    optimizer->set_parallel_evaluation(m_ParallelEvaluation);
+    if(i == 0)
+    {
+      // Only the first search reports its progress
+      optimizer->set_filter(GetSIMPLFilter());
+      m_VnlOptimizer = optimizer;
+    }
+    else
+    {
+      m_AdditionalOptimizers.emplace_back(optimizer);
+    }
+    optimizers.push_back(optimizer);
+  }
+
+  m_StopConditionDescription.str("");
+  m_StopConditionDescription << this->GetNameOfClass() << ": Running";
+
   this->SetCurrentPosition(initialPosition);
 
   ParametersType parameters(initialPosition);
-  ParametersType bestPosition(initialPosition);
 
   // If the user provides the scales then we set otherwise we don't
   // for computation speed.
@@ -192,26 +271,96 @@ void FFTAmoebaOptimizer::StartOptimization()
     delta = automaticDelta;
   }
 
-  this->m_VnlOptimizer->set_filter(GetSIMPLFilter());
+  // The additional searches start at random points within one simplex delta of the initial
+  // position.  The generator is seeded with the start index so that runs are repeatable.
+  std::vector<ParametersType> startPositions(m_NumberOfStarts, parameters);
+  for(unsigned int start = 1; start < m_NumberOfStarts; start++)
+  {
+    std::mt19937_64 generator(start);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    for(unsigned int i = 0; i < n; i++)
+    {
+      startPositions[start][i] += distribution(generator) * delta[i];
+    }
+  }
 
-  this->m_VnlOptimizer->minimize(parameters, delta);
-  bestPosition = parameters;
-  double bestValue = adaptor->f(bestPosition);
+  std::vector<StartResult> results(m_NumberOfStarts);
+  if(m_NumberOfStarts == 1)
+  {
+    results[0] = RunStart(0, *m_VnlOptimizer, searchCostFunction, startPositions[0], delta);
+  }
+  else
+  {
+    ParallelTaskAlgorithm taskAlg;
+    for(unsigned int start = 0; start < m_NumberOfStarts; start++)
+    {
+      taskAlg.execute([&, start]() { results[start] = RunStart(start, *optimizers[start], searchCostFunction, startPositions[start], delta); });
+    }
+    taskAlg.wait();
+  }
+
+  // this comparison is valid both for min and max because the
+  // cost function always returns the value corresponding to minimization
+  auto bestResult = std::min_element(results.begin(), results.end(), [](const StartResult& a, const StartResult& b) { return a.value < b.value; });
+  ParametersType bestPosition = bestResult->position;
+  const int bestEvaluations = bestResult->evaluations;
+
+  // get the results, we scale the parameters down if scales are defined
+  if(m_ScalesInitialized)
+  {
+    const ScalesType& invScales = this->GetInverseScales();
+    for(unsigned int i = 0; i < n; ++i)
+    {
+      bestPosition[i] *= invScales[i];
+    }
+  }
+
+  this->SetCurrentPosition(bestPosition);
+
+  this->m_StopConditionDescription.str("");
+  this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
+  if(m_Cancel)
+  {
+    this->m_StopConditionDescription << "Operation cancelled after " << bestEvaluations << " iterations.";
+  }
+  else if(static_cast<unsigned int>(bestEvaluations) < this->m_MaximumNumberOfIterations)
+  {
+    this->m_StopConditionDescription << "Fractional tolerance (" << this->m_FractionalTolerance << ") has been met in " << bestEvaluations << " iterations.";
+  }
+  else
+  {
+    this->m_StopConditionDescription << "Maximum number of iterations exceeded."
+                                     << " Number of iterations is " << this->m_MaximumNumberOfIterations;
+  }
+  this->InvokeEvent(EndEvent());
+}
+
+FFTAmoebaOptimizer::StartResult FFTAmoebaOptimizer::RunStart(unsigned int startIndex, fft_amoeba& optimizer, vnl_cost_function& costFunction, const ParametersType& initialPosition, InternalParametersType delta)
+{
+  const auto n = static_cast<unsigned int>(initialPosition.Size());
+  ParametersType parameters(initialPosition);
+
+  optimizer.minimize(parameters, delta);
+  ParametersType bestPosition = parameters;
+  double bestValue = costFunction.f(bestPosition);
   // multiple restart heuristic
   if(this->m_OptimizeWithRestarts)
   {
+    // rand() is not thread safe and the searches run concurrently
+    std::mt19937 generator(startIndex);
+    std::bernoulli_distribution flipDirection(0.5);
     double currentValue;
-    auto totalEvaluations = static_cast<unsigned int>(m_VnlOptimizer->get_num_evaluations());
+    auto totalEvaluations = static_cast<unsigned int>(optimizer.get_num_evaluations());
     bool converged = false;
     unsigned int i = 1;
     while(!converged && (totalEvaluations < m_MaximumNumberOfIterations) && !m_Cancel)
     {
-      this->m_VnlOptimizer->set_max_iterations(static_cast<int>(this->m_MaximumNumberOfIterations - totalEvaluations));
+      optimizer.set_max_iterations(static_cast<int>(this->m_MaximumNumberOfIterations - totalEvaluations));
       parameters = bestPosition;
-      delta = delta * (1.0 / pow(2.0, static_cast<double>(i)) * (rand() > RAND_MAX / 2 ? 1 : -1));
-      m_VnlOptimizer->minimize(parameters, delta);
-      totalEvaluations += static_cast<unsigned int>(m_VnlOptimizer->get_num_evaluations());
-      currentValue = adaptor->f(parameters);
+      delta = delta * (1.0 / pow(2.0, static_cast<double>(i)) * (flipDirection(generator) ? 1 : -1));
+      optimizer.minimize(parameters, delta);
+      totalEvaluations += static_cast<unsigned int>(optimizer.get_num_evaluations());
+      currentValue = costFunction.f(parameters);
       // be consistent with the underlying vnl amoeba implementation
       double maxAbs = 0.0;
       for(unsigned j = 0; j < n; j++)
@@ -221,7 +370,7 @@ void FFTAmoebaOptimizer::StartOptimization()
           maxAbs = fabs(bestPosition[j] - parameters[j]);
         }
       }
-      converged = this->m_VnlOptimizer->get_fractional_range() < this->m_FractionalTolerance;
+      converged = optimizer.get_fractional_range() < this->m_FractionalTolerance;
 
       // this comparison is valid both for min and max because the
       // adaptor is set to always return the function value
@@ -234,40 +383,25 @@ void FFTAmoebaOptimizer::StartOptimization()
       i++;
     }
   }
-  // get the results, we scale the parameters down if scales are defined
-  if(m_ScalesInitialized)
-  {
-    const ScalesType& invScales = this->GetInverseScales();
-    for(unsigned int i = 0; i < n; ++i)
-    {
-      bestPosition[i] *= invScales[i];
-    }
-  }
 
-  this->SetCurrentPosition(bestPosition);
-
-  this->m_StopConditionDescription.str("");
-  this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
-  if(m_Cancel)
-  {
-    this->m_StopConditionDescription << "Operation cancelled after " << this->m_VnlOptimizer->get_num_evaluations() << " iterations.";
-  }
-  else if(static_cast<unsigned int>(this->m_VnlOptimizer->get_num_evaluations()) < this->m_MaximumNumberOfIterations)
-  {
-    this->m_StopConditionDescription << "Fractional tolerance (" << this->m_FractionalTolerance << ") has been met in " << this->m_VnlOptimizer->get_num_evaluations() << " iterations.";
-  }
-  else
-  {
-    this->m_StopConditionDescription << "Maximum number of iterations exceeded."
-                                     << " Number of iterations is " << this->m_MaximumNumberOfIterations;
-  }
-  this->InvokeEvent(EndEvent());
+  StartResult result;
+  result.position = bestPosition;
+  result.value = bestValue;
+  result.evaluations = optimizer.get_num_evaluations();
+  return result;
 }
 
 void FFTAmoebaOptimizer::Cancel()
 {
   m_Cancel = true;
-  m_VnlOptimizer->cancel();
+  if(m_VnlOptimizer != nullptr)
+  {
+    m_VnlOptimizer->cancel();
+  }
+  for(const auto& optimizer : m_AdditionalOptimizers)
+  {
+    optimizer->cancel();
+  }
 }
 
 void FFTAmoebaOptimizer::SetSIMPLFilter(AbstractFilter* filter)
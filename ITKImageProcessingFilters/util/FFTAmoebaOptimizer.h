@@ -31,6 +31,9 @@
 
 #include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
 
+#include <memory>
+#include <vector>
+
 #include "itkSingleValuedNonLinearVnlOptimizer.h"
 
 class AbstractFilter;
@@ -68,6 +71,12 @@ namespace itk
  * max(|best_parameters_i - current_parameters_i|) is less than a threshold
  * (SetParametersConvergenceTolerance).
  *
+ * The method SetParallelEvaluation() evaluates the corners of the initial
+ * simplex, the candidate points of each step and the corners of a shrink
+ * concurrently.  SetNumberOfStarts() runs several independent searches at the
+ * same time and keeps the best result.  Both require the cost function's
+ * GetValue to be safe to call from several threads.
+ *
  *
  * \ingroup Numerics Optimizers
  * \ingroup ITKOptimizers
@@ -138,6 +147,18 @@ public:
   itkBooleanMacro(OptimizeWithRestarts);
   itkGetConstMacro(OptimizeWithRestarts, bool);
 
+  /** Set/Get whether the simplex corners and step candidates are evaluated
+   * concurrently. The search follows the same path as the serial search. */
+  itkSetMacro(ParallelEvaluation, bool);
+  itkBooleanMacro(ParallelEvaluation);
+  itkGetConstMacro(ParallelEvaluation, bool);
+
+  /** Set/Get the number of independent searches run concurrently. The first
+   * search starts at the initial position and the others start at random
+   * points within one simplex delta of it. The best result is kept. */
+  itkSetClampMacro(NumberOfStarts, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfStarts, unsigned int);
+
   /** Set/Get the deltas that are used to define the initial simplex
    * when AutomaticInitialSimplex is off. */
   void SetInitialSimplexDelta(ParametersType initialSimplexDelta, bool automaticInitialSimplex = false);
@@ -174,15 +195,31 @@ protected:
   using CostFunctionAdaptorType = Superclass::CostFunctionAdaptorType;
 
 private:
+  /** Result of a single search */
+  struct StartResult
+  {
+    ParametersType position;
+    double value = 0.0;
+    int evaluations = 0;
+  };
+
   /**Check that the settings are valid. If not throw an exception.*/
   void ValidateSettings();
 
+  /** Runs one search, including the restart heuristic, from the given position.  The start index seeds the
+   * random directions of the restarts, so every search is repeatable and owns its generator. */
+  StartResult RunStart(unsigned int startIndex, fft_amoeba& optimizer, vnl_cost_function& costFunction, const ParametersType& initialPosition, InternalParametersType delta);
+
   NumberOfIterationsType m_MaximumNumberOfIterations;
   CostFunctionType::MeasureType m_FractionalTolerance;
   bool m_AutomaticInitialSimplex;
   ParametersType m_InitialSimplexDelta;
   bool m_OptimizeWithRestarts;
+  bool m_ParallelEvaluation = false;
+  unsigned int m_NumberOfStarts = 1;
   fft_amoeba* m_VnlOptimizer;
+  std::vector<std::unique_ptr<fft_amoeba>> m_AdditionalOptimizers;
+  std::unique_ptr<vnl_cost_function> m_ConcurrentCostFunction;
   bool m_Cancel = false;
   AbstractFilter* m_SIMPLFilter = nullptr;
 
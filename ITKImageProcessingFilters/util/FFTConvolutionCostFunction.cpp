@@ -34,10 +34,12 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 #include "itkExtractImageFilter.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include "tbb/enumerable_thread_specific.h"
 #include "tbb/queuing_mutex.h"
 
 using MutexType = tbb::queuing_mutex;
@@ -50,226 +52,70 @@ using ScopedLockType = int;
 
 #include "SIMPLib/Montages/GridMontage.h"
 #include "SIMPLib/Utilities/ParallelData2DAlgorithm.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
 
 #include "ITKImageProcessingFilters/util/FFTDewarpHelper.h"
+#include "ITKImageProcessingFilters/util/FFTImageOverlapGenerator.h"
+#include "ITKImageProcessingFilters/util/ITKPhaseTimer.h"
+
+namespace
+{
+// Overlaps in a grid share a handful of geometries (one per direction), so a thread rarely needs more
+constexpr size_t k_MaxScratchPerThread = 2;
+} // namespace
 
 /**
- * @class FFTConvolutionCostFunction FFTConvolutionCostFunction.h ITKImageProcessingFilters/util/FFTConvolutionCostFunction.h
- * @brief The FFTImageInitializer class is for running the FFTConvolutionCostFunction
- * in parallel on a target DataArray.
+ * @brief The OverlapScratch struct holds the pair of overlap images used to evaluate overlaps with
+ * the same region.  Reusing the images avoids reallocating them for every cost function evaluation.
  */
-class FFTImageInitializer
+template <typename TPixel>
+struct FFTConvolutionCostFunction<TPixel>::OverlapScratch
 {
-public:
-  static constexpr uint8_t IMAGE_DIMENSIONS = 2;
-  using PixelCoord = itk::Index<IMAGE_DIMENSIONS>;
-  using InputImage = itk::Image<PixelValue_T, IMAGE_DIMENSIONS>;
-  using DataArrayType = DataArray<Grayscale_T>;
-
-  /**
-   * @brief Constructor
-   * @param image
-   * @param width
-   * @param dataArray
-   */
-  FFTImageInitializer(const InputImage::Pointer& image, size_t width, const DataArrayType::Pointer& dataArray)
-  : m_Image(image)
-  , m_Width(width)
-  , m_DataArray(dataArray)
-  , m_Comps(dataArray->getNumberOfComponents())
-  {
-    auto index = image->GetRequestedRegion().GetIndex();
-    m_ImageIndex[0] = index[0];
-    m_ImageIndex[1] = index[1];
-  }
-
-  /**
-   * @brief Sets the image's pixel at the specified position based on the DataArray value.
-   * @param pxlWidthIds
-   * @param pxlHeightIdx
-   */
-  void setPixel(size_t pxlWidthIdx, size_t pxlHeightIdx) const
-  {
-    // Get the pixel index from the current pxlWidthIdx and pxlHeightIdx
-    size_t pxlIdx = ((pxlWidthIdx) + (pxlHeightIdx)*m_Width) * m_Comps;
-    PixelCoord idx;
-    idx[0] = pxlWidthIdx + m_ImageIndex[0];
-    idx[1] = pxlHeightIdx + m_ImageIndex[1];
-    m_Image->SetPixel(idx, m_DataArray->getValue(pxlIdx));
-  }
-
-  /**
-   * @brief Function operator to set the pixel value for items over a 2D range.
-   * @param range
-   */
-  void operator()(const SIMPLRange2D& range) const
-  {
-    for(size_t y = range.minRow(); y < range.maxRow(); y++)
-    {
-      for(size_t x = range.minCol(); x < range.maxCol(); x++)
-      {
-        setPixel(x, y);
-      }
-    }
-  }
-
-private:
-  InputImage::Pointer m_Image;
-  size_t m_Width;
-  // size_t m_Height;
-  PixelCoord m_ImageIndex;
-  DataArrayType::Pointer m_DataArray;
-  size_t m_Comps;
+  typename InputImage::RegionType region;
+  typename InputImage::Pointer firstImage;
+  typename InputImage::Pointer secondImage;
+  // Only accessed by the owning thread.  Set while the scratch is in use in case the
+  // thread picks up another overlap evaluation while waiting on nested work.
+  bool inUse = false;
 };
 
 /**
- * @brief The FFTImageOverlapGenerator class is used for generating itk::Images
- * for the specified overlap region from a given itk::Image, offsets, and
- * dewarp parameters.
+ * @brief The ScratchStorage class keeps at most k_MaxScratchPerThread OverlapScratch objects for each
+ * thread evaluating the cost function.
  */
-class FFTImageOverlapGenerator
+template <typename TPixel>
+class FFTConvolutionCostFunction<TPixel>::ScratchStorage
 {
-  static constexpr uint8_t IMAGE_DIMENSIONS = 2;
-  using PixelCoord = itk::Index<IMAGE_DIMENSIONS>;
-  using InputImage = itk::Image<PixelValue_T, IMAGE_DIMENSIONS>;
-  using ParametersType = itk::SingleValuedCostFunction::ParametersType;
-
 public:
-  /**
-   * @brief Constructor
-   * @param baseImg
-   * @param image
-   * @param offset
-   * @param imageDim_x
-   * @param imageDim_y
-   * @param parameters
-   */
-  FFTImageOverlapGenerator(const InputImage::Pointer& baseImg, const InputImage::Pointer& image, const PixelCoord& offset, size_t imageDim_x, size_t imageDim_y, const ParametersType& parameters,
-                           RegionBounds& regionBounds)
-  : m_BaseImg(baseImg)
-  , m_Image(image)
-  , m_Parameters(parameters)
-  , m_Bounds(regionBounds)
-  {
-    double x_trans = (imageDim_x - 1) / 2.0;
-    double y_trans = (imageDim_y - 1) / 2.0;
-    m_Offset = FFTDewarpHelper::pixelIndex(x_trans - offset[0], y_trans - offset[1]);
-  }
-
-  /**
-   * @brief Updates the RegionBounds based on the provided invalid index.
-   * @param index
-   */
-  void updateRegionBounds(const PixelCoord& index) const
-  {
-    static MutexType mutex;
-
-    auto origin = m_Image->GetOrigin();
-    auto size = m_Image->GetRequestedRegion().GetSize();
-
-    const int64_t distTop = index[1] - origin[1];
-    const int64_t distBot = origin[1] + size[1] - index[1];
-    const int64_t distLeft = index[0] - origin[0];
-    const int64_t distRight = origin[0] + size[0] - index[0];
-
-    ScopedLockType scopedLock(mutex);
-    if(distTop <= distBot && distTop <= distLeft && distTop <= distRight)
-    {
-      m_Bounds.topBound = std::max(m_Bounds.topBound, static_cast<int64_t>(index[1]));
-    }
-    else if(distBot <= distTop && distBot <= distLeft && distBot <= distRight)
-    {
-      m_Bounds.bottomBound = std::min(m_Bounds.bottomBound, static_cast<int64_t>(index[1]));
-    }
-    else if(distLeft <= distTop && distLeft <= distBot && distLeft <= distRight)
-    {
-      m_Bounds.leftBound = std::max(m_Bounds.leftBound, static_cast<int64_t>(index[0]));
-    }
-    else if(distRight <= distTop && distRight <= distBot && distRight <= distLeft)
-    {
-      m_Bounds.rightBound = std::min(m_Bounds.rightBound, static_cast<int64_t>(index[0]));
-    }
-  }
-
-  /**
-   * @brief Checks and returns if the base image contains the given PixelCoord.
-   * @param index
-   * @return
-   */
-  bool baseImageContainsIndex(const PixelCoord& index) const
-  {
-    const InputImage::RegionType baseRegion = m_BaseImg->GetRequestedRegion();
-    const PixelCoord baseIndex = baseRegion.GetIndex();
-    const auto baseSize = baseRegion.GetSize();
-
-    // Check edge cases for height / width
-    for(size_t i = 0; i < 2; i++)
-    {
-      if(index[i] < baseIndex[i])
-      {
-        return false;
-      }
-      if(index[i] >= baseIndex[i] + baseSize[i])
-      {
-        return false;
-      }
-    }
-
-    return true;
-  }
+  using ScratchVector = std::vector<std::unique_ptr<OverlapScratch>>;
 
   /**
-   * @brief Calculate the old pixel position from the given x and y values.
-   * @param x
-   * @param y
+   * @brief Returns the scratch objects owned by the calling thread.
    * @return
    */
-  PixelCoord calculateOldPixelIndex(size_t x, size_t y) const
-  {
-    FFTDewarpHelper::PixelIndex index = FFTDewarpHelper::pixelIndex(x, y);
-    FFTDewarpHelper::PixelIndex oldPixel = FFTDewarpHelper::getOldIndex(index, m_Offset, m_Parameters);
-    return PixelCoord{oldPixel[0], oldPixel[1]};
-  }
-
-  /**
-   * @brief Function operator to set the pixel value for items over a 2D range.
-   * @param range
-   */
-  void operator()(const SIMPLRange2D& range) const
+  ScratchVector& local()
   {
-    for(size_t y = range.minRow(); y < range.maxRow(); y++)
-    {
-      for(size_t x = range.minCol(); x < range.maxCol(); x++)
-      {
-        PixelCoord newIndex{static_cast<int64_t>(x), static_cast<int64_t>(y)};
-        PixelValue_T pixel{0};
-        const PixelCoord oldIndex = calculateOldPixelIndex(x, y);
-        if(baseImageContainsIndex(oldIndex))
-        {
-          pixel = m_BaseImg->GetPixel(oldIndex);
-        }
-        else
-        {
-          updateRegionBounds(newIndex);
-        }
-        m_Image->SetPixel(newIndex, pixel);
-      }
-    }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    return m_ThreadScratch.local();
+#else
+    return m_Scratch;
+#endif
   }
 
 private:
-  InputImage::Pointer m_BaseImg;
-  InputImage::Pointer m_Image;
-  FFTDewarpHelper::PixelIndex m_Offset;
-  ParametersType m_Parameters;
-  RegionBounds& m_Bounds;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::enumerable_thread_specific<ScratchVector> m_ThreadScratch;
+#else
+  ScratchVector m_Scratch;
+#endif
 };
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FFTConvolutionCostFunction::Initialize(const GridMontageShPtr& montage, const DataContainerArrayShPtr& dca, const QString& amName, const QString& daName)
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::Initialize(const GridMontageShPtr& montage, const DataContainerArrayShPtr& dca, const QString& amName, const QString& daName)
 {
   std::ignore = dca;
   m_Montage = montage;
@@ -287,7 +133,7 @@ void FFTConvolutionCostFunction::Initialize(const GridMontageShPtr& montage, con
   {
     for(size_t col = 0; col < numCols; col++)
     {
-      taskAlg.execute(std::bind(&FFTConvolutionCostFunction::initializeDataContainer, this, montage, row, col, amName, daName));
+      taskAlg.execute(std::bind(&FFTConvolutionCostFunction<TPixel>::initializeDataContainer, this, montage, row, col, amName, daName));
     }
   }
   taskAlg.wait();
@@ -299,12 +145,125 @@ void FFTConvolutionCostFunction::Initialize(const GridMontageShPtr& montage, con
   }
 
   m_Overlaps = createOverlapPairs(cropMap);
+  m_ScratchStorage = std::make_shared<ScratchStorage>();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::Pointer FFTConvolutionCostFunction<TPixel>::createDownsampled(size_t factor) const
+{
+  Pointer costFunction = Self::New();
+  costFunction->m_Montage = m_Montage;
+  costFunction->m_InterpolationType = m_InterpolationType;
+  costFunction->m_PhaseTimer = m_PhaseTimer;
+  costFunction->m_ImageDim_x = std::floor(m_ImageDim_x / factor);
+  costFunction->m_ImageDim_y = std::floor(m_ImageDim_y / factor);
+
+  std::vector<typename ImageGrid::value_type> images(m_ImageGrid.begin(), m_ImageGrid.end());
+  std::vector<typename InputImage::Pointer> downsampledImages(images.size());
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, images.size());
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      downsampledImages[i] = downsampleImage(images[i].second, factor);
+    }
+  });
+
+  CropMap cropMap;
+  for(size_t i = 0; i < images.size(); i++)
+  {
+    costFunction->m_ImageGrid[images[i].first] = downsampledImages[i];
+  }
+  for(const auto& image : costFunction->m_ImageGrid)
+  {
+    costFunction->precalcCropMap(image, cropMap);
+  }
+
+  costFunction->m_Overlaps = costFunction->createOverlapPairs(cropMap);
+  costFunction->m_ScratchStorage = std::make_shared<ScratchStorage>();
+  return costFunction;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::InputImage::Pointer FFTConvolutionCostFunction<TPixel>::downsampleImage(const typename InputImage::Pointer& image, size_t factor) const
+{
+  const typename InputImage::RegionType region = image->GetBufferedRegion();
+  const int64_t scale = static_cast<int64_t>(factor);
+
+  // Only blocks that lie completely inside of the tile are kept so that each pixel
+  // covers the same area of the montage as it does in the other tiles.
+  PixelCoord index;
+  typename InputImage::SizeType size;
+  for(size_t i = 0; i < IMAGE_DIMENSIONS; i++)
+  {
+    const int64_t start = (region.GetIndex()[i] + scale - 1) / scale;
+    const int64_t end = (region.GetIndex()[i] + static_cast<int64_t>(region.GetSize()[i])) / scale;
+    index[i] = start;
+    size[i] = static_cast<itk::SizeValueType>(std::max<int64_t>(end - start, 0));
+  }
+
+  typename InputImage::Pointer downsampled = InputImage::New();
+  downsampled->SetRegions(typename InputImage::RegionType(index, size));
+  downsampled->Allocate();
+
+  const TPixel* src = image->GetBufferPointer();
+  TPixel* dst = downsampled->GetBufferPointer();
+  const size_t srcWidth = region.GetSize()[0];
+  const size_t srcOffsetX = index[0] * scale - region.GetIndex()[0];
+  const size_t srcOffsetY = index[1] * scale - region.GetIndex()[1];
+  const double blockSize = static_cast<double>(factor * factor);
+
+  std::vector<double> rowSums(size[0]);
+  for(size_t y = 0; y < size[1]; y++)
+  {
+    std::fill(rowSums.begin(), rowSums.end(), 0.0);
+    for(size_t j = 0; j < factor; j++)
+    {
+      const TPixel* srcRow = src + (srcOffsetY + y * factor + j) * srcWidth + srcOffsetX;
+      for(size_t x = 0; x < size[0]; x++)
+      {
+        for(size_t i = 0; i < factor; i++)
+        {
+          rowSums[x] += srcRow[x * factor + i];
+        }
+      }
+    }
+    TPixel* dstRow = dst + y * size[0];
+    for(size_t x = 0; x < size[0]; x++)
+    {
+      dstRow[x] = FFTDewarpHelper::castInterpolatedValue<TPixel>(rowSums[x] / blockSize);
+    }
+  }
+
+  return downsampled;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FFTConvolutionCostFunction::calculateImageDim(const GridMontageShPtr& montage)
+template <typename TPixel>
+size_t FFTConvolutionCostFunction<TPixel>::getMinimumOverlapSize() const
+{
+  size_t minSize = std::numeric_limits<size_t>::max();
+  for(const auto& overlap : m_Overlaps)
+  {
+    const typename InputImage::SizeType size = overlap.second.GetSize();
+    minSize = std::min({minSize, static_cast<size_t>(size[0]), static_cast<size_t>(size[1])});
+  }
+  return m_Overlaps.empty() ? 0 : minSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::calculateImageDim(const GridMontageShPtr& montage)
 {
   size_t x = montage->getColumnCount() > 2 ? 1 : 0;
   size_t y = montage->getRowCount() > 2 ? 1 : 0;
@@ -325,7 +284,8 @@ void FFTConvolutionCostFunction::calculateImageDim(const GridMontageShPtr& monta
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::PixelTypei FFTConvolutionCostFunction::calculateNew2OldPixel(int64_t x, int64_t y, const ParametersType& parameters, double x_trans, double y_trans) const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::PixelTypei FFTConvolutionCostFunction<TPixel>::calculateNew2OldPixel(int64_t x, int64_t y, const ParametersType& parameters, double x_trans, double y_trans) const
 {
   FFTDewarpHelper::PixelIndex offset = FFTDewarpHelper::pixelIndex(x_trans, y_trans);
   return FFTDewarpHelper::getOldIndex({x, y}, offset, parameters);
@@ -334,14 +294,15 @@ FFTConvolutionCostFunction::PixelTypei FFTConvolutionCostFunction::calculateNew2
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FFTConvolutionCostFunction::initializeDataContainer(const GridMontageShPtr& montage, size_t row, size_t column, const QString& amName, const QString& daName)
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::initializeDataContainer(const GridMontageShPtr& montage, size_t row, size_t column, const QString& amName, const QString& daName)
 {
   static MutexType mutex;
 
   GridTileIndex index = montage->getTileIndex(row, column);
   DataContainer::Pointer dc = montage->getDataContainer(index);
   AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
-  DataArray<Grayscale_T>::Pointer da = am->getAttributeArrayAs<DataArray<Grayscale_T>>(daName);
+  typename DataArray<TPixel>::Pointer da = am->getAttributeArrayAs<DataArray<TPixel>>(daName);
   // size_t comps = da->getNumberOfComponents();
   ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
   FloatVec3Type spacing = imageGeom->getSpacing();
@@ -375,7 +336,7 @@ void FFTConvolutionCostFunction::initializeDataContainer(const GridMontageShPtr&
     offsetX -= tileWidth;
   }
 
-  InputImage::SizeType imageSize;
+  typename InputImage::SizeType imageSize;
   imageSize[0] = tileWidth;
   imageSize[1] = tileHeight;
 
@@ -383,8 +344,8 @@ void FFTConvolutionCostFunction::initializeDataContainer(const GridMontageShPtr&
   imageOrigin[0] = xOrigin;
   imageOrigin[1] = yOrigin;
 
-  InputImage::Pointer itkImage = InputImage::New();
-  itkImage->SetRegions(InputImage::RegionType(imageOrigin, imageSize));
+  typename InputImage::Pointer itkImage = InputImage::New();
+  itkImage->SetRegions(typename InputImage::RegionType(imageOrigin, imageSize));
   itkImage->Allocate();
 
   // A colored image could be used in a Fourier Transform as discussed in this paper:
@@ -392,7 +353,7 @@ void FFTConvolutionCostFunction::initializeDataContainer(const GridMontageShPtr&
   // NOTE Could this be parallelized?
   ParallelData2DAlgorithm dataAlg;
   dataAlg.setRange(offsetY, offsetX, tileHeight, tileWidth);
-  dataAlg.execute(FFTImageInitializer(itkImage, geomWidth, da));
+  dataAlg.execute(FFTImageInitializer<TPixel>(itkImage, geomWidth, da));
 
   GridKey imageKey = std::make_pair(column, row); // Flipped this to {x,y}
   ScopedLockType scopedLock(mutex);
@@ -421,7 +382,8 @@ ImageGeom::Pointer getImageGeomFromMontage(const GridMontageShPtr& montage, size
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FFTConvolutionCostFunction::precalcCropMap(const ImageGrid::value_type& inputImage, CropMap& cropMap)
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::precalcCropMap(const typename ImageGrid::value_type& inputImage, CropMap& cropMap)
 {
   // Add bounds to the CropMap
   auto origin = inputImage.second->GetRequestedRegion().GetIndex();
@@ -437,7 +399,8 @@ void FFTConvolutionCostFunction::precalcCropMap(const ImageGrid::value_type& inp
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FFTConvolutionCostFunction::GetDerivative(const ParametersType&, DerivativeType&) const
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::GetDerivative(const ParametersType&, DerivativeType&) const
 {
   throw std::exception();
 }
@@ -445,7 +408,8 @@ void FFTConvolutionCostFunction::GetDerivative(const ParametersType&, Derivative
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-uint32_t FFTConvolutionCostFunction::GetNumberOfParameters() const
+template <typename TPixel>
+uint32_t FFTConvolutionCostFunction<TPixel>::GetNumberOfParameters() const
 {
   return FFTDewarpHelper::getReqParameterSize();
 }
@@ -453,16 +417,21 @@ uint32_t FFTConvolutionCostFunction::GetNumberOfParameters() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::MeasureType FFTConvolutionCostFunction::GetValue(const ParametersType& parameters) const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::MeasureType FFTConvolutionCostFunction<TPixel>::GetValue(const ParametersType& parameters) const
 {
-  ParallelTaskAlgorithm taskAlg;
-  MeasureType residual = 0.0;
-  // Find the FFT Convolution and accumulate the maximum value from each overlap
-  for(const auto& overlap : m_Overlaps) // Parallelize this
-  {
-    taskAlg.execute(std::bind(&FFTConvolutionCostFunction::findFFTConvolutionAndMaxValue, this, overlap, parameters, std::ref(residual)));
-  }
-  taskAlg.wait();
+  // Find the FFT Convolution and the maximum value for each overlap.  Each overlap writes its own
+  // slot so no locking is required and the sum below does not depend on the thread scheduling.
+  std::vector<MeasureType> maxValues(m_Overlaps.size(), 0.0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, m_Overlaps.size());
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      maxValues[i] = findFFTConvolutionAndMaxValue(i, parameters);
+    }
+  });
+  MeasureType residual = std::accumulate(maxValues.begin(), maxValues.end(), static_cast<MeasureType>(0.0));
 
   // The value to maximize is the square of the sum of the maximum value of the fft convolution
   MeasureType result = residual * residual;
@@ -472,7 +441,8 @@ FFTConvolutionCostFunction::MeasureType FFTConvolutionCostFunction::GetValue(con
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::OverlapPairs FFTConvolutionCostFunction::createOverlapPairs(const CropMap& cropMap) const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::OverlapPairs FFTConvolutionCostFunction<TPixel>::createOverlapPairs(const CropMap& cropMap) const
 {
   OverlapPairs overlaps;
 
@@ -486,7 +456,7 @@ FFTConvolutionCostFunction::OverlapPairs FFTConvolutionCostFunction::createOverl
     if(rightIter != cropMap.end())
     {
       GridPair gridPair = std::make_pair(key, rightKey);
-      InputImage::RegionType region = createRightRegionPairs(bounds, rightIter->second);
+      typename InputImage::RegionType region = createRightRegionPairs(bounds, rightIter->second);
       OverlapPair overlapPair = std::make_pair(gridPair, region);
       overlaps.push_back(overlapPair);
     }
@@ -496,7 +466,7 @@ FFTConvolutionCostFunction::OverlapPairs FFTConvolutionCostFunction::createOverl
     if(botIter != cropMap.end())
     {
       GridPair gridPair = std::make_pair(key, botKey);
-      InputImage::RegionType region = createBottomRegionPairs(bounds, botIter->second);
+      typename InputImage::RegionType region = createBottomRegionPairs(bounds, botIter->second);
       OverlapPair overlapPair = std::make_pair(gridPair, region);
       overlaps.push_back(overlapPair);
     }
@@ -508,7 +478,8 @@ FFTConvolutionCostFunction::OverlapPairs FFTConvolutionCostFunction::createOverl
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::InputImage::RegionType FFTConvolutionCostFunction::createRightRegionPairs(const RegionBounds& left, const RegionBounds& right) const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::InputImage::RegionType FFTConvolutionCostFunction<TPixel>::createRightRegionPairs(const RegionBounds& left, const RegionBounds& right) const
 {
   const int64_t topBound = std::max(left.topBound, right.topBound);
   const int64_t bottomBound = std::min(left.bottomBound, right.bottomBound);
@@ -519,19 +490,20 @@ FFTConvolutionCostFunction::InputImage::RegionType FFTConvolutionCostFunction::c
   kernelOrigin[0] = right.leftBound;
   kernelOrigin[1] = topBound;
 
-  InputImage::SizeType kernelSize;
+  typename InputImage::SizeType kernelSize;
   kernelSize[0] = width;
   kernelSize[1] = height;
 
   // With the changes in overlap / origins, there are no longer any differences in the RegionPair
-  InputImage::RegionType rightRegion = InputImage::RegionType(kernelOrigin, kernelSize);
+  typename InputImage::RegionType rightRegion = typename InputImage::RegionType(kernelOrigin, kernelSize);
   return rightRegion;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::InputImage::RegionType FFTConvolutionCostFunction::createBottomRegionPairs(const RegionBounds& top, const RegionBounds& bottom) const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::InputImage::RegionType FFTConvolutionCostFunction<TPixel>::createBottomRegionPairs(const RegionBounds& top, const RegionBounds& bottom) const
 {
   const int64_t leftBound = std::max(top.leftBound, bottom.leftBound);
   const int64_t rightBound = std::min(top.rightBound, bottom.rightBound);
@@ -542,23 +514,52 @@ FFTConvolutionCostFunction::InputImage::RegionType FFTConvolutionCostFunction::c
   kernelOrigin[0] = leftBound;
   kernelOrigin[1] = bottom.topBound;
 
-  InputImage::SizeType kernelSize;
+  typename InputImage::SizeType kernelSize;
   kernelSize[0] = width;
   kernelSize[1] = height;
 
   // With the changes in overlap / origins, there are no longer any differences in the RegionPair
-  InputImage::RegionType botRegion = InputImage::RegionType(kernelOrigin, kernelSize);
+  typename InputImage::RegionType botRegion = typename InputImage::RegionType(kernelOrigin, kernelSize);
   return botRegion;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::ImagePair FFTConvolutionCostFunction::createOverlapImages(const OverlapPair& overlap, const ParametersType& parameters) const
+template <typename TPixel>
+std::unique_ptr<typename FFTConvolutionCostFunction<TPixel>::OverlapScratch> FFTConvolutionCostFunction<TPixel>::createOverlapScratch(const typename InputImage::RegionType& region) const
+{
+  std::unique_ptr<OverlapScratch> scratch = std::make_unique<OverlapScratch>();
+  scratch->firstImage = InputImage::New();
+  scratch->secondImage = InputImage::New();
+  resizeOverlapScratch(*scratch, region);
+  return scratch;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::resizeOverlapScratch(OverlapScratch& scratch, const typename InputImage::RegionType& region) const
+{
+  scratch.region = region;
+
+  scratch.firstImage->SetRegions({region.GetIndex(), region.GetSize()});
+  scratch.firstImage->Allocate();
+
+  scratch.secondImage->SetRegions({region.GetIndex(), region.GetSize()});
+  scratch.secondImage->Allocate();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::ImagePair FFTConvolutionCostFunction<TPixel>::createOverlapImages(const OverlapPair& overlap, const ParametersType& parameters, OverlapScratch& scratch) const
 {
   // First image calculation
-  InputImage::RegionType region = overlap.second;
-  const InputImage::Pointer firstBaseImg = m_ImageGrid.at(overlap.first.first);
+  typename InputImage::RegionType region = overlap.second;
+  const typename InputImage::Pointer firstBaseImg = m_ImageGrid.at(overlap.first.first);
 
   // Create RegionBounds
   RegionBounds bounds;
@@ -566,28 +567,28 @@ FFTConvolutionCostFunction::ImagePair FFTConvolutionCostFunction::createOverlapI
   bounds.bottomBound = region.GetIndex()[1] + region.GetSize()[1];
   bounds.leftBound = region.GetIndex()[0];
   bounds.rightBound = region.GetIndex()[0] + region.GetSize()[0];
+  RegionBoundsAccumulator threadBounds;
 
-  InputImage::Pointer firstOverlapImg = InputImage::New();
-  firstOverlapImg->SetRegions({region.GetIndex(), region.GetSize()});
-  firstOverlapImg->Allocate();
+  typename InputImage::Pointer firstOverlapImg = scratch.firstImage;
+  firstOverlapImg->SetRequestedRegionToLargestPossibleRegion();
 
   auto index = region.GetIndex();
   ParallelData2DAlgorithm dataAlg;
   dataAlg.setRange(index[1], index[0], index[1] + region.GetSize()[1], index[0] + region.GetSize()[0]);
-  dataAlg.execute(FFTImageOverlapGenerator(firstBaseImg, firstOverlapImg, index, m_ImageDim_x, m_ImageDim_y, parameters, bounds));
+  dataAlg.execute(FFTImageOverlapGenerator<TPixel>(firstBaseImg, firstOverlapImg, index, m_ImageDim_x, m_ImageDim_y, parameters, threadBounds, m_InterpolationType));
 
   // Second image calculation
-  const InputImage::Pointer secondBaseImg = m_ImageGrid.at(overlap.first.second);
+  const typename InputImage::Pointer secondBaseImg = m_ImageGrid.at(overlap.first.second);
 
-  InputImage::Pointer secondOverlapImg = InputImage::New();
-  secondOverlapImg->SetRegions({region.GetIndex(), region.GetSize()});
-  secondOverlapImg->Allocate();
+  typename InputImage::Pointer secondOverlapImg = scratch.secondImage;
+  secondOverlapImg->SetRequestedRegionToLargestPossibleRegion();
 
   index = region.GetIndex();
   dataAlg.setRange(index[1], index[0], index[1] + region.GetSize()[1], index[0] + region.GetSize()[0]);
-  dataAlg.execute(FFTImageOverlapGenerator(secondBaseImg, secondOverlapImg, index, m_ImageDim_x, m_ImageDim_y, parameters, bounds));
+  dataAlg.execute(FFTImageOverlapGenerator<TPixel>(secondBaseImg, secondOverlapImg, index, m_ImageDim_x, m_ImageDim_y, parameters, threadBounds, m_InterpolationType));
 
   // Crop images
+  threadBounds.mergeInto(bounds);
   ImagePair imgPair = std::make_pair(firstOverlapImg, secondOverlapImg);
   return cropOverlapImages(imgPair, bounds);
 }
@@ -595,14 +596,15 @@ FFTConvolutionCostFunction::ImagePair FFTConvolutionCostFunction::createOverlapI
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::ImagePair FFTConvolutionCostFunction::cropOverlapImages(const ImagePair& imagePair, const RegionBounds& bounds) const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::ImagePair FFTConvolutionCostFunction<TPixel>::cropOverlapImages(const ImagePair& imagePair, const RegionBounds& bounds) const
 {
   size_t width = static_cast<size_t>(bounds.rightBound - bounds.leftBound);
   size_t height = static_cast<size_t>(bounds.bottomBound - bounds.topBound);
 
-  InputImage::IndexType index{bounds.leftBound, bounds.topBound};
-  InputImage::SizeType size{width, height};
-  InputImage::RegionType region{index, size};
+  typename InputImage::IndexType index{bounds.leftBound, bounds.topBound};
+  typename InputImage::SizeType size{width, height};
+  typename InputImage::RegionType region{index, size};
 
   auto first = imagePair.first;
   auto second = imagePair.second;
@@ -629,17 +631,69 @@ double maxFromArray(double* ptr, size_t count)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FFTConvolutionCostFunction::findFFTConvolutionAndMaxValue(const OverlapPair& overlap, const ParametersType& parameters, MeasureType& residual) const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::MeasureType FFTConvolutionCostFunction<TPixel>::findFFTConvolutionAndMaxValue(size_t overlapIndex, const ParametersType& parameters) const
 {
-  static MutexType mutex;
+  const OverlapPair& overlap = m_Overlaps[overlapIndex];
+
+  // Reuse a free scratch with the same geometry, otherwise create one while the thread is under its
+  // limit or resize a free one.  Temporary images are only needed when every scratch is in use further
+  // up this thread's stack.
+  typename ScratchStorage::ScratchVector& threadScratch = m_ScratchStorage->local();
+  OverlapScratch* scratch = nullptr;
+  OverlapScratch* freeScratch = nullptr;
+  for(const auto& cachedScratch : threadScratch)
+  {
+    if(cachedScratch->inUse)
+    {
+      continue;
+    }
+    if(cachedScratch->region == overlap.second)
+    {
+      scratch = cachedScratch.get();
+      break;
+    }
+    freeScratch = cachedScratch.get();
+  }
 
-  ImagePair overlapImgs = createOverlapImages(overlap, parameters);
+  std::unique_ptr<OverlapScratch> temporaryScratch;
+  if(nullptr == scratch)
+  {
+    if(threadScratch.size() < k_MaxScratchPerThread)
+    {
+      threadScratch.push_back(createOverlapScratch(overlap.second));
+      scratch = threadScratch.back().get();
+    }
+    else if(nullptr != freeScratch)
+    {
+      resizeOverlapScratch(*freeScratch, overlap.second);
+      scratch = freeScratch;
+    }
+    else
+    {
+      temporaryScratch = createOverlapScratch(overlap.second);
+      scratch = temporaryScratch.get();
+    }
+  }
+  scratch->inUse = true;
+
+  ImagePair overlapImgs;
+  {
+    ITKPhaseTimer::Scope scope(m_PhaseTimer, "warp overlap");
+    overlapImgs = createOverlapImages(overlap, parameters, *scratch);
+  }
 
-  ConvolutionFilter::Pointer filter = ConvolutionFilter::New();
+  // The FFTs are planned again for every evaluation.  FFTConvolutionImageFilter builds its pad, forward FFT,
+  // multiply and inverse FFT filters inside GenerateData, so keeping the filter would not keep any plans, and
+  // both the image and the kernel change with the parameters, so there is no kernel transform to reuse.
+  typename ConvolutionFilter::Pointer filter = ConvolutionFilter::New();
   filter->SetInput(overlapImgs.first);
   filter->SetKernelImage(overlapImgs.second);
-  filter->Update();
-  OutputImage::Pointer fftConvolve = filter->GetOutput();
+  {
+    ITKPhaseTimer::Scope scope(m_PhaseTimer, "FFT");
+    filter->Update();
+  }
+  typename OutputImage::Pointer fftConvolve = filter->GetOutput();
 
   // Increment by the maximum value of the output of the fftConvolve
   // NOTE This methodology of getting the max element from the fftConvolve
@@ -649,14 +703,15 @@ void FFTConvolutionCostFunction::findFFTConvolutionAndMaxValue(const OverlapPair
   itk::SizeValueType bufferSize = pixelContainer->Size();
   MeasureType maxValue = maxFromArray(bufferPtr, bufferSize);
 
-  ScopedLockType lock(mutex);
-  residual += maxValue;
+  scratch->inUse = false;
+  return maxValue;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FFTConvolutionCostFunction::ImageGrid FFTConvolutionCostFunction::getImageGrid() const
+template <typename TPixel>
+typename FFTConvolutionCostFunction<TPixel>::ImageGrid FFTConvolutionCostFunction<TPixel>::getImageGrid() const
 {
   return m_ImageGrid;
 }
@@ -664,7 +719,8 @@ FFTConvolutionCostFunction::ImageGrid FFTConvolutionCostFunction::getImageGrid()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-double FFTConvolutionCostFunction::getImageDimX() const
+template <typename TPixel>
+double FFTConvolutionCostFunction<TPixel>::getImageDimX() const
 {
   return m_ImageDim_x;
 }
@@ -672,7 +728,42 @@ double FFTConvolutionCostFunction::getImageDimX() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-double FFTConvolutionCostFunction::getImageDimY() const
+template <typename TPixel>
+double FFTConvolutionCostFunction<TPixel>::getImageDimY() const
 {
   return m_ImageDim_y;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::setInterpolationType(FFTDewarpHelper::InterpolationType type)
+{
+  m_InterpolationType = type;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+FFTDewarpHelper::InterpolationType FFTConvolutionCostFunction<TPixel>::getInterpolationType() const
+{
+  return m_InterpolationType;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TPixel>
+void FFTConvolutionCostFunction<TPixel>::setPhaseTimer(ITKPhaseTimer* timer)
+{
+  m_PhaseTimer = timer;
+}
+
+// -----------------------------------------------------------------------------
+// Supported tile pixel types
+// -----------------------------------------------------------------------------
+template class FFTConvolutionCostFunction<uint8_t>;
+template class FFTConvolutionCostFunction<uint16_t>;
+template class FFTConvolutionCostFunction<float>;
@@ -39,6 +39,7 @@
 
 #include "ITKImageProcessing/ITKImageProcessingConstants.h"
 #include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTDewarpHelper.h"
 #include "ITKImageProcessing/ITKImageProcessingVersion.h"
 
 #include <itkConfigure.h>
@@ -49,15 +50,16 @@
 #pragma clang diagnostic ignored "-Wself-assign-field"
 #endif
 #endif
+#include <memory>
+
 #include "itkAmoebaOptimizer.h"
 #include "itkFFTConvolutionImageFilter.h"
 #include "itkSmartPointer.h"
 
-using Grayscale_T = uint8_t;
-using PixelValue_T = Grayscale_T;
 using OutputValue_T = double;
 
 class GridMontage;
+class ITKPhaseTimer;
 using GridMontageShPtr = std::shared_ptr<GridMontage>;
 
 struct RegionBounds
@@ -71,8 +73,11 @@ struct RegionBounds
 /**
  * @class FFTConvolutionCostFunction FFTConvolutionCostFunction.h ITKImageProcessingFilters/util/FFTConvolutionCostFunction.h
  * @brief The FFTConvolutionCostFunction class is used as the cost function for the Blend filter.
- * It is derived from itk::SingleValuedCostFunction.
+ * It is derived from itk::SingleValuedCostFunction.  The tiles are read directly from DataArrays of
+ * TPixel, which is instantiated for uint8_t, uint16_t and float.  Tiles with three or more components
+ * are converted to grayscale with luminosity weights while they are read.
  */
+template <typename TPixel>
 class ITKImageProcessing_EXPORT FFTConvolutionCostFunction : public itk::SingleValuedCostFunction
 {
 public:
@@ -85,16 +90,17 @@ public:
   using ConstPointer = itk::SmartPointer<const Self>;
 
   using Cell_T = size_t;
+  using PixelType = TPixel;
   using PixelCoord = itk::Index<IMAGE_DIMENSIONS>;
-  using InputImage = itk::Image<PixelValue_T, IMAGE_DIMENSIONS>;
+  using InputImage = itk::Image<TPixel, IMAGE_DIMENSIONS>;
   using OutputImage = itk::Image<OutputValue_T, IMAGE_DIMENSIONS>;
-  using KernelImages = std::pair<InputImage::Pointer, InputImage::Pointer>;
+  using KernelImages = std::pair<typename InputImage::Pointer, typename InputImage::Pointer>;
   using GridKey = std::pair<Cell_T, Cell_T>;
   using GridPair = std::pair<GridKey, GridKey>;
-  using OverlapPair = std::pair<GridPair, InputImage::RegionType>;
+  using OverlapPair = std::pair<GridPair, typename InputImage::RegionType>;
   using OverlapPairs = std::vector<OverlapPair>;
-  using ImagePair = std::pair<InputImage::Pointer, InputImage::Pointer>;
-  using ImageGrid = std::map<GridKey, InputImage::Pointer>;
+  using ImagePair = std::pair<typename InputImage::Pointer, typename InputImage::Pointer>;
+  using ImageGrid = std::map<GridKey, typename InputImage::Pointer>;
   using ConvolutionFilter = itk::FFTConvolutionImageFilter<InputImage, InputImage, OutputImage>;
   using PixelTypei = std::array<int64_t, 2>;
 
@@ -118,7 +124,7 @@ public:
   // Of each pair, the first is the i (the value to raise the u coordinate to)
   // and the second is the j (the value to raise the v coordinate to)
 
-  itkNewMacro(FFTConvolutionCostFunction);
+  itkNewMacro(Self);
 
   /**
    * @brief Initializes the cost function based on a given set of values.
@@ -167,6 +173,42 @@ public:
    */
   double getImageDimY() const;
 
+  /**
+   * @brief Sets how the overlap images sample the tiles at the warped positions.  Interpolating
+   * gives a smoother cost function than nearest neighbor, which is piecewise constant in the parameters.
+   * @param type
+   */
+  void setInterpolationType(FFTDewarpHelper::InterpolationType type);
+
+  /**
+   * @brief Returns the interpolation used to sample the tiles.
+   * @return
+   */
+  FFTDewarpHelper::InterpolationType getInterpolationType() const;
+
+  /**
+   * @brief Sets the timer that records the time spent warping the overlaps and running the FFT
+   * convolutions.  The timer may be a nullptr and must outlive the evaluations of this cost function.
+   * @param timer
+   */
+  void setPhaseTimer(ITKPhaseTimer* timer);
+
+  /**
+   * @brief Creates a cost function that evaluates the same overlaps on tiles downsampled by the given
+   * factor.  Each downsampled pixel is the mean of a factor x factor block of this cost function's tiles,
+   * so calling this repeatedly on the result builds an image pyramid without revisiting the full
+   * resolution tiles.  Parameters passed to the new cost function use the downsampled pixel positions.
+   * @param factor
+   * @return
+   */
+  Pointer createDownsampled(size_t factor) const;
+
+  /**
+   * @brief Returns the smallest width or height of any overlap region.
+   * @return
+   */
+  size_t getMinimumOverlapSize() const;
+
 private:
   /**
    * @brief This method is called by Initialize as a parallel task algorithm operating on each DataContainer.
@@ -181,7 +223,7 @@ private:
    * @param inputImage
    * @param cropMap
    */
-  void precalcCropMap(const ImageGrid::value_type& inputImage, CropMap& cropMap);
+  void precalcCropMap(const typename ImageGrid::value_type& inputImage, CropMap& cropMap);
 
   /**
    * @brief Creates OverlapPairs from the given CropMap.
@@ -196,7 +238,7 @@ private:
    * @param right
    * @return
    */
-  InputImage::RegionType createRightRegionPairs(const RegionBounds& left, const RegionBounds& right) const;
+  typename InputImage::RegionType createRightRegionPairs(const RegionBounds& left, const RegionBounds& right) const;
 
   /**
    * @brief Creates a RegionPair between two overlapping RegionBounds along the Y-axis
@@ -204,15 +246,33 @@ private:
    * @param bottom
    * @return
    */
-  InputImage::RegionType createBottomRegionPairs(const RegionBounds& top, const RegionBounds& bottom) const;
+  typename InputImage::RegionType createBottomRegionPairs(const RegionBounds& top, const RegionBounds& bottom) const;
+
+  struct OverlapScratch;
+  class ScratchStorage;
 
   /**
-   * @brief Creates and returns a pair of images containing the overlap section based on the given parameters.
+   * @brief Creates the overlap images reused for evaluating overlaps with the given region.
+   * @param region
+   * @return
+   */
+  std::unique_ptr<OverlapScratch> createOverlapScratch(const typename InputImage::RegionType& region) const;
+
+  /**
+   * @brief Reallocates the scratch images for the given region.
+   * @param scratch
+   * @param region
+   */
+  void resizeOverlapScratch(OverlapScratch& scratch, const typename InputImage::RegionType& region) const;
+
+  /**
+   * @brief Fills the scratch images with the overlap section based on the given parameters and returns them.
    * @param overlap
    * @param parameters
+   * @param scratch
    * @return
    */
-  ImagePair createOverlapImages(const OverlapPair& overlap, const ParametersType& parameters) const;
+  ImagePair createOverlapImages(const OverlapPair& overlap, const ParametersType& parameters, OverlapScratch& scratch) const;
 
   /**
    * @brief crops the ImagePair regions to match the RegionBounds provided.
@@ -222,12 +282,20 @@ private:
   ImagePair cropOverlapImages(const ImagePair& imagePair, const RegionBounds& bounds) const;
 
   /**
-   * @brief This method is called by GetValue to find the FFT Convolution and accumulate the maximum value from each overlap.
-   * @param overlap
+   * @brief This method is called by GetValue to find the FFT Convolution and return the maximum value for the given overlap.
+   * @param overlapIndex
    * @param parameters
-   * @param residual
+   * @return
+   */
+  MeasureType findFFTConvolutionAndMaxValue(size_t overlapIndex, const ParametersType& parameters) const;
+
+  /**
+   * @brief Returns a copy of the image reduced by the given factor by averaging factor x factor blocks.
+   * @param image
+   * @param factor
+   * @return
    */
-  void findFFTConvolutionAndMaxValue(const OverlapPair& overlap, const ParametersType& parameters, MeasureType& residual) const;
+  typename InputImage::Pointer downsampleImage(const typename InputImage::Pointer& image, size_t factor) const;
 
   /**
    * @brief Calculates the ImageDim_x and ImageDim_y values for a montage.
@@ -253,8 +321,15 @@ private:
   double m_ImageDim_x;
   double m_ImageDim_y;
   OverlapPairs m_Overlaps;
+  std::shared_ptr<ScratchStorage> m_ScratchStorage;
+  FFTDewarpHelper::InterpolationType m_InterpolationType = FFTDewarpHelper::InterpolationType::NearestNeighbor;
+  ITKPhaseTimer* m_PhaseTimer = nullptr;
 };
 
+extern template class FFTConvolutionCostFunction<uint8_t>;
+extern template class FFTConvolutionCostFunction<uint16_t>;
+extern template class FFTConvolutionCostFunction<float>;
+
 #if SIMPL_ITK_VERSION_CHECK
 #ifdef __clang__
 #pragma clang diagnostic pop
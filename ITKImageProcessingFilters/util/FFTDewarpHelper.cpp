@@ -32,6 +32,8 @@
 
 #include "FFTDewarpHelper.h"
 
+#include <cmath>
+
 // ----------------------------------------------------------------------------
 FFTDewarpHelper::PixelIndex FFTDewarpHelper::pixelIndex(int64_t x, int64_t y)
 {
@@ -97,3 +99,44 @@ int64_t FFTDewarpHelper::py(PixelIndex newIndex, PixelIndex offset, const Parame
 
   return static_cast<int64_t>(std::floor(oldYPrime + offset[1]));
 }
+
+// ----------------------------------------------------------------------------
+FFTDewarpHelper::ParametersType FFTDewarpHelper::scaleParameters(const ParametersType& parameters, double factor)
+{
+  // Scale applied to each term of px and py: u v u^2 v^2 uv u^2v uv^2
+  const double termScales[] = {1.0, 1.0, factor, factor, factor, factor * factor, factor * factor};
+  constexpr uint32_t partialSize = getReqPartialParameterSize();
+
+  ParametersType scaled(parameters.size());
+  for(uint32_t i = 0; i < parameters.size(); i++)
+  {
+    scaled[i] = parameters[i] * termScales[i % partialSize];
+  }
+  return scaled;
+}
+
+// ----------------------------------------------------------------------------
+void FFTDewarpHelper::getOldCoordsRow(int64_t y, int64_t xStart, int64_t xEnd, PixelIndex offset, const ParametersType& parameters, double* oldX, double* oldY)
+{
+  const double v = static_cast<double>(y - offset[1]);
+  const double vv = v * v;
+
+  // oldX' = ax2 * u^2 + ax1 * u + ax0
+  const double ax2 = parameters[2] + parameters[5] * v;
+  const double ax1 = parameters[0] + parameters[4] * v + parameters[6] * vv;
+  const double ax0 = parameters[1] * v + parameters[3] * vv + offset[0];
+
+  // oldY' = ay2 * u^2 + ay1 * u + ay0
+  const double ay2 = parameters[9] + parameters[12] * v;
+  const double ay1 = parameters[7] + parameters[11] * v + parameters[13] * vv;
+  const double ay0 = parameters[8] * v + parameters[10] * vv + offset[1];
+
+  const int64_t count = xEnd - xStart;
+  const double u0 = static_cast<double>(xStart - offset[0]);
+  for(int64_t i = 0; i < count; i++)
+  {
+    const double u = u0 + static_cast<double>(i);
+    oldX[i] = (ax2 * u + ax1) * u + ax0;
+    oldY[i] = (ay2 * u + ay1) * u + ay0;
+  }
+}
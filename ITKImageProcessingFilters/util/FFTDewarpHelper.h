@@ -32,7 +32,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 
 #include <itkConfigure.h>
 #define SIMPL_ITK_VERSION_CHECK (ITK_VERSION_MAJOR == 4)
@@ -50,6 +54,18 @@ namespace FFTDewarpHelper
 using PixelIndex = std::array<int64_t, 2>;
 using ParametersType = itk::SingleValuedCostFunction::ParametersType;
 
+/**
+ * @brief The InterpolationType enum lists the supported methods for sampling the old image at the
+ * sub-pixel position returned by the dewarp polynomial.  Old positions use index coordinates, so
+ * an integer position samples that pixel exactly for every method.
+ */
+enum class InterpolationType : int32_t
+{
+  NearestNeighbor = 0,
+  Bilinear = 1,
+  Bicubic = 2
+};
+
 /**
  * @brief Constructs a PixelTypei from x and y parameters
  * @param x
@@ -85,6 +101,141 @@ constexpr uint32_t getReqParameterSize()
 PixelIndex getOldIndex(PixelIndex newIndex, PixelIndex offset, const ParametersType& parameters);
 int64_t px(PixelIndex newIndex, PixelIndex offset, const ParametersType& parameters);
 int64_t py(PixelIndex newIndex, PixelIndex offset, const ParametersType& parameters);
+
+/**
+ * @brief Returns the parameters that describe the same warp on an image downsampled by the given
+ * factor.  Pixel positions scale by the factor, so the quadratic terms are multiplied by it and the
+ * cubic terms by its square.  Passing the reciprocal factor converts back to full resolution.
+ * @param parameters
+ * @param factor
+ * @return
+ */
+ParametersType scaleParameters(const ParametersType& parameters, double factor);
+
+/**
+ * @brief Fills oldX and oldY with the sub-pixel old positions for the new pixels [xStart, xEnd) of row y.
+ * @param y
+ * @param xStart
+ * @param xEnd
+ * @param offset
+ * @param parameters
+ * @param oldX
+ * @param oldY
+ */
+void getOldCoordsRow(int64_t y, int64_t xStart, int64_t xEnd, PixelIndex offset, const ParametersType& parameters, double* oldX, double* oldY);
+
+/**
+ * @brief Returns the offset of the first sample used by the interpolation kernel relative to the floored position.
+ * @param type
+ * @return
+ */
+constexpr int64_t getFirstTap(InterpolationType type)
+{
+  return type == InterpolationType::Bicubic ? -1 : 0;
+}
+
+/**
+ * @brief Returns the offset of the last sample used by the interpolation kernel relative to the floored position.
+ * @param type
+ * @return
+ */
+constexpr int64_t getLastTap(InterpolationType type)
+{
+  return type == InterpolationType::Bicubic ? 2 : (type == InterpolationType::Bilinear ? 1 : 0);
+}
+
+/**
+ * @brief Fills weights with the 1D kernel weights for the fractional position t, starting at getFirstTap.
+ * Bicubic interpolation uses the Catmull-Rom (a = -0.5) kernel.
+ * @param type
+ * @param t
+ * @param weights Must hold at least 4 values
+ */
+inline void getInterpolationWeights(InterpolationType type, double t, double* weights)
+{
+  switch(type)
+  {
+  case InterpolationType::Bilinear:
+    weights[0] = 1.0 - t;
+    weights[1] = t;
+    break;
+  case InterpolationType::Bicubic:
+    weights[0] = ((-0.5 * t + 1.0) * t - 0.5) * t;
+    weights[1] = (1.5 * t - 2.5) * t * t + 1.0;
+    weights[2] = ((-1.5 * t + 2.0) * t + 0.5) * t;
+    weights[3] = (0.5 * t - 0.5) * t * t;
+    break;
+  default:
+    weights[0] = 1.0;
+    break;
+  }
+}
+
+/**
+ * @brief Converts an interpolated value back to T, rounding and clamping integer types.
+ * @param value
+ * @return
+ */
+template <typename T>
+T castInterpolatedValue(double value)
+{
+  if(std::is_integral<T>::value)
+  {
+    value = std::round(value);
+    value = std::max(value, static_cast<double>(std::numeric_limits<T>::lowest()));
+    value = std::min(value, static_cast<double>(std::numeric_limits<T>::max()));
+  }
+  return static_cast<T>(value);
+}
+
+/**
+ * @brief Interpolates the tuple at the sub-pixel position { baseX + fracX, baseY + fracY } and writes
+ * it to out.  Samples outside of the image are clamped to the nearest edge pixel.
+ * @param getRow Callable returning a pointer to the first value of the given row
+ * @param width
+ * @param height
+ * @param numComps
+ * @param baseX
+ * @param baseY
+ * @param fracX
+ * @param fracY
+ * @param type
+ * @param out
+ */
+template <typename T, typename RowFunc>
+void interpolateTuple(RowFunc getRow, int64_t width, int64_t height, size_t numComps, int64_t baseX, int64_t baseY, double fracX, double fracY, InterpolationType type, T* out)
+{
+  const int64_t firstTap = getFirstTap(type);
+  const int64_t tapCount = getLastTap(type) - firstTap + 1;
+
+  double weightsX[4];
+  double weightsY[4];
+  getInterpolationWeights(type, fracX, weightsX);
+  getInterpolationWeights(type, fracY, weightsY);
+
+  int64_t columns[4];
+  for(int64_t i = 0; i < tapCount; i++)
+  {
+    columns[i] = std::min(std::max<int64_t>(baseX + firstTap + i, 0), width - 1);
+  }
+
+  for(size_t comp = 0; comp < numComps; comp++)
+  {
+    double value = 0.0;
+    for(int64_t j = 0; j < tapCount; j++)
+    {
+      const int64_t row = std::min(std::max<int64_t>(baseY + firstTap + j, 0), height - 1);
+      const T* rowPtr = getRow(static_cast<size_t>(row));
+      double rowValue = 0.0;
+      for(int64_t i = 0; i < tapCount; i++)
+      {
+        rowValue += weightsX[i] * static_cast<double>(rowPtr[columns[i] * numComps + comp]);
+      }
+      value += weightsY[j] * rowValue;
+    }
+    out[comp] = castInterpolatedValue<T>(value);
+  }
+}
 } // namespace FFTDewarpHelper
 
 #if SIMPL_ITK_VERSION_CHECK
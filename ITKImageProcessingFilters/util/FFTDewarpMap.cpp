@@ -0,0 +1,435 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FFTDewarpMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+#include <QtCore/QFile>
+#include <QtCore/QSysInfo>
+
+namespace
+{
+constexpr quint32 k_MagicNumber = 0x44574D50; // "DWMP"
+constexpr quint32 k_FileVersion = 2;
+// QDataStream raw reads and writes take an int byte count, so large maps are transferred in pieces
+constexpr qint64 k_MaxRawChunk = 1 << 30;
+
+// -----------------------------------------------------------------------------
+bool readRawChunks(QDataStream& in, char* data, qint64 byteCount)
+{
+  while(byteCount > 0)
+  {
+    const int chunk = static_cast<int>(std::min(byteCount, k_MaxRawChunk));
+    if(in.readRawData(data, chunk) != chunk)
+    {
+      return false;
+    }
+    data += chunk;
+    byteCount -= chunk;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void writeRawChunks(QDataStream& out, const char* data, qint64 byteCount)
+{
+  while(byteCount > 0)
+  {
+    const int chunk = static_cast<int>(std::min(byteCount, k_MaxRawChunk));
+    out.writeRawData(data, chunk);
+    data += chunk;
+    byteCount -= chunk;
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+bool FFTDewarpMap::Key::operator<(const Key& other) const
+{
+  return std::tie(width, height, xOffset, yOffset, interpolation, parameters) < std::tie(other.width, other.height, other.xOffset, other.yOffset, other.interpolation, other.parameters);
+}
+
+// -----------------------------------------------------------------------------
+bool FFTDewarpMap::Key::operator==(const Key& other) const
+{
+  return std::tie(width, height, xOffset, yOffset, interpolation, parameters) == std::tie(other.width, other.height, other.xOffset, other.yOffset, other.interpolation, other.parameters);
+}
+
+// -----------------------------------------------------------------------------
+FFTDewarpMap::Key FFTDewarpMap::CreateKey(const FFTDewarpHelper::ParametersType& parameters, const SizeVec3Type& dimensions, double x_trans, double y_trans,
+                                          FFTDewarpHelper::InterpolationType interpolationType)
+{
+  FFTDewarpHelper::PixelIndex offset = FFTDewarpHelper::pixelIndex(x_trans, y_trans);
+
+  Key key;
+  key.parameters.assign(parameters.begin(), parameters.end());
+  key.width = dimensions[0];
+  key.height = dimensions[1];
+  key.xOffset = offset[0];
+  key.yOffset = offset[1];
+  key.interpolation = static_cast<int32_t>(interpolationType);
+  return key;
+}
+
+// -----------------------------------------------------------------------------
+bool FFTDewarpMap::SupportsDimensions(const SizeVec3Type& dimensions)
+{
+  return dimensions[0] * dimensions[1] <= static_cast<size_t>(std::numeric_limits<int32_t>::max());
+}
+
+// -----------------------------------------------------------------------------
+FFTDewarpMap::FFTDewarpMap(const Key& key)
+: m_Key(key)
+, m_MaskStride((key.width + 7) / 8)
+{
+  // Each row of the bitmask is padded to a full byte so rows can be written in parallel
+  m_SourceIndices.resize(key.width * key.height, 0);
+  m_ValidMask.resize(m_MaskStride * key.height, 0);
+  if(getInterpolationType() != FFTDewarpHelper::InterpolationType::NearestNeighbor)
+  {
+    m_FractionX.resize(key.width * key.height, 0.0f);
+    m_FractionY.resize(key.width * key.height, 0.0f);
+  }
+}
+
+// -----------------------------------------------------------------------------
+FFTDewarpMap::Pointer FFTDewarpMap::Create(const Key& key)
+{
+  Pointer map = Pointer(new FFTDewarpMap(key));
+
+  FFTDewarpHelper::ParametersType parameters(key.parameters.size());
+  std::copy(key.parameters.begin(), key.parameters.end(), parameters.begin());
+
+  const FFTDewarpHelper::PixelIndex offset{key.xOffset, key.yOffset};
+  const int64_t width = static_cast<int64_t>(key.width);
+  const int64_t height = static_cast<int64_t>(key.height);
+  const bool storeFractions = map->getInterpolationType() != FFTDewarpHelper::InterpolationType::NearestNeighbor;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, key.height);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    std::vector<double> oldX(key.width);
+    std::vector<double> oldY(key.width);
+    for(size_t y = range.min(); y < range.max(); y++)
+    {
+      FFTDewarpHelper::getOldCoordsRow(static_cast<int64_t>(y), 0, width, offset, parameters, oldX.data(), oldY.data());
+
+      const size_t rowOffset = y * key.width;
+      int32_t* indexRow = map->m_SourceIndices.data() + rowOffset;
+      uint8_t* maskRow = map->m_ValidMask.data() + y * map->m_MaskStride;
+      for(int64_t x = 0; x < width; x++)
+      {
+        const double floorX = std::floor(oldX[x]);
+        const double floorY = std::floor(oldY[x]);
+        const int64_t baseX = static_cast<int64_t>(floorX);
+        const int64_t baseY = static_cast<int64_t>(floorY);
+
+        // Cannot flatten invalid { X,Y } positions
+        if(baseX < 0 || baseY < 0 || baseX >= width || baseY >= height)
+        {
+          continue;
+        }
+        indexRow[x] = static_cast<int32_t>(baseX + baseY * width);
+        maskRow[x >> 3] |= static_cast<uint8_t>(1 << (x & 7));
+        if(storeFractions)
+        {
+          map->m_FractionX[rowOffset + x] = static_cast<float>(oldX[x] - floorX);
+          map->m_FractionY[rowOffset + x] = static_cast<float>(oldY[x] - floorY);
+        }
+      }
+    }
+  });
+
+  map->updateMaxRowDisplacement();
+  return map;
+}
+
+// -----------------------------------------------------------------------------
+void FFTDewarpMap::updateMaxRowDisplacement()
+{
+  const size_t width = getWidth();
+  const size_t height = getHeight();
+  size_t maxDisplacement = 0;
+  for(size_t y = 0; y < height; y++)
+  {
+    for(size_t x = 0; x < width; x++)
+    {
+      if(!isValid(x, y))
+      {
+        continue;
+      }
+      const size_t sourceRow = static_cast<size_t>(getSourceIndex(x, y)) / width;
+      const size_t displacement = sourceRow > y ? sourceRow - y : y - sourceRow;
+      maxDisplacement = std::max(maxDisplacement, displacement);
+    }
+  }
+  // The interpolation kernel reads rows on both sides of the floored position
+  const FFTDewarpHelper::InterpolationType interpolationType = getInterpolationType();
+  const size_t kernelReach = static_cast<size_t>(std::max(-FFTDewarpHelper::getFirstTap(interpolationType), FFTDewarpHelper::getLastTap(interpolationType)));
+  m_MaxRowDisplacement = maxDisplacement + kernelReach;
+}
+
+// -----------------------------------------------------------------------------
+bool FFTDewarpMap::isConsistent() const
+{
+  const size_t width = getWidth();
+  const size_t height = getHeight();
+  const bool hasFractions = !m_FractionX.empty();
+  for(size_t y = 0; y < height; y++)
+  {
+    for(size_t x = 0; x < width; x++)
+    {
+      if(!isValid(x, y))
+      {
+        continue;
+      }
+      const int32_t sourceIndex = getSourceIndex(x, y);
+      if(sourceIndex < 0 || static_cast<size_t>(sourceIndex) >= m_SourceIndices.size())
+      {
+        return false;
+      }
+      if(!hasFractions)
+      {
+        continue;
+      }
+      // Written this way so NaN fractions are rejected as well
+      const size_t pixel = y * width + x;
+      if(!(m_FractionX[pixel] >= 0.0f && m_FractionX[pixel] < 1.0f) || !(m_FractionY[pixel] >= 0.0f && m_FractionY[pixel] < 1.0f))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+FFTDewarpMap::Pointer FFTDewarpMap::ReadFromStream(QDataStream& in)
+{
+  Key key;
+  quint32 paramCount = 0;
+  in >> paramCount;
+  if(paramCount != FFTDewarpHelper::getReqParameterSize())
+  {
+    return nullptr;
+  }
+  key.parameters.resize(paramCount);
+  for(auto& param : key.parameters)
+  {
+    in >> param;
+  }
+  quint64 width = 0;
+  quint64 height = 0;
+  qint64 xOffset = 0;
+  qint64 yOffset = 0;
+  qint32 interpolation = 0;
+  in >> width >> height >> xOffset >> yOffset >> interpolation;
+  if(in.status() != QDataStream::Ok || !SupportsDimensions(SizeVec3Type(width, height, 1)))
+  {
+    return nullptr;
+  }
+  if(interpolation < static_cast<qint32>(FFTDewarpHelper::InterpolationType::NearestNeighbor) || interpolation > static_cast<qint32>(FFTDewarpHelper::InterpolationType::Bicubic))
+  {
+    return nullptr;
+  }
+  key.width = width;
+  key.height = height;
+  key.xOffset = xOffset;
+  key.yOffset = yOffset;
+  key.interpolation = interpolation;
+
+  Pointer map = Pointer(new FFTDewarpMap(key));
+  const qint64 indexBytes = static_cast<qint64>(map->m_SourceIndices.size() * sizeof(int32_t));
+  const qint64 fractionBytes = static_cast<qint64>(map->m_FractionX.size() * sizeof(float));
+  if(!readRawChunks(in, reinterpret_cast<char*>(map->m_SourceIndices.data()), indexBytes) ||
+     !readRawChunks(in, reinterpret_cast<char*>(map->m_ValidMask.data()), static_cast<qint64>(map->m_ValidMask.size())) ||
+     !readRawChunks(in, reinterpret_cast<char*>(map->m_FractionX.data()), fractionBytes) || !readRawChunks(in, reinterpret_cast<char*>(map->m_FractionY.data()), fractionBytes))
+  {
+    return nullptr;
+  }
+  if(!map->isConsistent())
+  {
+    return nullptr;
+  }
+  map->updateMaxRowDisplacement();
+  return map;
+}
+
+// -----------------------------------------------------------------------------
+void FFTDewarpMap::writeToStream(QDataStream& out) const
+{
+  out << static_cast<quint32>(m_Key.parameters.size());
+  for(const auto& param : m_Key.parameters)
+  {
+    out << param;
+  }
+  out << static_cast<quint64>(m_Key.width) << static_cast<quint64>(m_Key.height);
+  out << static_cast<qint64>(m_Key.xOffset) << static_cast<qint64>(m_Key.yOffset) << static_cast<qint32>(m_Key.interpolation);
+  writeRawChunks(out, reinterpret_cast<const char*>(m_SourceIndices.data()), static_cast<qint64>(m_SourceIndices.size() * sizeof(int32_t)));
+  writeRawChunks(out, reinterpret_cast<const char*>(m_ValidMask.data()), static_cast<qint64>(m_ValidMask.size()));
+  writeRawChunks(out, reinterpret_cast<const char*>(m_FractionX.data()), static_cast<qint64>(m_FractionX.size() * sizeof(float)));
+  writeRawChunks(out, reinterpret_cast<const char*>(m_FractionY.data()), static_cast<qint64>(m_FractionY.size() * sizeof(float)));
+}
+
+// -----------------------------------------------------------------------------
+const FFTDewarpMap::Key& FFTDewarpMap::getKey() const
+{
+  return m_Key;
+}
+
+// -----------------------------------------------------------------------------
+FFTDewarpHelper::InterpolationType FFTDewarpMap::getInterpolationType() const
+{
+  return static_cast<FFTDewarpHelper::InterpolationType>(m_Key.interpolation);
+}
+
+// -----------------------------------------------------------------------------
+size_t FFTDewarpMap::getWidth() const
+{
+  return m_Key.width;
+}
+
+// -----------------------------------------------------------------------------
+size_t FFTDewarpMap::getHeight() const
+{
+  return m_Key.height;
+}
+
+// -----------------------------------------------------------------------------
+size_t FFTDewarpMap::getMaxRowDisplacement() const
+{
+  return m_MaxRowDisplacement;
+}
+
+// -----------------------------------------------------------------------------
+size_t FFTDewarpMap::getNumberOfPixels() const
+{
+  return m_SourceIndices.size();
+}
+
+// -----------------------------------------------------------------------------
+FFTDewarpMap::ConstPointer FFTDewarpMapCache::getMap(const FFTDewarpMap::Key& key)
+{
+  auto iter = m_Maps.find(key);
+  if(iter != m_Maps.end())
+  {
+    return iter->second;
+  }
+
+  FFTDewarpMap::ConstPointer map = FFTDewarpMap::Create(key);
+  m_Maps[key] = map;
+  m_Modified = true;
+  return map;
+}
+
+// -----------------------------------------------------------------------------
+size_t FFTDewarpMapCache::size() const
+{
+  return m_Maps.size();
+}
+
+// -----------------------------------------------------------------------------
+bool FFTDewarpMapCache::isModified() const
+{
+  return m_Modified;
+}
+
+// -----------------------------------------------------------------------------
+void FFTDewarpMapCache::clear()
+{
+  m_Maps.clear();
+  m_Modified = false;
+}
+
+// -----------------------------------------------------------------------------
+bool FFTDewarpMapCache::load(const QString& filePath)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+
+  QDataStream in(&file);
+  quint32 magic = 0;
+  quint32 version = 0;
+  qint32 byteOrder = 0;
+  quint32 count = 0;
+  in >> magic >> version >> byteOrder >> count;
+
+  // The index maps are stored as raw data, so they can only be read back on a machine with the same byte order
+  if(magic != k_MagicNumber || version != k_FileVersion || byteOrder != static_cast<qint32>(QSysInfo::ByteOrder))
+  {
+    return false;
+  }
+
+  for(quint32 i = 0; i < count; i++)
+  {
+    FFTDewarpMap::Pointer map = FFTDewarpMap::ReadFromStream(in);
+    if(nullptr == map)
+    {
+      return false;
+    }
+    m_Maps[map->getKey()] = map;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool FFTDewarpMapCache::save(const QString& filePath)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    return false;
+  }
+
+  QDataStream out(&file);
+  out << k_MagicNumber << k_FileVersion << static_cast<qint32>(QSysInfo::ByteOrder) << static_cast<quint32>(m_Maps.size());
+  for(const auto& iter : m_Maps)
+  {
+    iter.second->writeToStream(out);
+  }
+
+  if(out.status() != QDataStream::Ok)
+  {
+    return false;
+  }
+
+  m_Modified = false;
+  return true;
+}
@@ -0,0 +1,329 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTDewarpHelper.h"
+
+/**
+ * @class FFTDewarpMap FFTDewarpMap.h ITKImageProcessingFilters/util/FFTDewarpMap.h
+ * @brief The FFTDewarpMap class stores the result of the dewarp polynomial for a single tile
+ * geometry as a compact int32 source index per pixel plus a validity bitmask.  Once created,
+ * dewarping an array is a pure gather that does not evaluate the polynomial again.
+ */
+class ITKImageProcessing_EXPORT FFTDewarpMap
+{
+public:
+  using Pointer = std::shared_ptr<FFTDewarpMap>;
+  using ConstPointer = std::shared_ptr<const FFTDewarpMap>;
+
+  static constexpr size_t k_DefaultBandHeight = 64;
+
+  /**
+   * @brief The Key struct identifies every input that changes the content of the map.
+   * The offsets are stored after flooring, matching FFTDewarpHelper::pixelIndex.
+   */
+  struct Key
+  {
+    std::vector<double> parameters;
+    uint64_t width = 0;
+    uint64_t height = 0;
+    int64_t xOffset = 0;
+    int64_t yOffset = 0;
+    int32_t interpolation = static_cast<int32_t>(FFTDewarpHelper::InterpolationType::NearestNeighbor);
+
+    bool operator<(const Key& other) const;
+    bool operator==(const Key& other) const;
+  };
+
+  /**
+   * @brief Creates the Key for the given parameters, tile dimensions and translation.
+   * @param parameters
+   * @param dimensions
+   * @param x_trans
+   * @param y_trans
+   * @param interpolationType
+   * @return
+   */
+  static Key CreateKey(const FFTDewarpHelper::ParametersType& parameters, const SizeVec3Type& dimensions, double x_trans, double y_trans,
+                       FFTDewarpHelper::InterpolationType interpolationType = FFTDewarpHelper::InterpolationType::NearestNeighbor);
+
+  /**
+   * @brief Returns true if a tile of the given dimensions can be indexed by an int32 map.
+   * @param dimensions
+   * @return
+   */
+  static bool SupportsDimensions(const SizeVec3Type& dimensions);
+
+  /**
+   * @brief Evaluates the dewarp polynomial for every pixel described by the key.
+   * @param key
+   * @return
+   */
+  static Pointer Create(const Key& key);
+
+  /**
+   * @brief Reads a map previously written with writeToStream.  Returns nullptr if the stream is invalid.
+   * @param in
+   * @return
+   */
+  static Pointer ReadFromStream(QDataStream& in);
+
+  /**
+   * @brief Writes the key, index map and bitmask to the stream.
+   * @param out
+   */
+  void writeToStream(QDataStream& out) const;
+
+  /**
+   * @brief Returns the key used to create the map.
+   * @return
+   */
+  const Key& getKey() const;
+
+  /**
+   * @brief Returns the interpolation the map was created for.  The sub-pixel fractions are only stored
+   * when this is not InterpolationType::NearestNeighbor.
+   * @return
+   */
+  FFTDewarpHelper::InterpolationType getInterpolationType() const;
+
+  /**
+   * @brief Returns the tile width.
+   * @return
+   */
+  size_t getWidth() const;
+
+  /**
+   * @brief Returns the tile height.
+   * @return
+   */
+  size_t getHeight() const;
+
+  /**
+   * @brief Returns the number of pixels in the map.
+   * @return
+   */
+  size_t getNumberOfPixels() const;
+
+  /**
+   * @brief Returns the largest vertical distance between a new pixel and any source pixel read by
+   * its interpolation kernel.  This bounds how far back applyInPlace needs to keep the original rows.
+   * @return
+   */
+  size_t getMaxRowDisplacement() const;
+
+  /**
+   * @brief Returns true if the new pixel at { x, y } maps to a position inside of the tile.
+   * @param x
+   * @param y
+   * @return
+   */
+  bool isValid(size_t x, size_t y) const
+  {
+    return (m_ValidMask[y * m_MaskStride + (x >> 3)] >> (x & 7)) & 1;
+  }
+
+  /**
+   * @brief Returns the flattened source tuple index for the new pixel at { x, y }.  This is the floor of the
+   * sub-pixel position.  Only meaningful when isValid returns true.
+   * @param x
+   * @param y
+   * @return
+   */
+  int32_t getSourceIndex(size_t x, size_t y) const
+  {
+    return m_SourceIndices[y * m_Key.width + x];
+  }
+
+  /**
+   * @brief Dewarps data in place without copying the full array.  Rows are processed in bands of
+   * bandHeight rows.  Before a band is overwritten, its original rows are saved in a ring buffer
+   * that also keeps the previous getMaxRowDisplacement() rows, which are all the source rows
+   * that can still be read by later bands.  The extra memory is (bandHeight + getMaxRowDisplacement())
+   * rows regardless of the array size.
+   * @param data
+   * @param numComps
+   * @param initValue
+   * @param interpolate Uses the map's InterpolationType when true and nearest neighbor otherwise.  Categorical arrays should pass false.
+   * @param bandHeight
+   */
+  template <typename T>
+  void applyInPlace(T* data, size_t numComps, T initValue, bool interpolate, size_t bandHeight = k_DefaultBandHeight) const
+  {
+    const size_t width = getWidth();
+    const size_t height = getHeight();
+    const size_t rowSize = width * numComps;
+    const FFTDewarpHelper::InterpolationType interpolationType = interpolate ? getInterpolationType() : FFTDewarpHelper::InterpolationType::NearestNeighbor;
+    bandHeight = std::max<size_t>(bandHeight, 1);
+    const size_t ringRows = std::min(m_MaxRowDisplacement + bandHeight, height);
+    std::vector<T> ring(ringRows * rowSize);
+
+    for(size_t bandStart = 0; bandStart < height; bandStart += bandHeight)
+    {
+      const size_t bandEnd = std::min(bandStart + bandHeight, height);
+
+      // Save the original rows of the band before they are overwritten
+      for(size_t row = bandStart; row < bandEnd; row++)
+      {
+        std::copy_n(data + row * rowSize, rowSize, ring.data() + (row % ringRows) * rowSize);
+      }
+
+      // Rows before the end of the band are read from the ring buffer, later rows are still untouched
+      auto getRow = [&](size_t row) -> const T* { return row < bandEnd ? ring.data() + (row % ringRows) * rowSize : data + row * rowSize; };
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(bandStart, bandEnd);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        for(size_t y = range.min(); y < range.max(); y++)
+        {
+          for(size_t x = 0; x < width; x++)
+          {
+            T* destTuple = data + (y * width + x) * numComps;
+            if(!isValid(x, y))
+            {
+              std::fill_n(destTuple, numComps, initValue);
+              continue;
+            }
+
+            const size_t sourceIndex = static_cast<size_t>(getSourceIndex(x, y));
+            const size_t sourceRow = sourceIndex / width;
+            const size_t sourceCol = sourceIndex - sourceRow * width;
+            if(interpolationType == FFTDewarpHelper::InterpolationType::NearestNeighbor)
+            {
+              std::copy_n(getRow(sourceRow) + sourceCol * numComps, numComps, destTuple);
+            }
+            else
+            {
+              const size_t pixel = y * width + x;
+              FFTDewarpHelper::interpolateTuple<T>(getRow, width, height, numComps, sourceCol, sourceRow, m_FractionX[pixel], m_FractionY[pixel], interpolationType, destTuple);
+            }
+          }
+        }
+      });
+    }
+  }
+
+protected:
+  FFTDewarpMap(const Key& key);
+
+  /**
+   * @brief Recalculates m_MaxRowDisplacement from the index map and bitmask.
+   */
+  void updateMaxRowDisplacement();
+
+  /**
+   * @brief Returns true if every valid pixel maps to a source index inside of the tile and its sub-pixel
+   * fractions are in [0, 1).  Maps read from a file are checked so a damaged file cannot make applyInPlace
+   * read outside of the array.
+   * @return
+   */
+  bool isConsistent() const;
+
+private:
+  Key m_Key;
+  size_t m_MaskStride = 0;
+  size_t m_MaxRowDisplacement = 0;
+  std::vector<int32_t> m_SourceIndices;
+  std::vector<uint8_t> m_ValidMask;
+  std::vector<float> m_FractionX;
+  std::vector<float> m_FractionY;
+};
+
+/**
+ * @class FFTDewarpMapCache FFTDewarpMap.h ITKImageProcessingFilters/util/FFTDewarpMap.h
+ * @brief The FFTDewarpMapCache class holds every FFTDewarpMap used while dewarping a montage so that
+ * tiles sharing the same geometry reuse a single map.  The cache can be saved to and loaded from disk
+ * so that repeated runs with the same parameters skip creating the maps.
+ */
+class ITKImageProcessing_EXPORT FFTDewarpMapCache
+{
+public:
+  FFTDewarpMapCache() = default;
+  ~FFTDewarpMapCache() = default;
+
+  /**
+   * @brief Returns the map for the given key, creating it if it has not been cached yet.
+   * @param key
+   * @return
+   */
+  FFTDewarpMap::ConstPointer getMap(const FFTDewarpMap::Key& key);
+
+  /**
+   * @brief Returns the number of cached maps.
+   * @return
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns true if a map was created since the cache was last loaded or saved.
+   * @return
+   */
+  bool isModified() const;
+
+  /**
+   * @brief Removes every cached map.
+   */
+  void clear();
+
+  /**
+   * @brief Adds the maps stored in the given file to the cache.  Returns false if the file could not be read.
+   * @param filePath
+   * @return
+   */
+  bool load(const QString& filePath);
+
+  /**
+   * @brief Writes every cached map to the given file.  Returns false if the file could not be written.
+   * @param filePath
+   * @return
+   */
+  bool save(const QString& filePath);
+
+private:
+  std::map<FFTDewarpMap::Key, FFTDewarpMap::ConstPointer> m_Maps;
+  bool m_Modified = false;
+};
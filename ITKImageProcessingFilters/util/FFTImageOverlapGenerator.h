@@ -0,0 +1,397 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include "tbb/enumerable_thread_specific.h"
+#endif
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Utilities/ParallelData2DAlgorithm.h"
+
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTConvolutionCostFunction.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTDewarpHelper.h"
+
+/**
+ * @brief The FFTImageInitializer class copies a DataArray into the itk::Image used by
+ * the FFTConvolutionCostFunction.  Both buffers are accessed directly so the copy avoids the
+ * virtual DataArray accessors and the per-pixel index math of itk::Image::SetPixel.  Arrays with
+ * three or more components are treated as RGB and converted to grayscale with luminosity weights
+ * during the copy, so no intermediate grayscale array is needed.
+ */
+template <typename TPixel>
+class FFTImageInitializer
+{
+public:
+  static constexpr uint8_t IMAGE_DIMENSIONS = 2;
+  using InputImage = itk::Image<TPixel, IMAGE_DIMENSIONS>;
+  using DataArrayType = DataArray<TPixel>;
+
+  // Luminosity weights matching the ConvertColorToGrayScale defaults
+  static constexpr double k_RedWeight = 0.2125;
+  static constexpr double k_GreenWeight = 0.7154;
+  static constexpr double k_BlueWeight = 0.0721;
+
+  /**
+   * @brief Constructor
+   * @param image
+   * @param width
+   * @param dataArray
+   */
+  FFTImageInitializer(const typename InputImage::Pointer& image, size_t width, const typename DataArrayType::Pointer& dataArray)
+  : m_Image(image)
+  , m_Width(width)
+  , m_DataArray(dataArray)
+  , m_Comps(dataArray->getNumberOfComponents())
+  , m_Source(dataArray->data())
+  , m_Buffer(image->GetBufferPointer())
+  {
+    const typename InputImage::RegionType bufferedRegion = image->GetBufferedRegion();
+    const auto requestedIndex = image->GetRequestedRegion().GetIndex();
+    m_BufferWidth = bufferedRegion.GetSize()[0];
+    m_ShiftX = requestedIndex[0] - bufferedRegion.GetIndex()[0];
+    m_ShiftY = requestedIndex[1] - bufferedRegion.GetIndex()[1];
+  }
+
+  /**
+   * @brief Sets the image's pixel at the specified position based on the DataArray value.
+   * @param pxlWidthIdx
+   * @param pxlHeightIdx
+   */
+  void setPixel(size_t pxlWidthIdx, size_t pxlHeightIdx) const
+  {
+    getImageRow(pxlHeightIdx)[pxlWidthIdx] = grayscaleValue(m_Source + (pxlWidthIdx + pxlHeightIdx * m_Width) * m_Comps);
+  }
+
+  /**
+   * @brief Function operator to set the pixel value for items over a 2D range.
+   * Each row is copied with a single strided pass over the source tuples.
+   * @param range
+   */
+  void operator()(const SIMPLRange2D& range) const
+  {
+    const size_t xStart = range.minCol();
+    const size_t count = range.maxCol() - xStart;
+    for(size_t y = range.minRow(); y < range.maxRow(); y++)
+    {
+      const TPixel* src = m_Source + (xStart + y * m_Width) * m_Comps;
+      TPixel* dst = getImageRow(y) + xStart;
+      if(m_Comps == 1)
+      {
+        std::copy(src, src + count, dst);
+        continue;
+      }
+      for(size_t i = 0; i < count; i++)
+      {
+        dst[i] = grayscaleValue(src + i * m_Comps);
+      }
+    }
+  }
+
+private:
+  typename InputImage::Pointer m_Image;
+  size_t m_Width;
+  typename DataArrayType::Pointer m_DataArray;
+  size_t m_Comps;
+  const TPixel* m_Source = nullptr;
+  TPixel* m_Buffer = nullptr;
+  size_t m_BufferWidth = 0;
+  int64_t m_ShiftX = 0;
+  int64_t m_ShiftY = 0;
+
+  /**
+   * @brief Returns a pointer to the image buffer at the start of the given tile row.
+   * Tile positions are relative to the requested region of the image.
+   * @param y
+   * @return
+   */
+  TPixel* getImageRow(size_t y) const
+  {
+    return m_Buffer + (static_cast<int64_t>(y) + m_ShiftY) * static_cast<int64_t>(m_BufferWidth) + m_ShiftX;
+  }
+
+  /**
+   * @brief Returns the grayscale value of the tuple starting at the given component.  Tuples with
+   * fewer than three components use the first component.
+   * @param tuple
+   * @return
+   */
+  TPixel grayscaleValue(const TPixel* tuple) const
+  {
+    if(m_Comps < 3)
+    {
+      return tuple[0];
+    }
+    const double value = k_RedWeight * tuple[0] + k_GreenWeight * tuple[1] + k_BlueWeight * tuple[2];
+    return FFTDewarpHelper::castInterpolatedValue<TPixel>(value);
+  }
+};
+
+/**
+ * @brief The RegionBoundsAccumulator class collects the RegionBounds found by each thread while
+ * generating an overlap image.  Threads only touch their own copy, and the copies are merged once
+ * the overlap is complete.
+ */
+class RegionBoundsAccumulator
+{
+public:
+  RegionBoundsAccumulator()
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  : m_ThreadBounds(EmptyBounds())
+#endif
+  {
+  }
+
+  /**
+   * @brief Returns RegionBounds that do not restrict any region when merged.
+   * @return
+   */
+  static RegionBounds EmptyBounds()
+  {
+    RegionBounds bounds;
+    bounds.leftBound = std::numeric_limits<int64_t>::lowest();
+    bounds.topBound = std::numeric_limits<int64_t>::lowest();
+    bounds.rightBound = std::numeric_limits<int64_t>::max();
+    bounds.bottomBound = std::numeric_limits<int64_t>::max();
+    return bounds;
+  }
+
+  /**
+   * @brief Shrinks the target RegionBounds so that it lies within the source RegionBounds.
+   * @param target
+   * @param source
+   */
+  static void Merge(RegionBounds& target, const RegionBounds& source)
+  {
+    target.leftBound = std::max(target.leftBound, source.leftBound);
+    target.topBound = std::max(target.topBound, source.topBound);
+    target.rightBound = std::min(target.rightBound, source.rightBound);
+    target.bottomBound = std::min(target.bottomBound, source.bottomBound);
+  }
+
+  /**
+   * @brief Returns the RegionBounds owned by the calling thread.
+   * @return
+   */
+  RegionBounds& local()
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    return m_ThreadBounds.local();
+#else
+    return m_Bounds;
+#endif
+  }
+
+  /**
+   * @brief Merges the RegionBounds of every thread into the given RegionBounds.
+   * @param bounds
+   */
+  void mergeInto(RegionBounds& bounds) const
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    m_ThreadBounds.combine_each([&bounds](const RegionBounds& threadBounds) { Merge(bounds, threadBounds); });
+#else
+    Merge(bounds, m_Bounds);
+#endif
+  }
+
+private:
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::enumerable_thread_specific<RegionBounds> m_ThreadBounds;
+#else
+  RegionBounds m_Bounds = EmptyBounds();
+#endif
+};
+
+/**
+ * @brief The FFTImageOverlapGenerator class is used for generating itk::Images
+ * for the specified overlap region from a given itk::Image, offsets, and
+ * dewarp parameters.  The base and overlap image buffers are accessed directly
+ * and the old positions are computed a row at a time.
+ */
+template <typename TPixel>
+class FFTImageOverlapGenerator
+{
+  static constexpr uint8_t IMAGE_DIMENSIONS = 2;
+  using PixelCoord = itk::Index<IMAGE_DIMENSIONS>;
+  using InputImage = itk::Image<TPixel, IMAGE_DIMENSIONS>;
+  using ParametersType = itk::SingleValuedCostFunction::ParametersType;
+
+public:
+  /**
+   * @brief Constructor
+   * @param baseImg
+   * @param image
+   * @param offset
+   * @param imageDim_x
+   * @param imageDim_y
+   * @param parameters
+   * @param regionBounds
+   * @param interpolationType
+   */
+  FFTImageOverlapGenerator(const typename InputImage::Pointer& baseImg, const typename InputImage::Pointer& image, const PixelCoord& offset, size_t imageDim_x, size_t imageDim_y, const ParametersType& parameters,
+                           RegionBoundsAccumulator& regionBounds, FFTDewarpHelper::InterpolationType interpolationType)
+  : m_BaseImg(baseImg)
+  , m_Image(image)
+  , m_Parameters(parameters)
+  , m_Bounds(regionBounds)
+  , m_InterpolationType(interpolationType)
+  , m_BaseBuffer(baseImg->GetBufferPointer())
+  , m_ImageBuffer(image->GetBufferPointer())
+  {
+    double x_trans = (imageDim_x - 1) / 2.0;
+    double y_trans = (imageDim_y - 1) / 2.0;
+    m_Offset = FFTDewarpHelper::pixelIndex(x_trans - offset[0], y_trans - offset[1]);
+
+    const typename InputImage::RegionType baseRegion = baseImg->GetBufferedRegion();
+    m_BaseIndex = baseRegion.GetIndex();
+    m_BaseWidth = static_cast<int64_t>(baseRegion.GetSize()[0]);
+    m_BaseHeight = static_cast<int64_t>(baseRegion.GetSize()[1]);
+
+    const typename InputImage::RegionType imageRegion = image->GetBufferedRegion();
+    m_ImageIndex = imageRegion.GetIndex();
+    m_ImageWidth = static_cast<int64_t>(imageRegion.GetSize()[0]);
+
+    const auto origin = image->GetOrigin();
+    const auto size = image->GetRequestedRegion().GetSize();
+    m_Origin[0] = origin[0];
+    m_Origin[1] = origin[1];
+    m_Size[0] = static_cast<double>(size[0]);
+    m_Size[1] = static_cast<double>(size[1]);
+  }
+
+  /**
+   * @brief Updates the thread's RegionBounds based on the provided invalid index.
+   * @param bounds
+   * @param x
+   * @param y
+   */
+  void updateRegionBounds(RegionBounds& bounds, int64_t x, int64_t y) const
+  {
+    const int64_t distTop = y - m_Origin[1];
+    const int64_t distBot = m_Origin[1] + m_Size[1] - y;
+    const int64_t distLeft = x - m_Origin[0];
+    const int64_t distRight = m_Origin[0] + m_Size[0] - x;
+
+    if(distTop <= distBot && distTop <= distLeft && distTop <= distRight)
+    {
+      bounds.topBound = std::max(bounds.topBound, y);
+    }
+    else if(distBot <= distTop && distBot <= distLeft && distBot <= distRight)
+    {
+      bounds.bottomBound = std::min(bounds.bottomBound, y);
+    }
+    else if(distLeft <= distTop && distLeft <= distBot && distLeft <= distRight)
+    {
+      bounds.leftBound = std::max(bounds.leftBound, x);
+    }
+    else if(distRight <= distTop && distRight <= distBot && distRight <= distLeft)
+    {
+      bounds.rightBound = std::min(bounds.rightBound, x);
+    }
+  }
+
+  /**
+   * @brief Function operator to set the pixel value for items over a 2D range.
+   * @param range
+   */
+  void operator()(const SIMPLRange2D& range) const
+  {
+    const bool interpolate = m_InterpolationType != FFTDewarpHelper::InterpolationType::NearestNeighbor;
+    const int64_t xStart = static_cast<int64_t>(range.minCol());
+    const int64_t xEnd = static_cast<int64_t>(range.maxCol());
+    const size_t count = static_cast<size_t>(xEnd - xStart);
+    auto getRow = [this](size_t row) { return m_BaseBuffer + row * m_BaseWidth; };
+
+    std::vector<double> oldX(count);
+    std::vector<double> oldY(count);
+    RegionBounds bounds = RegionBoundsAccumulator::EmptyBounds();
+    bool foundInvalid = false;
+
+    for(size_t y = range.minRow(); y < range.maxRow(); y++)
+    {
+      const int64_t row = static_cast<int64_t>(y);
+      FFTDewarpHelper::getOldCoordsRow(row, xStart, xEnd, m_Offset, m_Parameters, oldX.data(), oldY.data());
+      TPixel* dst = m_ImageBuffer + (row - m_ImageIndex[1]) * m_ImageWidth + (xStart - m_ImageIndex[0]);
+      for(size_t i = 0; i < count; i++)
+      {
+        const double floorX = std::floor(oldX[i]);
+        const double floorY = std::floor(oldY[i]);
+        const int64_t baseX = static_cast<int64_t>(floorX) - m_BaseIndex[0];
+        const int64_t baseY = static_cast<int64_t>(floorY) - m_BaseIndex[1];
+        if(baseX < 0 || baseX >= m_BaseWidth || baseY < 0 || baseY >= m_BaseHeight)
+        {
+          dst[i] = 0;
+          updateRegionBounds(bounds, xStart + static_cast<int64_t>(i), row);
+          foundInvalid = true;
+          continue;
+        }
+        if(interpolate)
+        {
+          FFTDewarpHelper::interpolateTuple<TPixel>(getRow, m_BaseWidth, m_BaseHeight, 1, baseX, baseY, oldX[i] - floorX, oldY[i] - floorY, m_InterpolationType, dst + i);
+        }
+        else
+        {
+          dst[i] = m_BaseBuffer[baseY * m_BaseWidth + baseX];
+        }
+      }
+    }
+
+    if(foundInvalid)
+    {
+      RegionBoundsAccumulator::Merge(m_Bounds.local(), bounds);
+    }
+  }
+
+private:
+  typename InputImage::Pointer m_BaseImg;
+  typename InputImage::Pointer m_Image;
+  FFTDewarpHelper::PixelIndex m_Offset;
+  ParametersType m_Parameters;
+  RegionBoundsAccumulator& m_Bounds;
+  FFTDewarpHelper::InterpolationType m_InterpolationType;
+  const TPixel* m_BaseBuffer = nullptr;
+  TPixel* m_ImageBuffer = nullptr;
+  PixelCoord m_BaseIndex;
+  int64_t m_BaseWidth = 0;
+  int64_t m_BaseHeight = 0;
+  PixelCoord m_ImageIndex;
+  int64_t m_ImageWidth = 0;
+  double m_Origin[2] = {0.0, 0.0};
+  double m_Size[2] = {0.0, 0.0};
+};
@@ -0,0 +1,122 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <itkImage.h>
+#include <itkImportImageContainer.h>
+#include <itkNumericTraits.h>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/ITK/itkGetComponentsDimensions.h"
+
+/**
+ * @brief The ITKDataArrayImageView namespace wraps DataArray buffers as itk::Images without copying.
+ * The image's pixel container points at the DataArray's memory and never frees it, so the DataArray
+ * must outlive the image and must not be resized while the image is in use.
+ */
+namespace ITKDataArrayImageView
+{
+/**
+ * @brief Returns an itk::Image over the DataArray's buffer with the given region.  The number of tuples
+ * in the DataArray must match the number of pixels in the region.
+ * @param dataArray
+ * @param region
+ * @return
+ */
+template <typename PixelType, unsigned int Dimension>
+typename itk::Image<PixelType, Dimension>::Pointer wrapDataArray(DataArray<typename itk::NumericTraits<PixelType>::ValueType>& dataArray,
+                                                                 const typename itk::Image<PixelType, Dimension>::RegionType& region)
+{
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ContainerType = typename ImageType::PixelContainer;
+
+  typename ContainerType::Pointer container = ContainerType::New();
+  container->SetImportPointer(reinterpret_cast<PixelType*>(dataArray.data()), region.GetNumberOfPixels(), false);
+
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetPixelContainer(container);
+  return image;
+}
+
+/**
+ * @brief Returns an itk::Image over the DataArray's buffer using the dimensions, spacing and origin of
+ * the ImageGeom.  For 2D images the Z dimension of the geometry is ignored.
+ * @param imageGeom
+ * @param dataArray
+ * @return
+ */
+template <typename PixelType, unsigned int Dimension>
+typename itk::Image<PixelType, Dimension>::Pointer wrapDataArray(const ImageGeom& imageGeom, DataArray<typename itk::NumericTraits<PixelType>::ValueType>& dataArray)
+{
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  const SizeVec3Type dims = imageGeom.getDimensions();
+  const FloatVec3Type spacing = imageGeom.getSpacing();
+  const FloatVec3Type origin = imageGeom.getOrigin();
+
+  typename ImageType::SizeType size;
+  typename ImageType::SpacingType itkSpacing;
+  typename ImageType::PointType itkOrigin;
+  for(unsigned int i = 0; i < Dimension; i++)
+  {
+    size[i] = dims[i];
+    itkSpacing[i] = spacing[i];
+    itkOrigin[i] = origin[i];
+  }
+  typename ImageType::IndexType index;
+  index.Fill(0);
+
+  typename ImageType::Pointer image = wrapDataArray<PixelType, Dimension>(dataArray, typename ImageType::RegionType(index, size));
+  image->SetSpacing(itkSpacing);
+  image->SetOrigin(itkOrigin);
+  return image;
+}
+
+/**
+ * @brief Returns true if the DataArray holds exactly the pixels of the given region for the pixel type.
+ * @param dataArray
+ * @param region
+ * @return
+ */
+template <typename PixelType, unsigned int Dimension>
+bool canWrapDataArray(const DataArray<typename itk::NumericTraits<PixelType>::ValueType>& dataArray, const typename itk::Image<PixelType, Dimension>::RegionType& region)
+{
+  const std::vector<size_t> cDims = ITKDream3DHelper::GetComponentsDimensions<PixelType>();
+  return dataArray.getNumberOfTuples() == region.GetNumberOfPixels() && dataArray.getComponentDimensions() == cDims;
+}
+} // namespace ITKDataArrayImageView
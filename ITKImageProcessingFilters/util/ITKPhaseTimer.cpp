@@ -0,0 +1,282 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ITKPhaseTimer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+namespace
+{
+const char* const k_TimingVariable = "ITKIMAGEPROCESSING_PHASE_TIMING";
+const char* const k_TraceDirVariable = "ITKIMAGEPROCESSING_TRACE_DIR";
+
+// Bounds the memory of traces from filters that time many short intervals (e.g. cost function evaluations).
+// The phase statistics keep counting past this limit.
+constexpr size_t k_MaxTraceIntervals = 1000000;
+
+struct TimingSettings
+{
+  TimingSettings()
+  {
+    QByteArray value = qgetenv(k_TimingVariable).trimmed().toLower();
+    enabled = !value.isEmpty() && value != "0" && value != "off" && value != "false";
+    traceDirectory = QString::fromLocal8Bit(qgetenv(k_TraceDirVariable));
+  }
+
+  std::atomic<bool> enabled{false};
+  std::mutex mutex;
+  QString traceDirectory;
+};
+
+TimingSettings& timingSettings()
+{
+  static TimingSettings settings;
+  return settings;
+}
+
+double toMilliseconds(ITKPhaseTimer::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double toMicroseconds(ITKPhaseTimer::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKPhaseTimer::ITKPhaseTimer(const QString& name)
+: m_Name(name)
+, m_Enabled(IsEnabled())
+, m_KeepIntervals(m_Enabled && !GetTraceDirectory().isEmpty())
+, m_Created(Clock::now())
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKPhaseTimer::~ITKPhaseTimer() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKPhaseTimer::IsEnabled()
+{
+  return timingSettings().enabled.load();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPhaseTimer::SetEnabled(bool value)
+{
+  timingSettings().enabled.store(value);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPhaseTimer::GetTraceDirectory()
+{
+  TimingSettings& settings = timingSettings();
+  std::lock_guard<std::mutex> lock(settings.mutex);
+  return settings.traceDirectory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPhaseTimer::SetTraceDirectory(const QString& value)
+{
+  TimingSettings& settings = timingSettings();
+  std::lock_guard<std::mutex> lock(settings.mutex);
+  settings.traceDirectory = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKPhaseTimer::isEnabled() const
+{
+  return m_Enabled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPhaseTimer::addInterval(const char* phase, Clock::time_point start, Clock::time_point end)
+{
+  if(!m_Enabled)
+  {
+    return;
+  }
+
+  Clock::duration duration = end - start;
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  size_t phaseIndex = 0;
+  while(phaseIndex < m_Phases.size() && m_Phases[phaseIndex].name != phase && std::strcmp(m_Phases[phaseIndex].name, phase) != 0)
+  {
+    phaseIndex++;
+  }
+  if(phaseIndex == m_Phases.size())
+  {
+    PhaseStats stats;
+    stats.name = phase;
+    m_Phases.push_back(stats);
+  }
+  PhaseStats& stats = m_Phases[phaseIndex];
+  stats.count++;
+  stats.total += duration;
+  stats.max = std::max(stats.max, duration);
+
+  if(m_KeepIntervals && m_Intervals.size() < k_MaxTraceIntervals)
+  {
+    auto threadIter = m_ThreadIndices.emplace(std::this_thread::get_id(), static_cast<int32_t>(m_ThreadIndices.size())).first;
+    m_Intervals.push_back({phaseIndex, threadIter->second, start, end});
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ITKPhaseTimer::getSummary() const
+{
+  QJsonArray phases;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(const PhaseStats& stats : m_Phases)
+    {
+      QJsonObject phase;
+      phase["phase"] = QString::fromUtf8(stats.name);
+      phase["count"] = static_cast<double>(stats.count);
+      phase["total_ms"] = toMilliseconds(stats.total);
+      phase["max_ms"] = toMilliseconds(stats.max);
+      phases.append(phase);
+    }
+  }
+
+  QJsonObject summary;
+  summary["filter"] = m_Name;
+  summary["elapsed_ms"] = toMilliseconds(Clock::now() - m_Created);
+  summary["phases"] = phases;
+  return QString::fromUtf8(QJsonDocument(summary).toJson(QJsonDocument::Compact));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ITKPhaseTimer::writeChromeTrace(const QString& filePath) const
+{
+  QJsonArray events;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(const auto& thread : m_ThreadIndices)
+    {
+      QJsonObject args;
+      args["name"] = QString("thread %1").arg(thread.second);
+      QJsonObject event;
+      event["name"] = QString("thread_name");
+      event["ph"] = QString("M");
+      event["pid"] = 1;
+      event["tid"] = thread.second;
+      event["args"] = args;
+      events.append(event);
+    }
+    for(const Interval& interval : m_Intervals)
+    {
+      QJsonObject event;
+      event["name"] = QString::fromUtf8(m_Phases[interval.phase].name);
+      event["cat"] = m_Name;
+      event["ph"] = QString("X");
+      event["ts"] = toMicroseconds(interval.start - m_Created);
+      event["dur"] = toMicroseconds(interval.end - interval.start);
+      event["pid"] = 1;
+      event["tid"] = interval.thread;
+      events.append(event);
+    }
+  }
+
+  QJsonObject trace;
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = QString("ms");
+
+  QFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    return false;
+  }
+  QByteArray bytes = QJsonDocument(trace).toJson(QJsonDocument::Compact);
+  return file.write(bytes) == bytes.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKPhaseTimer::report(AbstractFilter* filter) const
+{
+  if(!m_Enabled || nullptr == filter)
+  {
+    return;
+  }
+
+  filter->notifyStatusMessage(QString("Phase timings: %1").arg(getSummary()));
+
+  QString traceDirectory = GetTraceDirectory();
+  if(!m_KeepIntervals || traceDirectory.isEmpty())
+  {
+    return;
+  }
+  QDir dir(traceDirectory);
+  QString fileName = QString("%1_%2.json").arg(m_Name, QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz"));
+  QString filePath = dir.absoluteFilePath(fileName);
+  if(!dir.mkpath(".") || !writeChromeTrace(filePath))
+  {
+    filter->notifyStatusMessage(QString("Phase timings: could not write the trace file %1").arg(filePath));
+    return;
+  }
+  filter->notifyStatusMessage(QString("Phase timings: trace written to %1").arg(filePath));
+}
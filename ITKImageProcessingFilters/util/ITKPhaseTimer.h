@@ -0,0 +1,201 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+
+class AbstractFilter;
+
+/**
+ * @brief The ITKPhaseTimer class accumulates the wall clock time a filter spends in named phases of its
+ * execute(), such as reading tiles or running FFTs.  Phases are timed with ITKPhaseTimer::Scope and may be
+ * recorded from several threads at once.  report() sends a JSON summary of the phases as a status message
+ * and, if a trace directory is set, writes every timed interval to a Chrome trace file that can be opened
+ * in chrome://tracing or Perfetto.
+ *
+ * Timing is off by default and then costs one branch per scope.  It is switched on by setting the
+ * ITKIMAGEPROCESSING_PHASE_TIMING environment variable to 1 or by calling SetEnabled(true); the trace
+ * directory is read from ITKIMAGEPROCESSING_TRACE_DIR or set with SetTraceDirectory().
+ */
+class ITKImageProcessing_EXPORT ITKPhaseTimer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief The Scope class times the phase from its construction to its destruction.  Nothing is
+   * measured when the timer is a nullptr or disabled.
+   */
+  class ITKImageProcessing_EXPORT Scope
+  {
+  public:
+    Scope(ITKPhaseTimer* timer, const char* phase)
+    : m_Timer((nullptr != timer && timer->isEnabled()) ? timer : nullptr)
+    , m_Phase(phase)
+    {
+      if(nullptr != m_Timer)
+      {
+        m_Start = Clock::now();
+      }
+    }
+
+    ~Scope()
+    {
+      if(nullptr != m_Timer)
+      {
+        m_Timer->addInterval(m_Phase, m_Start, Clock::now());
+      }
+    }
+
+    Scope(const Scope&) = delete;            // Copy Constructor Not Implemented
+    Scope(Scope&&) = delete;                 // Move Constructor Not Implemented
+    Scope& operator=(const Scope&) = delete; // Copy Assignment Not Implemented
+    Scope& operator=(Scope&&) = delete;      // Move Assignment Not Implemented
+
+  private:
+    ITKPhaseTimer* m_Timer = nullptr;
+    const char* m_Phase = nullptr;
+    Clock::time_point m_Start;
+  };
+
+  /**
+   * @brief Creates a timer for one execution of the filter called name.  The timer is enabled if timing
+   * was switched on when it is created.
+   * @param name
+   */
+  explicit ITKPhaseTimer(const QString& name);
+  ~ITKPhaseTimer();
+
+  /**
+   * @brief Returns whether phase timing is switched on for new timers.
+   * @return
+   */
+  static bool IsEnabled();
+
+  /**
+   * @brief Switches phase timing on or off for new timers, overriding the environment.
+   * @param value
+   */
+  static void SetEnabled(bool value);
+
+  /**
+   * @brief Returns the directory Chrome trace files are written to.  An empty string disables them.
+   * @return
+   */
+  static QString GetTraceDirectory();
+
+  /**
+   * @brief Sets the directory Chrome trace files are written to, overriding the environment.
+   * @param value
+   */
+  static void SetTraceDirectory(const QString& value);
+
+  /**
+   * @brief Returns whether this timer records phases.
+   * @return
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief Records that phase ran from start to end on the calling thread.  phase must point to a string
+   * that outlives the timer, usually a literal.
+   * @param phase
+   * @param start
+   * @param end
+   */
+  void addInterval(const char* phase, Clock::time_point start, Clock::time_point end);
+
+  /**
+   * @brief Returns a compact JSON object with the elapsed time since the timer was created and the count,
+   * total and maximum milliseconds of each phase in the order the phases were first recorded.  Phases
+   * that overlap on several threads add up to more than the elapsed time.
+   * @return
+   */
+  QString getSummary() const;
+
+  /**
+   * @brief Writes the recorded intervals to filePath in the Chrome trace event format.
+   * @param filePath
+   * @return false if the file could not be written
+   */
+  bool writeChromeTrace(const QString& filePath) const;
+
+  /**
+   * @brief Sends the summary as a status message of filter and writes the Chrome trace file if a trace
+   * directory is set.  Does nothing if the timer is disabled.
+   * @param filter
+   */
+  void report(AbstractFilter* filter) const;
+
+public:
+  ITKPhaseTimer(const ITKPhaseTimer&) = delete;            // Copy Constructor Not Implemented
+  ITKPhaseTimer(ITKPhaseTimer&&) = delete;                 // Move Constructor Not Implemented
+  ITKPhaseTimer& operator=(const ITKPhaseTimer&) = delete; // Copy Assignment Not Implemented
+  ITKPhaseTimer& operator=(ITKPhaseTimer&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  struct PhaseStats
+  {
+    const char* name = nullptr;
+    uint64_t count = 0;
+    Clock::duration total = Clock::duration::zero();
+    Clock::duration max = Clock::duration::zero();
+  };
+
+  struct Interval
+  {
+    size_t phase = 0;
+    int32_t thread = 0;
+    Clock::time_point start;
+    Clock::time_point end;
+  };
+
+  QString m_Name;
+  bool m_Enabled = false;
+  bool m_KeepIntervals = false;
+  Clock::time_point m_Created;
+
+  mutable std::mutex m_Mutex;
+  std::vector<PhaseStats> m_Phases;
+  std::vector<Interval> m_Intervals;
+  std::unordered_map<std::thread::id, int32_t> m_ThreadIndices;
+};
@@ -0,0 +1,117 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <itkDataObject.h>
+#include <itkProcessObject.h>
+
+/**
+ * @brief The ITKPipelineLink class connects the ITK filters of consecutive ITKImageBase filters into a single
+ * ITK pipeline.  A filter with a link takes its input image from the link instead of its input DataArray and
+ * leaves its output image in the link for the next filter.  Outputs that are not written to their DataArray are
+ * never updated on their own: the ITK pipeline computes them when a later output is updated and releases each
+ * one as soon as the next ITK filter has consumed it.
+ */
+class ITKPipelineLink
+{
+public:
+  using Pointer = std::shared_ptr<ITKPipelineLink>;
+
+  ITKPipelineLink() = default;
+  ~ITKPipelineLink() = default;
+
+  /**
+   * @brief Returns the output image of the previous filter or nullptr for the first filter.
+   * @return
+   */
+  itk::DataObject* getImage() const
+  {
+    return m_Image.GetPointer();
+  }
+
+  /**
+   * @brief Sets the output image for the next filter.  The ITK filters that produce the image are kept alive
+   * until the link is cleared, so the image can be updated after the ITKImageBase filter has returned.
+   * @param image
+   * @param sources
+   */
+  void setImage(itk::DataObject* image, const std::vector<itk::ProcessObject*>& sources)
+  {
+    m_Image = image;
+    for(itk::ProcessObject* source : sources)
+    {
+      m_Sources.push_back(source);
+    }
+  }
+
+  /**
+   * @brief Returns whether the current filter should write its output to its DataArray.
+   * @return
+   */
+  bool getWriteOutput() const
+  {
+    return m_WriteOutput;
+  }
+
+  /**
+   * @brief Sets whether the current filter should write its output to its DataArray.  Filters that do not
+   * write their output only create it as an unallocated placeholder for the next filter's type checks.
+   * @param value
+   */
+  void setWriteOutput(bool value)
+  {
+    m_WriteOutput = value;
+  }
+
+  /**
+   * @brief Releases the image and every ITK filter of the pipeline.
+   */
+  void clear()
+  {
+    m_Image = nullptr;
+    m_Sources.clear();
+  }
+
+  ITKPipelineLink(const ITKPipelineLink&) = delete;            // Copy Constructor Not Implemented
+  ITKPipelineLink(ITKPipelineLink&&) = delete;                 // Move Constructor Not Implemented
+  ITKPipelineLink& operator=(const ITKPipelineLink&) = delete; // Copy Assignment Not Implemented
+  ITKPipelineLink& operator=(ITKPipelineLink&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  itk::DataObject::Pointer m_Image;
+  std::vector<itk::ProcessObject::Pointer> m_Sources;
+  bool m_WriteOutput = true;
+};
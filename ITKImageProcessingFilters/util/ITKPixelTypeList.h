@@ -0,0 +1,137 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+/**
+ * @brief The ITKPixelTypeList namespace holds the compile time lists of pixel types and dimensions that
+ * a filter is instantiated for, and the functions that select the list entry matching a DataArray.
+ */
+namespace ITKPixelTypeList
+{
+template <typename... Types>
+struct TypeList
+{
+};
+
+template <unsigned int... Dimensions>
+struct DimensionList
+{
+};
+
+/**
+ * @brief PixelTag carries a pixel type through a generic lambda.
+ */
+template <typename T>
+struct PixelTag
+{
+  using Type = T;
+};
+
+template <unsigned int Dimension>
+using DimensionTag = std::integral_constant<unsigned int, Dimension>;
+
+using AllScalarPixelTypes = TypeList<int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, float, double>;
+using IntegerPixelTypes = TypeList<int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t>;
+/**
+ * @brief The types images are stored in.  8 bit signed integers are cast through float and 64 bit
+ * integers through double.
+ */
+using StandardPixelTypes = TypeList<uint8_t, int16_t, uint16_t, int32_t, uint32_t, float, double>;
+using RealPixelTypes = TypeList<float, double>;
+
+using AllDimensions = DimensionList<2, 3>;
+
+/**
+ * @brief Contains<T, Types>::value is true if T is one of Types.
+ */
+template <typename T, typename Types>
+struct Contains;
+
+template <typename T>
+struct Contains<T, TypeList<>> : std::false_type
+{
+};
+
+template <typename T, typename First, typename... Rest>
+struct Contains<T, TypeList<First, Rest...>> : std::integral_constant<bool, std::is_same<T, First>::value || Contains<T, TypeList<Rest...>>::value>
+{
+};
+
+/**
+ * @brief Calls call(PixelTag<T>()) for the type T of Types that dataArray holds.
+ * @return false if dataArray does not hold any of the types.
+ */
+template <typename Functor>
+bool dispatchPixelType(TypeList<> /* types */, const IDataArray* /* dataArray */, Functor&& /* call */)
+{
+  return false;
+}
+
+template <typename T, typename... Rest, typename Functor>
+bool dispatchPixelType(TypeList<T, Rest...> /* types */, const IDataArray* dataArray, Functor&& call)
+{
+  if(nullptr != dynamic_cast<const DataArray<T>*>(dataArray))
+  {
+    call(PixelTag<T>());
+    return true;
+  }
+  return dispatchPixelType(TypeList<Rest...>(), dataArray, std::forward<Functor>(call));
+}
+
+/**
+ * @brief Calls call(DimensionTag<D>()) for the entry D of Dimensions equal to dimension.
+ * @return false if dimension is not in the list.
+ */
+template <typename Functor>
+bool dispatchDimension(DimensionList<> /* dimensions */, unsigned int /* dimension */, Functor&& /* call */)
+{
+  return false;
+}
+
+template <unsigned int D, unsigned int... Rest, typename Functor>
+bool dispatchDimension(DimensionList<D, Rest...> /* dimensions */, unsigned int dimension, Functor&& call)
+{
+  if(D == dimension)
+  {
+    call(DimensionTag<D>());
+    return true;
+  }
+  return dispatchDimension(DimensionList<Rest...>(), dimension, std::forward<Functor>(call));
+}
+} // namespace ITKPixelTypeList
@@ -0,0 +1,298 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ITKResultCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// Constants and finalizer of MurmurHash3 x64 128
+constexpr uint64_t k_C1 = 0x87C37B91114253D5ULL;
+constexpr uint64_t k_C2 = 0x4CF5AD432745937FULL;
+
+inline uint64_t rotl64(uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t fmix64(uint64_t k)
+{
+  k ^= k >> 33;
+  k *= 0xFF51AFD7ED558CCDULL;
+  k ^= k >> 33;
+  k *= 0xC4CEB9FE1A85EC53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+inline uint64_t load64(const uint8_t* data)
+{
+  uint64_t value = 0;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKResultCache::Hasher::addBlock(uint64_t k1, uint64_t k2)
+{
+  k1 *= k_C1;
+  k1 = rotl64(k1, 31);
+  k1 *= k_C2;
+  m_H1 ^= k1;
+  m_H1 = rotl64(m_H1, 27);
+  m_H1 += m_H2;
+  m_H1 = m_H1 * 5 + 0x52DCE729;
+
+  k2 *= k_C2;
+  k2 = rotl64(k2, 33);
+  k2 *= k_C1;
+  m_H2 ^= k2;
+  m_H2 = rotl64(m_H2, 31);
+  m_H2 += m_H1;
+  m_H2 = m_H2 * 5 + 0x38495AB5;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKResultCache::Hasher::add(const void* data, size_t size)
+{
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  m_Length += size;
+
+  // Complete the block left over from the previous call
+  if(m_PendingSize > 0)
+  {
+    const size_t count = std::min(size, sizeof(m_Pending) - m_PendingSize);
+    std::memcpy(m_Pending + m_PendingSize, bytes, count);
+    m_PendingSize += count;
+    bytes += count;
+    size -= count;
+    if(m_PendingSize < sizeof(m_Pending))
+    {
+      return;
+    }
+    addBlock(load64(m_Pending), load64(m_Pending + 8));
+    m_PendingSize = 0;
+  }
+
+  for(; size >= sizeof(m_Pending); bytes += sizeof(m_Pending), size -= sizeof(m_Pending))
+  {
+    addBlock(load64(bytes), load64(bytes + 8));
+  }
+
+  std::memcpy(m_Pending, bytes, size);
+  m_PendingSize = size;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKResultCache::Key ITKResultCache::Hasher::finish() const
+{
+  uint64_t h1 = m_H1;
+  uint64_t h2 = m_H2;
+
+  if(m_PendingSize > 0)
+  {
+    uint8_t tail[16] = {};
+    std::memcpy(tail, m_Pending, m_PendingSize);
+    uint64_t k1 = load64(tail);
+    uint64_t k2 = load64(tail + 8);
+    k2 *= k_C2;
+    k2 = rotl64(k2, 33);
+    k2 *= k_C1;
+    h2 ^= k2;
+    k1 *= k_C1;
+    k1 = rotl64(k1, 31);
+    k1 *= k_C2;
+    h1 ^= k1;
+  }
+
+  h1 ^= m_Length;
+  h2 ^= m_Length;
+  h1 += h2;
+  h2 += h1;
+  h1 = fmix64(h1);
+  h2 = fmix64(h2);
+  h1 += h2;
+  h2 += h1;
+
+  Key key;
+  key.low = h1;
+  key.high = h2;
+  return key;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKResultCache::ITKResultCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKResultCache::~ITKResultCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ITKResultCache* ITKResultCache::Instance()
+{
+  static ITKResultCache instance;
+  return &instance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ITKResultCache::GetArraySizeInBytes(const IDataArray& array)
+{
+  return array.getSize() * static_cast<size_t>(array.getTypeSize());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer ITKResultCache::find(const Key& key)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto iter = m_Index.find(key);
+  if(iter == m_Index.end())
+  {
+    m_MissCount++;
+    return IDataArray::NullPointer();
+  }
+  m_HitCount++;
+  m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+  return iter->second->array;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKResultCache::insert(const Key& key, const IDataArray::Pointer& array, size_t budgetBytes)
+{
+  if(nullptr == array)
+  {
+    return;
+  }
+  const size_t bytes = GetArraySizeInBytes(*array);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto iter = m_Index.find(key);
+  if(iter != m_Index.end())
+  {
+    m_SizeInBytes -= iter->second->bytes;
+    m_Entries.erase(iter->second);
+    m_Index.erase(iter);
+  }
+  if(bytes > budgetBytes)
+  {
+    evict(budgetBytes);
+    return;
+  }
+
+  evict(budgetBytes - bytes);
+  Entry entry;
+  entry.key = key;
+  entry.array = array;
+  entry.bytes = bytes;
+  m_Entries.push_front(entry);
+  m_Index[key] = m_Entries.begin();
+  m_SizeInBytes += bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKResultCache::evict(size_t budgetBytes)
+{
+  while(m_SizeInBytes > budgetBytes && !m_Entries.empty())
+  {
+    const Entry& entry = m_Entries.back();
+    m_SizeInBytes -= entry.bytes;
+    m_Index.erase(entry.key);
+    m_Entries.pop_back();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ITKResultCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+  m_Index.clear();
+  m_SizeInBytes = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ITKResultCache::getNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ITKResultCache::getSizeInBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_SizeInBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ITKResultCache::getHitCount() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_HitCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ITKResultCache::getMissCount() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MissCount;
+}
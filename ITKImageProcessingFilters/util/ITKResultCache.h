@@ -0,0 +1,211 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+#include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+
+/**
+ * @brief The ITKResultCache class keeps the output arrays of recently executed ITK image filters so that a
+ * filter run again on the same input with the same parameters can reuse its previous output.  Entries are
+ * identified by a 128 bit hash of the input arrays and the filter parameters and are evicted least recently
+ * used first once the cached arrays exceed the memory budget passed to insert().  The cache is shared by all
+ * filters and is safe to use from several threads.
+ */
+class ITKImageProcessing_EXPORT ITKResultCache
+{
+public:
+  /**
+   * @brief The Key struct identifies a cached result.
+   */
+  struct Key
+  {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Key& other) const
+    {
+      return low == other.low && high == other.high;
+    }
+  };
+
+  /**
+   * @brief The KeyHash struct lets Key be used in unordered containers.
+   */
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const
+    {
+      return static_cast<size_t>(key.low ^ (key.high * 0x9E3779B97F4A7C15ULL));
+    }
+  };
+
+  /**
+   * @brief The Hasher class computes a Key incrementally with a fast non-cryptographic hash, so large
+   * arrays can be hashed in chunks.  The result only depends on the bytes added, not on how they were split
+   * between calls to add().
+   */
+  class ITKImageProcessing_EXPORT Hasher
+  {
+  public:
+    Hasher() = default;
+    ~Hasher() = default;
+
+    /**
+     * @brief Adds size bytes starting at data to the hash.
+     * @param data
+     * @param size
+     */
+    void add(const void* data, size_t size);
+
+    /**
+     * @brief Adds the bytes of a trivially copyable value to the hash.
+     * @param value
+     */
+    template <typename T>
+    void addValue(const T& value)
+    {
+      add(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Returns the hash of all bytes added so far.
+     * @return
+     */
+    Key finish() const;
+
+  private:
+    void addBlock(uint64_t k1, uint64_t k2);
+
+    uint64_t m_H1 = 0x6A09E667F3BCC908ULL;
+    uint64_t m_H2 = 0xBB67AE8584CAA73BULL;
+    uint8_t m_Pending[16] = {};
+    size_t m_PendingSize = 0;
+    uint64_t m_Length = 0;
+  };
+
+  /**
+   * @brief Returns the cache shared by all filters.
+   * @return
+   */
+  static ITKResultCache* Instance();
+
+  /**
+   * @brief Returns the array cached for key or nullptr.  A hit makes the entry the most recently used one.
+   * The returned array belongs to the cache and must be copied before it is modified.
+   * @param key
+   * @return
+   */
+  IDataArray::Pointer find(const Key& key);
+
+  /**
+   * @brief Caches array for key and evicts the least recently used entries until the cache holds at most
+   * budgetBytes.  Arrays larger than the budget are not cached.
+   * @param key
+   * @param array
+   * @param budgetBytes
+   */
+  void insert(const Key& key, const IDataArray::Pointer& array, size_t budgetBytes);
+
+  /**
+   * @brief Removes all entries.
+   */
+  void clear();
+
+  /**
+   * @brief Returns the number of cached arrays.
+   * @return
+   */
+  size_t getNumberOfEntries() const;
+
+  /**
+   * @brief Returns the number of bytes held by the cached arrays.
+   * @return
+   */
+  size_t getSizeInBytes() const;
+
+  /**
+   * @brief Returns the number of successful lookups since the cache was created.
+   * @return
+   */
+  size_t getHitCount() const;
+
+  /**
+   * @brief Returns the number of failed lookups since the cache was created.
+   * @return
+   */
+  size_t getMissCount() const;
+
+  /**
+   * @brief Returns the number of bytes used by the values of array.
+   * @param array
+   * @return
+   */
+  static size_t GetArraySizeInBytes(const IDataArray& array);
+
+public:
+  ITKResultCache(const ITKResultCache&) = delete;            // Copy Constructor Not Implemented
+  ITKResultCache(ITKResultCache&&) = delete;                 // Move Constructor Not Implemented
+  ITKResultCache& operator=(const ITKResultCache&) = delete; // Copy Assignment Not Implemented
+  ITKResultCache& operator=(ITKResultCache&&) = delete;      // Move Assignment Not Implemented
+
+protected:
+  ITKResultCache();
+  ~ITKResultCache();
+
+private:
+  struct Entry
+  {
+    Key key;
+    IDataArray::Pointer array;
+    size_t bytes = 0;
+  };
+  using EntryList = std::list<Entry>;
+
+  void evict(size_t budgetBytes);
+
+  mutable std::mutex m_Mutex;
+  EntryList m_Entries;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> m_Index;
+  size_t m_SizeInBytes = 0;
+  size_t m_HitCount = 0;
+  size_t m_MissCount = 0;
+};
@@ -32,11 +32,237 @@
 
 #include "MontageImportHelper.h"
 
+#include <algorithm>
+#include <array>
+#include <exception>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
+
+#include <itkImageIOBase.h>
+#include <itkImageIOFactory.h>
+
 #include <QtCore/QObject>
 
+#include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 
+#include "ITKImageProcessing/ITKImageProcessingConstants.h"
 #include "ITKImageProcessing/ITKImageProcessingFilters/MetaXmlUtils.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKPhaseTimer.h"
+
+namespace
+{
+const QString k_TileDCName("TileImport");
+
+// Size of the color strips read at once by ImageIOs that can stream
+constexpr size_t k_ColorStripBytes = 4 * 1024 * 1024;
+
+#if ITK_VERSION_MAJOR > 5 || (ITK_VERSION_MAJOR == 5 && ITK_VERSION_MINOR >= 1)
+constexpr itk::IOFileModeEnum k_ReadMode = itk::IOFileModeEnum::ReadMode;
+constexpr itk::IOComponentEnum k_UCharComponent = itk::IOComponentEnum::UCHAR;
+#else
+constexpr itk::ImageIOFactory::FileModeType k_ReadMode = itk::ImageIOFactory::ReadMode;
+constexpr itk::ImageIOBase::IOComponentType k_UCharComponent = itk::ImageIOBase::UCHAR;
+#endif
+
+/**
+ * @brief The DecodedTile struct holds the image array read for a tile, or the error that prevented reading it.
+ */
+struct DecodedTile
+{
+  IDataArray::Pointer imageArray;
+  int32_t errorCode = 0;
+  QString errorMessage;
+};
+
+// The sub filters created here are not connected to the importing filter because they may run on worker threads.
+// Their errors are reported through DecodedTile instead.
+ITKImageReader::Pointer createImageReader(const QString& imageFileName, const DataArrayPath& daPath)
+{
+  ITKImageReader::Pointer imageReader = ITKImageReader::New();
+  imageReader->setDataContainerArray(DataContainerArray::New());
+  imageReader->setFileName(imageFileName);
+  imageReader->setDataContainerName(daPath);
+  imageReader->setCellAttributeMatrixName(daPath.getAttributeMatrixName());
+  imageReader->setImageDataArrayName(daPath.getDataArrayName());
+  return imageReader;
+}
+
+ConvertColorToGrayScale::Pointer createColorToGrayScaleFilter(const DataContainerArray::Pointer& dca, const DataArrayPath& daPath, const FloatVec3Type& colorWeights, const QString& outputArrayName)
+{
+  ConvertColorToGrayScale::Pointer rgbToGray = ConvertColorToGrayScale::New();
+  rgbToGray->setDataContainerArray(dca);
+  rgbToGray->setConversionAlgorithm(0);
+  rgbToGray->setColorWeights(colorWeights);
+  std::vector<DataArrayPath> inputDataArrayVector = {daPath};
+  rgbToGray->setInputDataArrayVector(inputDataArrayVector);
+  rgbToGray->setCreateNewAttributeMatrix(false);
+  rgbToGray->setOutputAttributeMatrixName(daPath.getAttributeMatrixName());
+  rgbToGray->setOutputArrayPrefix(outputArrayName);
+  return rgbToGray;
+}
+
+/**
+ * @brief Converts interleaved 8 bit color pixels to luminance with the same weights and rounding as the luminosity
+ * algorithm of ConvertColorToGrayScale.  The component count is a template parameter so the loop only has fixed
+ * stride loads and compilers vectorize it.
+ */
+template <size_t ComponentCount>
+void convertColorToLuminance(const uint8_t* color, size_t pixelCount, const std::array<float, 3>& weights, uint8_t* gray)
+{
+  // Copying the weights and clamping with conditionals keeps the loop free of aliasing and NaN semantics that stop vectorization
+  const float redWeight = weights[0];
+  const float greenWeight = weights[1];
+  const float blueWeight = weights[2];
+  for(size_t i = 0; i < pixelCount; i++)
+  {
+    const uint8_t* pixel = color + i * ComponentCount;
+    float value = pixel[0] * redWeight + pixel[1] * greenWeight + pixel[2] * blueWeight + 0.5f;
+    value = value < 0.0f ? 0.0f : value;
+    value = value > 255.0f ? 255.0f : value;
+    gray[i] = static_cast<uint8_t>(static_cast<int32_t>(value));
+  }
+}
+
+/**
+ * @brief Reads an 8 bit RGB or RGBA tile directly into a grayscale array, converting each strip of rows as it is read
+ * so that no full size color array is created.  Returns false without reading any pixels if the file is not an
+ * 8 bit RGB or RGBA 2D image, in which case the tile has to be read and converted by the sub filters.
+ */
+bool readGrayScaleTile(const QString& fileName, const QString& imageDataArrayName, const FloatVec3Type& colorWeights, DecodedTile& tile)
+{
+  const std::string filePath = fileName.toStdString();
+  itk::ImageIOBase::Pointer imageIO = itk::ImageIOFactory::CreateImageIO(filePath.c_str(), k_ReadMode);
+  if(nullptr == imageIO)
+  {
+    return false;
+  }
+  imageIO->SetFileName(filePath);
+  imageIO->ReadImageInformation();
+
+  const unsigned int dimensionCount = imageIO->GetNumberOfDimensions();
+  const size_t componentCount = imageIO->GetNumberOfComponents();
+  if(imageIO->GetComponentType() != k_UCharComponent || (componentCount != 3 && componentCount != 4) || dimensionCount < 2)
+  {
+    return false;
+  }
+  for(unsigned int d = 2; d < dimensionCount; d++)
+  {
+    if(imageIO->GetDimensions(d) != 1)
+    {
+      return false;
+    }
+  }
+
+  const size_t width = imageIO->GetDimensions(0);
+  const size_t height = imageIO->GetDimensions(1);
+  const size_t stripRows = imageIO->CanStreamRead() ? std::min(height, std::max<size_t>(1, k_ColorStripBytes / (width * componentCount))) : height;
+  imageIO->SetUseStreamedReading(stripRows < height);
+
+  UInt8ArrayType::Pointer grayArray = UInt8ArrayType::CreateArray(width * height, std::vector<size_t>{1}, imageDataArrayName, true);
+  std::vector<uint8_t> colorStrip(stripRows * width * componentCount);
+  const std::array<float, 3> weights = {colorWeights[0], colorWeights[1], colorWeights[2]};
+  for(size_t row = 0; row < height; row += stripRows)
+  {
+    const size_t rowCount = std::min(stripRows, height - row);
+    itk::ImageIORegion region(dimensionCount);
+    for(unsigned int d = 0; d < dimensionCount; d++)
+    {
+      region.SetIndex(d, 0);
+      region.SetSize(d, 1);
+    }
+    region.SetSize(0, width);
+    region.SetIndex(1, row);
+    region.SetSize(1, rowCount);
+    imageIO->SetIORegion(region);
+    imageIO->Read(colorStrip.data());
+
+    uint8_t* gray = grayArray->getPointer(row * width);
+    if(componentCount == 3)
+    {
+      convertColorToLuminance<3>(colorStrip.data(), rowCount * width, weights, gray);
+    }
+    else
+    {
+      convertColorToLuminance<4>(colorStrip.data(), rowCount * width, weights, gray);
+    }
+  }
+
+  tile.imageArray = grayArray;
+  return true;
+}
+
+/**
+ * @brief Reads one tile into its own DataContainerArray and returns the image array, converted to grayscale if requested.
+ * Safe to call from several threads at once.
+ */
+DecodedTile decodeTile(const QString& fileName, const QString& imageDataArrayName, bool convertToGrayScale, const FloatVec3Type& colorWeights, ITKPhaseTimer* timer)
+{
+  DecodedTile tile;
+  if(convertToGrayScale)
+  {
+    ITKPhaseTimer::Scope scope(timer, "read tile + grayscale convert");
+    if(readGrayScaleTile(fileName, imageDataArrayName, colorWeights, tile))
+    {
+      return tile;
+    }
+  }
+
+  DataArrayPath dap(k_TileDCName, ITKImageProcessing::Montage::k_AMName, imageDataArrayName);
+  ITKImageReader::Pointer imageReader = createImageReader(fileName, dap);
+  {
+    ITKPhaseTimer::Scope scope(timer, "read tile");
+    imageReader->execute();
+  }
+  if(imageReader->getErrorCode() < 0)
+  {
+    tile.errorCode = imageReader->getErrorCode();
+    tile.errorMessage = "Error Executing Image Import Filter.";
+    return tile;
+  }
+
+  DataContainerArray::Pointer tileDca = imageReader->getDataContainerArray();
+  AttributeMatrix::Pointer tileAttrMat = tileDca->getDataContainer(k_TileDCName)->getAttributeMatrix(ITKImageProcessing::Montage::k_AMName);
+  if(!convertToGrayScale)
+  {
+    tile.imageArray = tileAttrMat->removeAttributeArray(imageDataArrayName);
+    return tile;
+  }
+
+  ITKPhaseTimer::Scope scope(timer, "grayscale convert");
+  ConvertColorToGrayScale::Pointer grayScaleFilter = createColorToGrayScaleFilter(tileDca, dap, colorWeights, ITKImageProcessing::Montage::k_GrayScaleTempArrayName);
+  grayScaleFilter->execute();
+  if(grayScaleFilter->getErrorCode() < 0)
+  {
+    tile.errorCode = grayScaleFilter->getErrorCode();
+    tile.errorMessage = "Error Executing Color to GrayScale filter";
+    return tile;
+  }
+  tile.imageArray = tileAttrMat->removeAttributeArray(ITKImageProcessing::Montage::k_GrayScaleTempArrayName + imageDataArrayName);
+  tile.imageArray->setName(imageDataArrayName);
+  return tile;
+}
+
+/**
+ * @brief Calls decodeTile and turns an exception into an error so that a failing tile cannot leave the caller waiting.
+ */
+DecodedTile tryDecodeTile(const QString& fileName, const QString& imageDataArrayName, bool convertToGrayScale, const FloatVec3Type& colorWeights, ITKPhaseTimer* timer)
+{
+  try
+  {
+    return decodeTile(fileName, imageDataArrayName, convertToGrayScale, colorWeights, timer);
+  } catch(const std::exception& e)
+  {
+    DecodedTile tile;
+    tile.errorCode = -91010;
+    tile.errorMessage = QString("Error importing '%1': %2").arg(fileName).arg(e.what());
+    return tile;
+  }
+}
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -53,17 +279,10 @@ MontageImportHelper::~MontageImportHelper() = default;
 // -----------------------------------------------------------------------------
 ITKImageReader::Pointer MontageImportHelper::CreateImageImportFilter(AbstractFilter* filter, const QString& imageFileName, const DataArrayPath& daPath)
 {
-  ITKImageReader::Pointer imageReader = ITKImageReader::New();
+  ITKImageReader::Pointer imageReader = ::createImageReader(imageFileName, daPath);
 
   // Connect up the Error/Warning/Progress object so the filter can report those things
   QObject::connect(imageReader.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), filter, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
-  DataContainerArrayShPtr dca = DataContainerArray::New();
-
-  imageReader->setDataContainerArray(dca); // AbstractFilter implements this so no problem
-  imageReader->setFileName(imageFileName);
-  imageReader->setDataContainerName(daPath);
-  imageReader->setCellAttributeMatrixName(daPath.getAttributeMatrixName());
-  imageReader->setImageDataArrayName(daPath.getDataArrayName());
 
   return imageReader;
 }
@@ -74,20 +293,11 @@ ITKImageReader::Pointer MontageImportHelper::CreateImageImportFilter(AbstractFil
 ConvertColorToGrayScale::Pointer MontageImportHelper::CreateColorToGrayScaleFilter(AbstractFilter* filter, const DataArrayPath& daPath, const FloatVec3Type& colorWeights,
                                                                                    const QString& outputArrayName)
 {
-  ConvertColorToGrayScale::Pointer rgbToGray = ConvertColorToGrayScale::New();
+  ConvertColorToGrayScale::Pointer rgbToGray = ::createColorToGrayScaleFilter(filter->getDataContainerArray(), daPath, colorWeights, outputArrayName);
 
   // Connect up the Error/Warning/Progress object so the filter can report those things
   QObject::connect(rgbToGray.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), filter, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
 
-  rgbToGray->setDataContainerArray(filter->getDataContainerArray());
-  rgbToGray->setConversionAlgorithm(0);
-  rgbToGray->setColorWeights(colorWeights);
-  std::vector<DataArrayPath> inputDataArrayVector = {daPath};
-  rgbToGray->setInputDataArrayVector(inputDataArrayVector);
-  rgbToGray->setCreateNewAttributeMatrix(false);
-  rgbToGray->setOutputAttributeMatrixName(daPath.getAttributeMatrixName());
-  rgbToGray->setOutputArrayPrefix(outputArrayName);
-
   return rgbToGray;
 }
 
@@ -179,3 +389,62 @@ QString MontageImportHelper::GenerateDataContainerName(const QString& dataContai
   dcNameStream << col;
   return dcName;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MontageImportHelper::ImportTiles(AbstractFilter* filter, const std::vector<TileImport>& tiles, const QString& cellAttributeMatrixName, const QString& imageDataArrayName,
+                                      bool convertToGrayScale, const FloatVec3Type& colorWeights, ITKPhaseTimer* timer)
+{
+  DataContainerArray::Pointer dca = filter->getDataContainerArray();
+
+  auto attachTile = [&](size_t index, DecodedTile& tile) {
+    if(tile.errorCode < 0)
+    {
+      filter->setErrorCondition(tile.errorCode, tile.errorMessage);
+      return;
+    }
+    ITKPhaseTimer::Scope scope(timer, "attach");
+    // The DataContainer and its Cell AttributeMatrix were created in the preflight
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(tiles[index].dataContainerName)->getAttributeMatrix(cellAttributeMatrixName);
+    cellAttrMat->addOrReplaceAttributeArray(tile.imageArray);
+    tile.imageArray = nullptr;
+  };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  const size_t threadCount = static_cast<size_t>(std::max(1, tbb::this_task_arena::max_concurrency()));
+  if(threadCount > 1 && tiles.size() > 1)
+  {
+    // Tiles are decoded in waves of two per thread.  task_group::wait lets the calling thread decode tiles of
+    // the wave too, so the import cannot stall in a limited or nested arena.  Messages and attachment stay on
+    // the calling thread.
+    const size_t window = 2 * threadCount;
+    std::vector<DecodedTile> decodedTiles(window);
+    tbb::task_group taskGroup;
+    for(size_t first = 0; first < tiles.size() && !filter->getCancel(); first += window)
+    {
+      const size_t count = std::min(window, tiles.size() - first);
+      for(size_t i = 0; i < count; i++)
+      {
+        filter->notifyStatusMessage(QString("Importing %1").arg(tiles[first + i].fileName));
+        taskGroup.run([&, first, i]() { decodedTiles[i] = ::tryDecodeTile(tiles[first + i].fileName, imageDataArrayName, convertToGrayScale, colorWeights, timer); });
+      }
+      taskGroup.wait();
+
+      for(size_t i = 0; i < count; i++)
+      {
+        attachTile(first + i, decodedTiles[i]);
+        decodedTiles[i] = DecodedTile();
+      }
+    }
+    return;
+  }
+#endif
+
+  for(size_t index = 0; index < tiles.size() && !filter->getCancel(); index++)
+  {
+    filter->notifyStatusMessage(QString("Importing %1").arg(tiles[index].fileName));
+    DecodedTile tile = ::tryDecodeTile(tiles[index].fileName, imageDataArrayName, convertToGrayScale, colorWeights, timer);
+    attachTile(index, tile);
+  }
+}
@@ -31,15 +31,28 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <vector>
+
 #include "SIMPLib/CoreFilters/ConvertColorToGrayScale.h"
 
 #include "ITKImageProcessing/ITKImageProcessingFilters/ITKImageReader.h"
 #include "ITKImageProcessing/ITKImageProcessingPlugin.h"
 
+class ITKPhaseTimer;
+
 class ITKImageProcessing_EXPORT MontageImportHelper
 {
 
 public:
+  /**
+   * @brief The TileImport struct names the image file of a tile and the DataContainer that receives its image.
+   */
+  struct TileImport
+  {
+    QString fileName;
+    QString dataContainerName;
+  };
+
   /**
    * @brief CreateImageImportFilter
    * @param filter
@@ -87,6 +100,28 @@ public:
    */
   static QString GenerateDataContainerName(const QString& dataContainerPrefix, const IntVec2Type& montageMaxValues, int32_t row, int32_t col);
 
+  /**
+   * @brief Reads the image file of each tile, optionally converts it to grayscale and moves the image array into the
+   * Cell AttributeMatrix of the tile's DataContainer, which must already exist.  The files are decoded and converted
+   * concurrently in waves of two tiles per thread, so memory stays bounded for large montages.  The calling thread
+   * helps decode each wave and then attaches its arrays in the order of the tiles.  A tile that fails sets the error
+   * condition of filter without stopping the other tiles.
+   *
+   * 8 bit RGB and RGBA tiles that are converted to grayscale go straight from the ImageIO buffer into the grayscale
+   * array, in strips of rows when the file format can stream, so no color DataArray is created.  Other tiles are read
+   * and converted by the ITKImageReader and ConvertColorToGrayScale filters.
+   * @param filter
+   * @param tiles
+   * @param cellAttributeMatrixName
+   * @param imageDataArrayName
+   * @param convertToGrayScale
+   * @param colorWeights
+   * @param timer Records the "read tile", "grayscale convert", "read tile + grayscale convert" and "attach" phases.
+   * May be a nullptr.
+   */
+  static void ImportTiles(AbstractFilter* filter, const std::vector<TileImport>& tiles, const QString& cellAttributeMatrixName, const QString& imageDataArrayName, bool convertToGrayScale,
+                          const FloatVec3Type& colorWeights, ITKPhaseTimer* timer = nullptr);
+
 protected:
   MontageImportHelper();
   ~MontageImportHelper();
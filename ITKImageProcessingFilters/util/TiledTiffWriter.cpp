@@ -0,0 +1,464 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "TiledTiffWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryFile>
+
+#include "itk_tiff.h"
+
+namespace
+{
+TIFF* toTiff(void* tiff)
+{
+  return static_cast<TIFF*>(tiff);
+}
+
+// -----------------------------------------------------------------------------
+// Averages each block of 2 x 2 pixels of rowCount rows that are width pixels wide into one pixel.  A last odd
+// row or column is averaged on its own.
+// -----------------------------------------------------------------------------
+template <typename T>
+void downsampleRows(const uint8_t* source, uint32_t width, uint32_t rowCount, uint16_t componentCount, uint8_t* destination)
+{
+  const T* input = reinterpret_cast<const T*>(source);
+  T* output = reinterpret_cast<T*>(destination);
+  const uint32_t outputWidth = (width + 1) / 2;
+  const uint32_t outputRowCount = (rowCount + 1) / 2;
+  for(uint32_t outputRow = 0; outputRow < outputRowCount; outputRow++)
+  {
+    const uint32_t row = 2 * outputRow;
+    const uint32_t rows = std::min(2U, rowCount - row);
+    for(uint32_t outputColumn = 0; outputColumn < outputWidth; outputColumn++)
+    {
+      const uint32_t column = 2 * outputColumn;
+      const uint32_t columns = std::min(2U, width - column);
+      for(uint16_t c = 0; c < componentCount; c++)
+      {
+        double sum = 0.0;
+        for(uint32_t r = 0; r < rows; r++)
+        {
+          for(uint32_t x = 0; x < columns; x++)
+          {
+            sum += static_cast<double>(input[((row + r) * static_cast<size_t>(width) + column + x) * componentCount + c]);
+          }
+        }
+        double mean = sum / (rows * columns);
+        T* value = output + (outputRow * static_cast<size_t>(outputWidth) + outputColumn) * componentCount + c;
+        *value = std::is_integral<T>::value ? static_cast<T>(std::floor(mean + 0.5)) : static_cast<T>(mean);
+      }
+    }
+  }
+}
+} // namespace
+
+/**
+ * @brief The PyramidLevel struct holds the rows of one reduced resolution level that do not fill a band of tile
+ * rows yet, and the temporary file the complete bands are kept in until the level is written.
+ */
+struct TiledTiffWriter::PyramidLevel
+{
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t rowsReceived = 0;
+  uint32_t pendingRowCount = 0;
+  std::vector<uint8_t> pendingRows;
+  QTemporaryFile file;
+};
+
+// -----------------------------------------------------------------------------
+TiledTiffWriter::TiledTiffWriter() = default;
+
+// -----------------------------------------------------------------------------
+TiledTiffWriter::~TiledTiffWriter()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::open(const QString& filePath)
+{
+  close();
+  m_FilePath = filePath;
+  // "w8" writes a BigTIFF so the file may grow past 4 GB
+  m_Tiff = TIFFOpen(filePath.toLocal8Bit().constData(), "w8");
+  if(nullptr == m_Tiff)
+  {
+    m_ErrorMessage = QString("Could not create the file '%1'").arg(filePath);
+    // Nothing was written, so discard() must not delete a file that was already there
+    m_FilePath.clear();
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::beginImage(uint32_t width, uint32_t height, uint16_t componentCount, uint16_t bytesPerComponent, SampleFormat format, uint32_t pyramidLevels)
+{
+  if(nullptr == m_Tiff || m_ImageBegun)
+  {
+    m_ErrorMessage = QString("An image can only be started in an open file after the previous image was ended");
+    return false;
+  }
+
+  m_Width = width;
+  m_Height = height;
+  m_ComponentCount = componentCount;
+  m_BytesPerComponent = bytesPerComponent;
+  m_SampleFormat = format;
+  m_PixelSize = static_cast<size_t>(componentCount) * bytesPerComponent;
+  if(!writeImageHeader(width, height, false))
+  {
+    return false;
+  }
+
+  m_PyramidLevels.clear();
+  QFileInfo fi(m_FilePath);
+  QString fileTemplate = fi.absoluteDir().filePath(fi.completeBaseName() + "_level_XXXXXX.tmp");
+  for(uint32_t level = 0; level < pyramidLevels; level++)
+  {
+    uint32_t levelWidth = level == 0 ? width : m_PyramidLevels.back()->width;
+    uint32_t levelHeight = level == 0 ? height : m_PyramidLevels.back()->height;
+    std::unique_ptr<PyramidLevel> pyramidLevel(new PyramidLevel);
+    pyramidLevel->width = (levelWidth + 1) / 2;
+    pyramidLevel->height = (levelHeight + 1) / 2;
+    pyramidLevel->file.setFileTemplate(fileTemplate);
+    if(!pyramidLevel->file.open())
+    {
+      m_ErrorMessage = QString("Could not create a temporary file for pyramid level %1 next to the file '%2'").arg(level + 1).arg(m_FilePath);
+      m_PyramidLevels.clear();
+      return false;
+    }
+    m_PyramidLevels.push_back(std::move(pyramidLevel));
+  }
+
+  m_ImageBegun = true;
+  m_NextRow = 0;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::writeBand(uint32_t firstRow, uint32_t rowCount, const void* data)
+{
+  if(!m_ImageBegun)
+  {
+    m_ErrorMessage = QString("A band can only be written after the image was started");
+    return false;
+  }
+  uint32_t endRow = firstRow + rowCount;
+  if(firstRow != m_NextRow || endRow > m_Height || (rowCount % k_TileSize != 0 && endRow != m_Height))
+  {
+    m_ErrorMessage = QString("Rows %1 to %2 cannot be written. Bands must continue the image at row %3 and all but the last band must be a multiple of %4 rows high")
+                         .arg(firstRow)
+                         .arg(endRow)
+                         .arg(m_NextRow)
+                         .arg(k_TileSize);
+    return false;
+  }
+
+  const uint8_t* band = static_cast<const uint8_t*>(data);
+  if(!writeTiles(m_Width, firstRow, rowCount, band))
+  {
+    return false;
+  }
+  if(!m_PyramidLevels.empty() && !addPyramidRows(0, rowCount, band))
+  {
+    return false;
+  }
+  m_NextRow = endRow;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::endImage()
+{
+  if(!m_ImageBegun)
+  {
+    m_ErrorMessage = QString("An image can only be ended after it was started");
+    return false;
+  }
+  m_ImageBegun = false;
+  if(m_NextRow != m_Height)
+  {
+    m_ErrorMessage = QString("Only %1 of the %2 rows of the image were written to the file '%3'").arg(m_NextRow).arg(m_Height).arg(m_FilePath);
+    m_PyramidLevels.clear();
+    return false;
+  }
+  if(TIFFWriteDirectory(toTiff(m_Tiff)) != 1)
+  {
+    m_ErrorMessage = QString("Could not finish the image in the file '%1'").arg(m_FilePath);
+    m_PyramidLevels.clear();
+    return false;
+  }
+  bool ok = writePyramidLevels();
+  m_PyramidLevels.clear();
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::close()
+{
+  if(nullptr == m_Tiff)
+  {
+    return true;
+  }
+  bool ok = !m_ImageBegun || endImage();
+  TIFFClose(toTiff(m_Tiff));
+  m_Tiff = nullptr;
+  m_TileBuffer.clear();
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+void TiledTiffWriter::discard()
+{
+  m_ImageBegun = false;
+  m_PyramidLevels.clear();
+  if(nullptr != m_Tiff)
+  {
+    TIFFClose(toTiff(m_Tiff));
+    m_Tiff = nullptr;
+  }
+  m_TileBuffer.clear();
+  if(!m_FilePath.isEmpty())
+  {
+    QFile::remove(m_FilePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::writeImageHeader(uint32_t width, uint32_t height, bool reducedResolution)
+{
+  TIFF* tiff = toTiff(m_Tiff);
+  uint16_t sampleFormat = SAMPLEFORMAT_UINT;
+  if(m_SampleFormat == SampleFormat::SignedInteger)
+  {
+    sampleFormat = SAMPLEFORMAT_INT;
+  }
+  else if(m_SampleFormat == SampleFormat::Float)
+  {
+    sampleFormat = SAMPLEFORMAT_IEEEFP;
+  }
+
+  bool ok = TIFFSetField(tiff, TIFFTAG_SUBFILETYPE, reducedResolution ? FILETYPE_REDUCEDIMAGE : 0) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, width) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, height) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, m_ComponentCount) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, static_cast<uint16_t>(8 * m_BytesPerComponent)) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_SAMPLEFORMAT, sampleFormat) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, m_ComponentCount >= 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_COMPRESSION, COMPRESSION_NONE) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_TILEWIDTH, k_TileSize) == 1;
+  ok = ok && TIFFSetField(tiff, TIFFTAG_TILELENGTH, k_TileSize) == 1;
+  if(m_ComponentCount == 4)
+  {
+    uint16_t extraSample = EXTRASAMPLE_UNASSALPHA;
+    ok = ok && TIFFSetField(tiff, TIFFTAG_EXTRASAMPLES, 1, &extraSample) == 1;
+  }
+  if(!ok)
+  {
+    m_ErrorMessage = QString("Could not write the image header to the file '%1'").arg(m_FilePath);
+    return false;
+  }
+  m_TileBuffer.resize(k_TileSize * k_TileSize * m_PixelSize);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::writeTiles(uint32_t width, uint32_t firstRow, uint32_t rowCount, const uint8_t* data)
+{
+  TIFF* tiff = toTiff(m_Tiff);
+  size_t rowSize = width * m_PixelSize;
+  uint32_t endRow = firstRow + rowCount;
+  for(uint32_t tileRow = firstRow; tileRow < endRow; tileRow += k_TileSize)
+  {
+    uint32_t rows = std::min(k_TileSize, endRow - tileRow);
+    for(uint32_t tileColumn = 0; tileColumn < width; tileColumn += k_TileSize)
+    {
+      uint32_t columns = std::min(k_TileSize, width - tileColumn);
+      if(rows < k_TileSize || columns < k_TileSize)
+      {
+        std::fill(m_TileBuffer.begin(), m_TileBuffer.end(), 0);
+      }
+      for(uint32_t r = 0; r < rows; r++)
+      {
+        const uint8_t* source = data + (tileRow - firstRow + r) * rowSize + tileColumn * m_PixelSize;
+        std::memcpy(m_TileBuffer.data() + r * k_TileSize * m_PixelSize, source, columns * m_PixelSize);
+      }
+      if(TIFFWriteEncodedTile(tiff, TIFFComputeTile(tiff, tileColumn, tileRow, 0, 0), m_TileBuffer.data(), static_cast<tmsize_t>(m_TileBuffer.size())) < 0)
+      {
+        m_ErrorMessage = QString("Could not write the tile at row %1 column %2 to the file '%3'").arg(tileRow).arg(tileColumn).arg(m_FilePath);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::addPyramidRows(size_t levelIndex, uint32_t rowCount, const uint8_t* data)
+{
+  PyramidLevel& level = *m_PyramidLevels[levelIndex];
+  uint32_t sourceWidth = levelIndex == 0 ? m_Width : m_PyramidLevels[levelIndex - 1]->width;
+  uint32_t outputRowCount = (rowCount + 1) / 2;
+  size_t rowSize = level.width * m_PixelSize;
+
+  // Complete bands of tile rows are always an even number of rows high, so no 2 x 2 block is split between calls
+  level.pendingRows.resize((level.pendingRowCount + outputRowCount) * rowSize);
+  uint8_t* destination = level.pendingRows.data() + level.pendingRowCount * rowSize;
+  switch(m_SampleFormat)
+  {
+  case SampleFormat::UnsignedInteger:
+    switch(m_BytesPerComponent)
+    {
+    case 1:
+      downsampleRows<uint8_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    case 2:
+      downsampleRows<uint16_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    case 4:
+      downsampleRows<uint32_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    default:
+      downsampleRows<uint64_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    }
+    break;
+  case SampleFormat::SignedInteger:
+    switch(m_BytesPerComponent)
+    {
+    case 1:
+      downsampleRows<int8_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    case 2:
+      downsampleRows<int16_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    case 4:
+      downsampleRows<int32_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    default:
+      downsampleRows<int64_t>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+      break;
+    }
+    break;
+  case SampleFormat::Float:
+    if(m_BytesPerComponent == 4)
+    {
+      downsampleRows<float>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+    }
+    else
+    {
+      downsampleRows<double>(data, sourceWidth, rowCount, m_ComponentCount, destination);
+    }
+    break;
+  }
+  level.pendingRowCount += outputRowCount;
+  level.rowsReceived += outputRowCount;
+
+  // Keep complete bands of tile rows and pass them on to the next level
+  uint32_t bandRowCount = level.pendingRowCount / k_TileSize * k_TileSize;
+  if(level.rowsReceived == level.height)
+  {
+    bandRowCount = level.pendingRowCount;
+  }
+  if(bandRowCount == 0)
+  {
+    return true;
+  }
+  qint64 bandSize = static_cast<qint64>(bandRowCount * rowSize);
+  if(level.file.write(reinterpret_cast<const char*>(level.pendingRows.data()), bandSize) != bandSize)
+  {
+    m_ErrorMessage = QString("Could not write pyramid level %1 to the temporary file '%2'").arg(levelIndex + 1).arg(level.file.fileName());
+    return false;
+  }
+  if(levelIndex + 1 < m_PyramidLevels.size() && !addPyramidRows(levelIndex + 1, bandRowCount, level.pendingRows.data()))
+  {
+    return false;
+  }
+  level.pendingRows.erase(level.pendingRows.begin(), level.pendingRows.begin() + bandSize);
+  level.pendingRowCount -= bandRowCount;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool TiledTiffWriter::writePyramidLevels()
+{
+  for(size_t levelIndex = 0; levelIndex < m_PyramidLevels.size(); levelIndex++)
+  {
+    PyramidLevel& level = *m_PyramidLevels[levelIndex];
+    if(!writeImageHeader(level.width, level.height, true))
+    {
+      return false;
+    }
+
+    size_t rowSize = level.width * m_PixelSize;
+    std::vector<uint8_t> band;
+    level.file.seek(0);
+    for(uint32_t firstRow = 0; firstRow < level.height; firstRow += k_TileSize)
+    {
+      uint32_t rowCount = std::min(k_TileSize, level.height - firstRow);
+      qint64 bandSize = static_cast<qint64>(rowCount * rowSize);
+      band.resize(bandSize);
+      if(level.file.read(reinterpret_cast<char*>(band.data()), bandSize) != bandSize)
+      {
+        m_ErrorMessage = QString("Could not read pyramid level %1 from the temporary file '%2'").arg(levelIndex + 1).arg(level.file.fileName());
+        return false;
+      }
+      if(!writeTiles(level.width, firstRow, rowCount, band.data()))
+      {
+        return false;
+      }
+    }
+
+    if(TIFFWriteDirectory(toTiff(m_Tiff)) != 1)
+    {
+      m_ErrorMessage = QString("Could not finish pyramid level %1 in the file '%2'").arg(levelIndex + 1).arg(m_FilePath);
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+QString TiledTiffWriter::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
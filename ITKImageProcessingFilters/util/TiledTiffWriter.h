@@ -0,0 +1,168 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "ITKImageProcessing/ITKImageProcessingDLLExport.h"
+
+/**
+ * @brief The TiledTiffWriter class writes a large 2D image to a tiled BigTIFF file one band of rows at a time, so
+ * only the band being written has to be in memory.  Each band is cut into tiles of k_TileSize x k_TileSize pixels
+ * that are written as soon as the band arrives.  Bands must start on a multiple of k_TileSize rows; every band but
+ * the last must also be a multiple of k_TileSize rows high.
+ *
+ * Usage: open(), then beginImage(), writeBand() for all the rows from top to bottom, endImage(), and close().  If
+ * the image cannot be finished, discard() closes the file and deletes it so no partial file is left behind.
+ *
+ * An image may be given reduced resolution pyramid levels, each half the width and height of the previous one.  The
+ * bands are averaged down into every level while they are written, and each level is appended to the file as a tiled
+ * reduced resolution image after its full resolution image, so the full resolution rows are only visited once.  Until
+ * then the levels are kept in temporary files next to the output file.
+ */
+class ITKImageProcessing_EXPORT TiledTiffWriter
+{
+public:
+  enum class SampleFormat : int
+  {
+    UnsignedInteger = 0,
+    SignedInteger = 1,
+    Float = 2
+  };
+
+  static constexpr uint32_t k_TileSize = 256;
+
+  TiledTiffWriter();
+  ~TiledTiffWriter();
+
+  /**
+   * @brief Creates the file, replacing any existing file.
+   * @param filePath
+   * @return false if the file could not be created
+   */
+  bool open(const QString& filePath);
+
+  /**
+   * @brief Starts a new image in the file.
+   * @param width
+   * @param height
+   * @param componentCount 1 for gray scale, 3 for RGB and 4 for RGBA
+   * @param bytesPerComponent
+   * @param format
+   * @param pyramidLevels The number of reduced resolution levels to add
+   * @return false if the image could not be started
+   */
+  bool beginImage(uint32_t width, uint32_t height, uint16_t componentCount, uint16_t bytesPerComponent, SampleFormat format, uint32_t pyramidLevels = 0);
+
+  /**
+   * @brief Writes rowCount rows starting at firstRow.  data holds the rows one after the other with the components
+   * of each pixel interleaved.
+   * @param firstRow
+   * @param rowCount
+   * @param data
+   * @return false if the band could not be written
+   */
+  bool writeBand(uint32_t firstRow, uint32_t rowCount, const void* data);
+
+  /**
+   * @brief Finishes the current image and writes its pyramid levels.
+   * @return false if the image could not be written
+   */
+  bool endImage();
+
+  /**
+   * @brief Closes the file.  An image that was begun but not ended is ended first.
+   * @return false if the file could not be finished
+   */
+  bool close();
+
+  /**
+   * @brief Closes the file without finishing the current image and deletes it along with the temporary pyramid
+   * level files.
+   */
+  void discard();
+
+  /**
+   * @brief Returns the description of the last failure.
+   * @return
+   */
+  QString getErrorMessage() const;
+
+public:
+  TiledTiffWriter(const TiledTiffWriter&) = delete;            // Copy Constructor Not Implemented
+  TiledTiffWriter(TiledTiffWriter&&) = delete;                 // Move Constructor Not Implemented
+  TiledTiffWriter& operator=(const TiledTiffWriter&) = delete; // Copy Assignment Not Implemented
+  TiledTiffWriter& operator=(TiledTiffWriter&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  struct PyramidLevel;
+
+  /**
+   * @brief Writes the tags of an image of the given size.
+   */
+  bool writeImageHeader(uint32_t width, uint32_t height, bool reducedResolution);
+
+  /**
+   * @brief Writes rowCount rows starting at firstRow of an image that is width pixels wide as tiles.
+   */
+  bool writeTiles(uint32_t width, uint32_t firstRow, uint32_t rowCount, const uint8_t* data);
+
+  /**
+   * @brief Averages rowCount rows of the level above into the pyramid level at levelIndex and passes on every
+   * complete band of tile rows.
+   */
+  bool addPyramidRows(size_t levelIndex, uint32_t rowCount, const uint8_t* data);
+
+  /**
+   * @brief Appends every pyramid level to the file as a reduced resolution image.
+   */
+  bool writePyramidLevels();
+
+  void* m_Tiff = nullptr;
+  QString m_FilePath;
+  QString m_ErrorMessage;
+
+  bool m_ImageBegun = false;
+  uint32_t m_Width = 0;
+  uint32_t m_Height = 0;
+  uint16_t m_ComponentCount = 0;
+  uint16_t m_BytesPerComponent = 0;
+  SampleFormat m_SampleFormat = SampleFormat::UnsignedInteger;
+  size_t m_PixelSize = 0;
+  uint32_t m_NextRow = 0;
+  std::vector<uint8_t> m_TileBuffer;
+  std::vector<std::unique_ptr<PyramidLevel>> m_PyramidLevels;
+};
@@ -0,0 +1,229 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include "tbb/queuing_mutex.h"
+#endif
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Utilities/ParallelData2DAlgorithm.h"
+
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTDewarpHelper.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/FFTImageOverlapGenerator.h"
+
+/**
+ * This micro-benchmark measures the pixel throughput of the two per-pixel kernels used by the
+ * FFTConvolutionCostFunction on synthetic 8-bit tiles.  Each kernel is compared against the
+ * GetPixel / SetPixel implementation it replaced, which is kept here as the baseline.
+ */
+namespace
+{
+using Grayscale_T = uint8_t;
+using PixelValue_T = Grayscale_T;
+using InputImage = itk::Image<PixelValue_T, 2>;
+using PixelCoord = InputImage::IndexType;
+using ParametersType = itk::SingleValuedCostFunction::ParametersType;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t k_TileWidth = 2048;
+constexpr size_t k_TileHeight = 2048;
+constexpr size_t k_OverlapWidth = 256;
+constexpr size_t k_Iterations = 20;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+using MutexType = tbb::queuing_mutex;
+using ScopedLockType = MutexType::scoped_lock;
+#else
+using MutexType = int;
+using ScopedLockType = int;
+#endif
+
+/**
+ * @brief Baseline tile initialization using the virtual DataArray accessor and itk::Image::SetPixel.
+ */
+class LegacyImageInitializer
+{
+public:
+  LegacyImageInitializer(const InputImage::Pointer& image, size_t width, const DataArray<Grayscale_T>::Pointer& dataArray)
+  : m_Image(image)
+  , m_Width(width)
+  , m_DataArray(dataArray)
+  {
+  }
+
+  void operator()(const SIMPLRange2D& range) const
+  {
+    const auto index = m_Image->GetRequestedRegion().GetIndex();
+    for(size_t y = range.minRow(); y < range.maxRow(); y++)
+    {
+      for(size_t x = range.minCol(); x < range.maxCol(); x++)
+      {
+        PixelCoord idx;
+        idx[0] = x + index[0];
+        idx[1] = y + index[1];
+        m_Image->SetPixel(idx, m_DataArray->getValue(x + y * m_Width));
+      }
+    }
+  }
+
+private:
+  InputImage::Pointer m_Image;
+  size_t m_Width;
+  DataArray<Grayscale_T>::Pointer m_DataArray;
+};
+
+/**
+ * @brief Baseline overlap generation using GetPixel / SetPixel and a mutex for every invalid pixel.
+ */
+class LegacyOverlapGenerator
+{
+public:
+  LegacyOverlapGenerator(const InputImage::Pointer& baseImg, const InputImage::Pointer& image, const PixelCoord& offset, const ParametersType& parameters, RegionBounds& bounds)
+  : m_BaseImg(baseImg)
+  , m_Image(image)
+  , m_Parameters(parameters)
+  , m_Bounds(bounds)
+  {
+    m_Offset = FFTDewarpHelper::pixelIndex((k_TileWidth - 1) / 2.0 - offset[0], (k_TileHeight - 1) / 2.0 - offset[1]);
+  }
+
+  void operator()(const SIMPLRange2D& range) const
+  {
+    static MutexType mutex;
+    const InputImage::RegionType baseRegion = m_BaseImg->GetRequestedRegion();
+    for(size_t y = range.minRow(); y < range.maxRow(); y++)
+    {
+      for(size_t x = range.minCol(); x < range.maxCol(); x++)
+      {
+        PixelCoord newIndex{static_cast<int64_t>(x), static_cast<int64_t>(y)};
+        FFTDewarpHelper::PixelIndex old = FFTDewarpHelper::getOldIndex(FFTDewarpHelper::pixelIndex(x, y), m_Offset, m_Parameters);
+        PixelCoord oldIndex{old[0], old[1]};
+        PixelValue_T pixel{0};
+        if(baseRegion.IsInside(oldIndex))
+        {
+          pixel = m_BaseImg->GetPixel(oldIndex);
+        }
+        else
+        {
+          ScopedLockType scopedLock(mutex);
+          m_Bounds.leftBound = std::max(m_Bounds.leftBound, static_cast<int64_t>(newIndex[0]));
+        }
+        m_Image->SetPixel(newIndex, pixel);
+      }
+    }
+  }
+
+private:
+  InputImage::Pointer m_BaseImg;
+  InputImage::Pointer m_Image;
+  FFTDewarpHelper::PixelIndex m_Offset;
+  ParametersType m_Parameters;
+  RegionBounds& m_Bounds;
+};
+
+/**
+ * @brief Runs the kernel k_Iterations times over the given range and reports the pixel throughput.
+ */
+template <typename KernelFactory>
+double measure(const std::string& name, size_t rowStart, size_t colStart, size_t rowEnd, size_t colEnd, KernelFactory createKernel)
+{
+  ParallelData2DAlgorithm dataAlg;
+  dataAlg.setRange(rowStart, colStart, rowEnd, colEnd);
+
+  const auto start = Clock::now();
+  for(size_t i = 0; i < k_Iterations; i++)
+  {
+    dataAlg.execute(createKernel());
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  const double pixels = static_cast<double>((rowEnd - rowStart) * (colEnd - colStart) * k_Iterations);
+  const double pixelsPerSecond = pixels / elapsed.count();
+  std::cout << "  " << name << ": " << static_cast<uint64_t>(pixelsPerSecond) << " pixels/s" << std::endl;
+  return pixelsPerSecond;
+}
+
+InputImage::Pointer createImage(const PixelCoord& index, size_t width, size_t height)
+{
+  InputImage::SizeType size;
+  size[0] = width;
+  size[1] = height;
+  InputImage::Pointer image = InputImage::New();
+  image->SetRegions(InputImage::RegionType(index, size));
+  image->Allocate();
+  return image;
+}
+} // namespace
+
+int main()
+{
+  DataArray<Grayscale_T>::Pointer tile = DataArray<Grayscale_T>::CreateArray(k_TileWidth * k_TileHeight, std::string("Tile"), true);
+  for(size_t i = 0; i < tile->getNumberOfTuples(); i++)
+  {
+    tile->setValue(i, static_cast<Grayscale_T>((i * 31) % 251));
+  }
+
+  std::cout << "Tile initialization (" << k_TileWidth << "x" << k_TileHeight << " uint8)" << std::endl;
+  InputImage::Pointer baseImage = createImage({0, 0}, k_TileWidth, k_TileHeight);
+  double before = measure("GetValue/SetPixel", 0, 0, k_TileHeight, k_TileWidth, [&]() { return LegacyImageInitializer(baseImage, k_TileWidth, tile); });
+  double after = measure("Direct buffer", 0, 0, k_TileHeight, k_TileWidth, [&]() { return FFTImageInitializer<PixelValue_T>(baseImage, k_TileWidth, tile); });
+  std::cout << "  Speedup: " << after / before << "x" << std::endl;
+
+  // A right-hand overlap strip with a mild barrel distortion so that a band of pixels falls outside of the tile.
+  ParametersType parameters(FFTDewarpHelper::getReqParameterSize());
+  parameters.Fill(0.0);
+  parameters[0] = 1.0;
+  parameters[2] = 1.0e-5;
+  parameters[8] = 1.0;
+  parameters[10] = 1.0e-5;
+
+  const PixelCoord overlapIndex{static_cast<int64_t>(k_TileWidth - k_OverlapWidth), 0};
+  InputImage::Pointer overlapImage = createImage(overlapIndex, k_OverlapWidth, k_TileHeight);
+  const size_t rowStart = overlapIndex[1];
+  const size_t colStart = overlapIndex[0];
+
+  std::cout << "Overlap generation (" << k_OverlapWidth << "x" << k_TileHeight << " uint8)" << std::endl;
+  RegionBounds legacyBounds;
+  before = measure("GetPixel/SetPixel", rowStart, colStart, rowStart + k_TileHeight, colStart + k_OverlapWidth,
+                   [&]() { return LegacyOverlapGenerator(baseImage, overlapImage, overlapIndex, parameters, legacyBounds); });
+  RegionBoundsAccumulator threadBounds;
+  after = measure("Direct buffer", rowStart, colStart, rowStart + k_TileHeight, colStart + k_OverlapWidth, [&]() {
+    return FFTImageOverlapGenerator<PixelValue_T>(baseImage, overlapImage, overlapIndex, k_TileWidth, k_TileHeight, parameters, threadBounds, FFTDewarpHelper::InterpolationType::NearestNeighbor);
+  });
+  std::cout << "  Speedup: " << after / before << "x" << std::endl;
+
+  return 0;
+}
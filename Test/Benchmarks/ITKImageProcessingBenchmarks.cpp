@@ -0,0 +1,894 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+// psapi.h must come after windows.h
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+
+#include <itkConfigure.h>
+#include <itkImage.h>
+#include <itkImageFileWriter.h>
+#include <itkVersion.h>
+#if ITK_VERSION_MAJOR >= 5
+#include <itkMultiThreaderBase.h>
+#else
+#include <itkMultiThreader.h>
+#endif
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/MontageSelection.h"
+
+#include "ITKImageProcessing/ITKImageProcessingFilters/ApplyDewarpParameters.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/CalcDewarpParameters.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/ITKImportFijiMontage.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/ITKStitchMontage.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/MetaXmlUtils.h"
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKPhaseTimer.h"
+#include "ITKImageProcessing/ITKImageProcessingVersion.h"
+
+/**
+ * This benchmark runs the filters of the plugin on synthetic data and reports the results as JSON so that
+ * the performance of two plugin versions can be compared:
+ *   - every ITKImageProcessingBase filter on 2D and 3D volumes of the requested sizes and pixel types,
+ *   - the Fiji montage import, the dewarp calculation and application, and the stitching of a synthetic
+ *     montage written to a temporary directory,
+ *   - every filter of the pipeline files given on the command line, which covers the other importers on
+ *     real data sets.
+ * Each benchmark is repeated at every requested thread count.  The wall time, the peak resident set size,
+ * the throughput and the speedup over the smallest thread count are reported for each run.
+ */
+namespace
+{
+using Clock = std::chrono::steady_clock;
+using Volume = std::array<size_t, 3>;
+
+const QString k_DataContainerName("Benchmark");
+const QString k_AttributeMatrixName("Cell Data");
+const QString k_InputArrayName("Input");
+const QString k_OutputArrayName("Output");
+const QString k_MontageName("Benchmark Montage");
+const QString k_TilePrefix("Mosaic_");
+const QString k_TileAttributeMatrixName("Tile Data");
+const QString k_TileArrayName("Image");
+
+struct Options
+{
+  std::vector<Volume> volumes;
+  QStringList pixelTypes;
+  std::vector<int> threads;
+  QRegularExpression filterPattern;
+  int repetitions = 3;
+  bool runFilters = true;
+  bool runMontage = true;
+  int tileRows = 3;
+  int tileColumns = 3;
+  size_t tileSize = 1024;
+  QStringList pipelineFiles;
+  QString outputFile;
+  QString traceDirectory;
+};
+
+/**
+ * @brief The wall times and peak memory of the repetitions of one benchmark.
+ */
+struct Measurement
+{
+  std::vector<double> times;
+  uint64_t peakMemory = 0;
+  int errorCode = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Peak resident set size
+// -----------------------------------------------------------------------------
+/**
+ * @brief Resets the peak resident set size so that the next reading covers only the following run.  Only
+ * Linux supports this; other platforms report the peak of the whole process.
+ */
+void resetPeakMemory()
+{
+#if defined(__linux__)
+  QFile clearRefs("/proc/self/clear_refs");
+  if(clearRefs.open(QIODevice::WriteOnly))
+  {
+    clearRefs.write("5");
+  }
+#endif
+}
+
+/**
+ * @brief Returns the peak resident set size in bytes.
+ */
+uint64_t getPeakMemory()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) != 0)
+  {
+    return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#elif defined(__linux__)
+  QFile status("/proc/self/status");
+  if(status.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    QTextStream stream(&status);
+    for(QString line = stream.readLine(); !line.isNull(); line = stream.readLine())
+    {
+      if(line.startsWith("VmHWM:"))
+      {
+        return line.mid(6).remove("kB").trimmed().toULongLong() * 1024;
+      }
+    }
+  }
+  return 0;
+#else
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  // macOS reports bytes
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Thread limits
+// -----------------------------------------------------------------------------
+/**
+ * @brief Limits the ITK filters created while the object is alive to a number of threads.
+ */
+class ScopedITKThreadLimit
+{
+public:
+  explicit ScopedITKThreadLimit(int threads)
+  {
+#if ITK_VERSION_MAJOR >= 5
+    m_Previous = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(static_cast<itk::ThreadIdType>(threads));
+#else
+    m_Previous = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+    itk::MultiThreader::SetGlobalDefaultNumberOfThreads(static_cast<itk::ThreadIdType>(threads));
+#endif
+  }
+
+  ~ScopedITKThreadLimit()
+  {
+#if ITK_VERSION_MAJOR >= 5
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(m_Previous);
+#else
+    itk::MultiThreader::SetGlobalDefaultNumberOfThreads(m_Previous);
+#endif
+  }
+
+  ScopedITKThreadLimit(const ScopedITKThreadLimit&) = delete;            // Copy Constructor Not Implemented
+  ScopedITKThreadLimit(ScopedITKThreadLimit&&) = delete;                 // Move Constructor Not Implemented
+  ScopedITKThreadLimit& operator=(const ScopedITKThreadLimit&) = delete; // Copy Assignment Not Implemented
+  ScopedITKThreadLimit& operator=(ScopedITKThreadLimit&&) = delete;      // Move Assignment Not Implemented
+
+private:
+  itk::ThreadIdType m_Previous = 1;
+};
+
+/**
+ * @brief Runs function with both ITK and the SIMPL parallel algorithms limited to a number of threads.
+ */
+void runWithThreads(int threads, const std::function<void()>& function)
+{
+  ScopedITKThreadLimit limit(threads);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_arena arena(threads);
+  arena.execute(function);
+#else
+  function();
+#endif
+}
+
+/**
+ * @brief Executes filter once and adds its wall time and peak memory to measurement.  Returns false if the
+ * filter failed.
+ */
+bool measureExecution(AbstractFilter* filter, int threads, Measurement& measurement)
+{
+  resetPeakMemory();
+  const auto start = Clock::now();
+  runWithThreads(threads, [filter]() { filter->execute(); });
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  measurement.peakMemory = std::max(measurement.peakMemory, getPeakMemory());
+  if(filter->getErrorCode() < 0)
+  {
+    measurement.errorCode = filter->getErrorCode();
+    return false;
+  }
+  measurement.times.push_back(elapsed.count());
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Synthetic data
+// -----------------------------------------------------------------------------
+/**
+ * @brief Returns a value in [0, 1] that combines smooth gradients, blocky regions and deterministic noise,
+ * so that smoothing, edge, morphology and threshold filters all have structure to work on.
+ */
+double sampleScene(size_t x, size_t y, size_t z)
+{
+  constexpr double k_TwoPi = 6.283185307179586;
+  double value = 0.5 + 0.2 * std::sin(k_TwoPi * static_cast<double>(x) / 61.0) * std::cos(k_TwoPi * static_cast<double>(y) / 47.0) +
+                 0.1 * std::sin(k_TwoPi * static_cast<double>(z) / 29.0);
+  value += ((x / 32 + y / 32 + z / 32) % 3 == 0) ? 0.15 : -0.05;
+
+  uint64_t hash = (x * 0x9E3779B97F4A7C15ULL) ^ (y * 0xC2B2AE3D27D4EB4FULL) ^ (z * 0x165667B19E3779F9ULL);
+  hash ^= hash >> 29;
+  hash *= 0xBF58476D1CE4E5B9ULL;
+  hash ^= hash >> 32;
+  value += 0.1 * (static_cast<double>(hash & 0xFFFF) / 65535.0 - 0.5);
+  return std::min(1.0, std::max(0.0, value));
+}
+
+template <typename T>
+IDataArray::Pointer createScalarArray(const Volume& volume, const QString& name)
+{
+  std::vector<size_t> tupleDims(volume.begin(), volume.end());
+  typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(tupleDims, std::vector<size_t>(1, 1), name, true);
+  // Integer images use at most 12 bits so that filters which add or multiply values do not overflow
+  const double scale = std::is_floating_point<T>::value ? 1.0 : std::min(static_cast<double>(std::numeric_limits<T>::max()), 4095.0);
+  T* data = array->getPointer(0);
+  for(size_t z = 0; z < volume[2]; z++)
+  {
+    for(size_t y = 0; y < volume[1]; y++)
+    {
+      for(size_t x = 0; x < volume[0]; x++)
+      {
+        *data++ = static_cast<T>(sampleScene(x, y, z) * scale);
+      }
+    }
+  }
+  return array;
+}
+
+using ArrayCreator = std::function<IDataArray::Pointer(const Volume&, const QString&)>;
+
+const std::map<QString, ArrayCreator>& getArrayCreators()
+{
+  static const std::map<QString, ArrayCreator> creators = {
+      {"int8", createScalarArray<int8_t>},     {"uint8", createScalarArray<uint8_t>},   {"int16", createScalarArray<int16_t>}, {"uint16", createScalarArray<uint16_t>},
+      {"int32", createScalarArray<int32_t>},   {"uint32", createScalarArray<uint32_t>}, {"int64", createScalarArray<int64_t>}, {"uint64", createScalarArray<uint64_t>},
+      {"float", createScalarArray<float>},     {"double", createScalarArray<double>}};
+  return creators;
+}
+
+/**
+ * @brief Creates a DataContainerArray holding an image geometry of the given size with a single input array.
+ */
+DataContainerArray::Pointer createVolume(const Volume& volume, const QString& pixelType)
+{
+  DataContainer::Pointer container = DataContainer::New(k_DataContainerName);
+  ImageGeom::Pointer imageGeometry = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  std::vector<size_t> tupleDims(volume.begin(), volume.end());
+  imageGeometry->setDimensions(tupleDims.data());
+  container->setGeometry(imageGeometry);
+  AttributeMatrix::Pointer attributeMatrix = container->createAndAddAttributeMatrix(tupleDims, k_AttributeMatrixName, AttributeMatrix::Type::Cell);
+  attributeMatrix->insertOrAssign(getArrayCreators().at(pixelType)(volume, k_InputArrayName));
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  dca->addOrReplaceDataContainer(container);
+  return dca;
+}
+
+/**
+ * @brief Writes a grid of overlapping uint8 tiles cut from one synthetic scene and the Fiji tile
+ * configuration that places them.  Returns the path of the configuration file or an empty string.
+ */
+QString writeMontageTiles(const QString& directory, const Options& options)
+{
+  using TileImageType = itk::Image<uint8_t, 2>;
+  const size_t overlap = options.tileSize * 15 / 100;
+  const size_t step = options.tileSize - overlap;
+
+  const QString configPath = QDir(directory).filePath("TileConfiguration.txt");
+  QFile configFile(configPath);
+  if(!configFile.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    return QString();
+  }
+  QTextStream config(&configFile);
+  config << "# Define the number of dimensions we are working on\n";
+  config << "dim = 2\n\n";
+  config << "# Define the image coordinates\n";
+
+  TileImageType::SizeType size;
+  size.Fill(options.tileSize);
+  for(int row = 0; row < options.tileRows; row++)
+  {
+    for(int col = 0; col < options.tileColumns; col++)
+    {
+      const size_t x0 = static_cast<size_t>(col) * step;
+      const size_t y0 = static_cast<size_t>(row) * step;
+      TileImageType::Pointer tile = TileImageType::New();
+      tile->SetRegions(TileImageType::RegionType(size));
+      tile->Allocate();
+      uint8_t* pixel = tile->GetBufferPointer();
+      for(size_t y = 0; y < options.tileSize; y++)
+      {
+        for(size_t x = 0; x < options.tileSize; x++)
+        {
+          *pixel++ = static_cast<uint8_t>(sampleScene(x0 + x, y0 + y, 0) * 255.0);
+        }
+      }
+
+      const QString fileName = QString("tile_r%1_c%2.tif").arg(row).arg(col);
+      using WriterType = itk::ImageFileWriter<TileImageType>;
+      WriterType::Pointer writer = WriterType::New();
+      writer->SetFileName(QDir(directory).filePath(fileName).toStdString());
+      writer->SetInput(tile);
+      try
+      {
+        writer->Update();
+      } catch(itk::ExceptionObject& err)
+      {
+        std::cerr << "Could not write " << fileName.toStdString() << ": " << err.GetDescription() << std::endl;
+        return QString();
+      }
+      config << fileName << "; ; (" << x0 << ".0, " << y0 << ".0)\n";
+    }
+  }
+  return configPath;
+}
+
+// -----------------------------------------------------------------------------
+// Reporting
+// -----------------------------------------------------------------------------
+double getMedian(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return (values.size() % 2 == 1) ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+}
+
+/**
+ * @brief Returns the JSON record of one benchmark.  pixels is the number of pixels processed by one run, or
+ * 0 if unknown.
+ */
+QJsonObject createResult(const QString& name, const QString& kind, const QJsonObject& configuration, int threads, const Measurement& measurement, double pixels)
+{
+  QJsonObject result = configuration;
+  result["name"] = name;
+  result["kind"] = kind;
+  result["threads"] = threads;
+  result["peak_rss_bytes"] = static_cast<double>(measurement.peakMemory);
+  if(measurement.errorCode < 0 || measurement.times.empty())
+  {
+    result["status"] = "failed";
+    result["error_code"] = measurement.errorCode;
+    return result;
+  }
+
+  const double median = getMedian(measurement.times);
+  double sum = 0.0;
+  for(double time : measurement.times)
+  {
+    sum += time;
+  }
+  QJsonObject wallTime;
+  wallTime["min"] = *std::min_element(measurement.times.begin(), measurement.times.end());
+  wallTime["median"] = median;
+  wallTime["mean"] = sum / static_cast<double>(measurement.times.size());
+  result["status"] = "ok";
+  result["repetitions"] = static_cast<int>(measurement.times.size());
+  result["wall_time_s"] = wallTime;
+  if(pixels > 0.0 && median > 0.0)
+  {
+    result["mpixels_per_s"] = pixels / median / 1.0e6;
+  }
+  return result;
+}
+
+/**
+ * @brief Adds the speedup and parallel efficiency of every successful result relative to the run of the
+ * same benchmark with the fewest threads.
+ */
+void addSpeedups(QJsonArray& results)
+{
+  auto groupKey = [](const QJsonObject& result) {
+    QJsonObject key = result;
+    key.remove("threads");
+    key.remove("peak_rss_bytes");
+    key.remove("status");
+    key.remove("error_code");
+    key.remove("repetitions");
+    key.remove("wall_time_s");
+    key.remove("mpixels_per_s");
+    return QJsonDocument(key).toJson(QJsonDocument::Compact);
+  };
+
+  std::map<QByteArray, QJsonObject> baselines;
+  for(const QJsonValue& value : results)
+  {
+    const QJsonObject result = value.toObject();
+    if(result["status"].toString() != "ok")
+    {
+      continue;
+    }
+    const QByteArray key = groupKey(result);
+    auto iter = baselines.find(key);
+    if(iter == baselines.end() || result["threads"].toInt() < iter->second["threads"].toInt())
+    {
+      baselines[key] = result;
+    }
+  }
+
+  for(int i = 0; i < results.size(); i++)
+  {
+    QJsonObject result = results[i].toObject();
+    if(result["status"].toString() != "ok")
+    {
+      continue;
+    }
+    const QJsonObject& baseline = baselines[groupKey(result)];
+    const double baselineTime = baseline["wall_time_s"].toObject()["median"].toDouble();
+    const double time = result["wall_time_s"].toObject()["median"].toDouble();
+    if(time <= 0.0)
+    {
+      continue;
+    }
+    const double speedup = baselineTime / time;
+    result["baseline_threads"] = baseline["threads"].toInt();
+    result["speedup"] = speedup;
+    result["parallel_efficiency"] = speedup * baseline["threads"].toDouble() / result["threads"].toDouble();
+    results[i] = result;
+  }
+}
+
+QJsonArray toJson(const Volume& volume)
+{
+  return QJsonArray{static_cast<double>(volume[0]), static_cast<double>(volume[1]), static_cast<double>(volume[2])};
+}
+
+// -----------------------------------------------------------------------------
+// Benchmarks
+// -----------------------------------------------------------------------------
+/**
+ * @brief Runs every ITKImageProcessingBase filter on every requested volume and pixel type.  Filters that do
+ * not accept a pixel type or need a second input are reported as skipped.
+ */
+void runFilterBenchmarks(const Options& options, QJsonArray& results)
+{
+  FilterManager::Collection factories = FilterManager::Instance()->getFactories();
+  for(auto iter = factories.begin(); iter != factories.end(); ++iter)
+  {
+    const QString& className = iter.key();
+    IFilterFactory::Pointer factory = iter.value();
+    AbstractFilter::Pointer probe = factory->create();
+    if(nullptr == probe || !probe->inherits("ITKImageProcessingBase") || !options.filterPattern.match(className).hasMatch())
+    {
+      continue;
+    }
+
+    for(const Volume& volume : options.volumes)
+    {
+      const double pixels = static_cast<double>(volume[0] * volume[1] * volume[2]);
+      for(const QString& pixelType : options.pixelTypes)
+      {
+        QJsonObject configuration;
+        configuration["dimensions"] = toJson(volume);
+        configuration["pixel_type"] = pixelType;
+
+        for(int threads : options.threads)
+        {
+          std::cerr << className.toStdString() << " " << volume[0] << "x" << volume[1] << "x" << volume[2] << " " << pixelType.toStdString() << " " << threads << " threads" << std::endl;
+          Measurement measurement;
+          for(int repetition = 0; repetition < options.repetitions; repetition++)
+          {
+            DataContainerArray::Pointer dca = createVolume(volume, pixelType);
+            AbstractFilter::Pointer filter = factory->create();
+            filter->setProperty("SelectedCellArrayPath", QVariant::fromValue(DataArrayPath(k_DataContainerName, k_AttributeMatrixName, k_InputArrayName)));
+            filter->setProperty("NewCellArrayName", k_OutputArrayName);
+            filter->setProperty("MaximumNumberOfThreads", threads);
+            filter->setDataContainerArray(dca);
+            if(!measureExecution(filter.get(), threads, measurement))
+            {
+              break;
+            }
+          }
+
+          QJsonObject result = createResult(className, "filter", configuration, threads, measurement, pixels);
+          if(measurement.errorCode < 0 && measurement.times.empty())
+          {
+            // The filter rejected the input before doing any work
+            result["status"] = "skipped";
+          }
+          results.append(result);
+          if(measurement.errorCode < 0)
+          {
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Imports, dewarps and stitches a synthetic montage and reports each step separately.
+ */
+void runMontageBenchmarks(const Options& options, QJsonArray& results)
+{
+  QTemporaryDir directory;
+  const QString configPath = directory.isValid() ? writeMontageTiles(directory.path(), options) : QString();
+  if(configPath.isEmpty())
+  {
+    std::cerr << "The montage benchmarks were skipped because the synthetic tiles could not be written" << std::endl;
+    return;
+  }
+
+  const double pixels = static_cast<double>(options.tileRows * options.tileColumns) * static_cast<double>(options.tileSize * options.tileSize);
+  QJsonObject configuration;
+  configuration["dimensions"] = toJson({options.tileSize, options.tileSize, 1});
+  configuration["pixel_type"] = "uint8";
+  configuration["tiles"] = QJsonArray{options.tileRows, options.tileColumns};
+
+  const int paddingDigits = std::max(MetaXmlUtils::CalculatePaddingDigits(options.tileRows), MetaXmlUtils::CalculatePaddingDigits(options.tileColumns));
+  MontageSelection montageSelection;
+  montageSelection.setPrefixStr(k_TilePrefix);
+  montageSelection.setSuffixStr("");
+  montageSelection.setPadding(paddingDigits);
+  montageSelection.setRowStart(0);
+  montageSelection.setRowEnd(options.tileRows - 1);
+  montageSelection.setColStart(0);
+  montageSelection.setColEnd(options.tileColumns - 1);
+
+  for(int threads : options.threads)
+  {
+    std::cerr << "Montage " << options.tileRows << "x" << options.tileColumns << " tiles " << threads << " threads" << std::endl;
+    std::vector<QString> names;
+    std::vector<Measurement> measurements;
+    for(int repetition = 0; repetition < options.repetitions; repetition++)
+    {
+      ITKImportFijiMontage::Pointer import = ITKImportFijiMontage::New();
+      import->setInputFile(configPath);
+      import->setMontageName(k_MontageName);
+      import->setDataContainerPath(DataArrayPath(k_TilePrefix, "", ""));
+      import->setCellAttributeMatrixName(k_TileAttributeMatrixName);
+      import->setImageDataArrayName(k_TileArrayName);
+      import->setColumnMontageLimits(IntVec2Type(0, options.tileColumns - 1));
+      import->setRowMontageLimits(IntVec2Type(0, options.tileRows - 1));
+
+      CalcDewarpParameters::Pointer calcDewarp = CalcDewarpParameters::New();
+      calcDewarp->setMontageName(k_MontageName);
+      calcDewarp->setAttributeMatrixName(k_TileAttributeMatrixName);
+      calcDewarp->setIPFColorsArrayName(k_TileArrayName);
+
+      ApplyDewarpParameters::Pointer applyDewarp = ApplyDewarpParameters::New();
+      applyDewarp->setMontageName(k_MontageName);
+      applyDewarp->setAttributeMatrixName(k_TileAttributeMatrixName);
+      applyDewarp->setTransformPath(DataArrayPath(calcDewarp->getTransformDCName(), calcDewarp->getTransformMatrixName(), calcDewarp->getTransformArrayName()));
+
+      ITKStitchMontage::Pointer stitch = ITKStitchMontage::New();
+      stitch->setMontageSelection(montageSelection);
+      stitch->setCommonAttributeMatrixName(k_TileAttributeMatrixName);
+      stitch->setCommonDataArrayName(k_TileArrayName);
+      stitch->setMontageDataContainerName("Mosaic");
+      stitch->setMontageAttributeMatrixName("Mosaic Data");
+      stitch->setMontageDataArrayName(k_TileArrayName);
+
+      std::vector<AbstractFilter::Pointer> filters = {import, calcDewarp, applyDewarp, stitch};
+      measurements.resize(filters.size());
+      names.resize(filters.size());
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      for(size_t i = 0; i < filters.size(); i++)
+      {
+        names[i] = filters[i]->getNameOfClass();
+        filters[i]->setDataContainerArray(dca);
+        if(measurements[i].errorCode < 0 || !measureExecution(filters[i].get(), threads, measurements[i]))
+        {
+          break;
+        }
+      }
+    }
+
+    for(size_t i = 0; i < measurements.size(); i++)
+    {
+      results.append(createResult(names[i], "montage", configuration, threads, measurements[i], pixels));
+    }
+  }
+}
+
+/**
+ * @brief Runs every filter of a pipeline file and reports each filter separately.
+ */
+void runPipelineBenchmark(const QString& filePath, const Options& options, QJsonArray& results)
+{
+  QJsonObject configuration;
+  configuration["pipeline"] = filePath;
+
+  for(int threads : options.threads)
+  {
+    std::cerr << filePath.toStdString() << " " << threads << " threads" << std::endl;
+    std::vector<QString> names;
+    std::vector<Measurement> measurements;
+    for(int repetition = 0; repetition < options.repetitions; repetition++)
+    {
+      JsonFilterParametersReader::Pointer reader = JsonFilterParametersReader::New();
+      FilterPipeline::Pointer pipeline = reader->readPipelineFromFile(filePath);
+      if(nullptr == pipeline)
+      {
+        std::cerr << "Could not read the pipeline " << filePath.toStdString() << std::endl;
+        return;
+      }
+
+      FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+      measurements.resize(static_cast<size_t>(filters.size()));
+      names.resize(static_cast<size_t>(filters.size()));
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      for(int i = 0; i < filters.size(); i++)
+      {
+        // Keep the index so that repeated filters stay separate results
+        names[i] = QString("%1 %2").arg(i).arg(filters[i]->getNameOfClass());
+        filters[i]->setDataContainerArray(dca);
+        if(measurements[i].errorCode < 0 || !measureExecution(filters[i].get(), threads, measurements[i]))
+        {
+          break;
+        }
+      }
+    }
+
+    for(size_t i = 0; i < measurements.size(); i++)
+    {
+      results.append(createResult(names[i], "pipeline", configuration, threads, measurements[i], 0.0));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Command line
+// -----------------------------------------------------------------------------
+bool parseVolume(const QString& text, Volume& volume)
+{
+  const QStringList tokens = text.split('x');
+  if(tokens.size() < 2 || tokens.size() > 3)
+  {
+    return false;
+  }
+  volume = {1, 1, 1};
+  for(int i = 0; i < tokens.size(); i++)
+  {
+    bool ok = false;
+    volume[i] = tokens[i].toULongLong(&ok);
+    if(!ok || volume[i] == 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool parseOptions(const QCoreApplication& app, Options& options)
+{
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Benchmarks the ITKImageProcessing filters on synthetic data and writes the results as JSON.");
+  parser.addHelpOption();
+  QCommandLineOption sizesOption("sizes", "Comma separated volume sizes, e.g. 1024x1024,128x128x128.", "sizes", "1024x1024,128x128x128");
+  QCommandLineOption typesOption("pixel-types", "Comma separated pixel types: int8, uint8, int16, uint16, int32, uint32, int64, uint64, float, double.", "types", "uint8,float");
+  QCommandLineOption threadsOption("threads", "Comma separated thread counts. N is the number of hardware threads.", "threads", "1,2,4,8,N");
+  QCommandLineOption filterOption("filter", "Only run the filters whose class name matches this regular expression.", "regex", ".*");
+  QCommandLineOption repetitionsOption("repetitions", "Number of runs of each benchmark.", "count", "3");
+  QCommandLineOption tilesOption("tiles", "Rows and columns of the synthetic montage, e.g. 3x3.", "tiles", "3x3");
+  QCommandLineOption tileSizeOption("tile-size", "Width and height of the synthetic montage tiles.", "pixels", "1024");
+  QCommandLineOption pipelineOption("pipeline", "Also benchmark every filter of this pipeline file. May be repeated.", "file");
+  QCommandLineOption noFiltersOption("no-filters", "Skip the ITK image filter benchmarks.");
+  QCommandLineOption noMontageOption("no-montage", "Skip the montage import, dewarp and stitch benchmarks.");
+  QCommandLineOption outputOption({"o", "output"}, "Write the JSON report to this file instead of the standard output.", "file");
+  QCommandLineOption traceDirOption("trace-dir", "Write a Chrome trace of the phases of the montage filters to this directory for every run.", "directory");
+  parser.addOptions(
+      {sizesOption, typesOption, threadsOption, filterOption, repetitionsOption, tilesOption, tileSizeOption, pipelineOption, noFiltersOption, noMontageOption, outputOption, traceDirOption});
+  parser.process(app);
+
+  for(const QString& text : parser.value(sizesOption).split(',', QString::SkipEmptyParts))
+  {
+    Volume volume;
+    if(!parseVolume(text, volume))
+    {
+      std::cerr << "Invalid size: " << text.toStdString() << std::endl;
+      return false;
+    }
+    options.volumes.push_back(volume);
+  }
+
+  options.pixelTypes = parser.value(typesOption).split(',', QString::SkipEmptyParts);
+  for(const QString& pixelType : options.pixelTypes)
+  {
+    if(getArrayCreators().count(pixelType) == 0)
+    {
+      std::cerr << "Invalid pixel type: " << pixelType.toStdString() << std::endl;
+      return false;
+    }
+  }
+
+  const int hardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for(const QString& text : parser.value(threadsOption).split(',', QString::SkipEmptyParts))
+  {
+    bool ok = true;
+    const int threads = (text == "N") ? hardwareThreads : text.toInt(&ok);
+    if(!ok || threads < 1)
+    {
+      std::cerr << "Invalid thread count: " << text.toStdString() << std::endl;
+      return false;
+    }
+    // The default list asks for 8 threads even on smaller machines
+    if(threads <= hardwareThreads || parser.isSet(threadsOption))
+    {
+      options.threads.push_back(threads);
+    }
+  }
+  std::sort(options.threads.begin(), options.threads.end());
+  options.threads.erase(std::unique(options.threads.begin(), options.threads.end()), options.threads.end());
+
+  options.filterPattern = QRegularExpression(parser.value(filterOption));
+  if(!options.filterPattern.isValid())
+  {
+    std::cerr << "Invalid filter expression: " << parser.value(filterOption).toStdString() << std::endl;
+    return false;
+  }
+
+  bool ok = false;
+  options.repetitions = parser.value(repetitionsOption).toInt(&ok);
+  if(!ok || options.repetitions < 1)
+  {
+    std::cerr << "Invalid number of repetitions" << std::endl;
+    return false;
+  }
+
+  Volume tiles;
+  if(!parseVolume(parser.value(tilesOption), tiles) || tiles[2] != 1)
+  {
+    std::cerr << "Invalid montage tiles" << std::endl;
+    return false;
+  }
+  options.tileRows = static_cast<int>(tiles[0]);
+  options.tileColumns = static_cast<int>(tiles[1]);
+  options.tileSize = parser.value(tileSizeOption).toULongLong(&ok);
+  if(!ok || options.tileSize < 16)
+  {
+    std::cerr << "Invalid tile size" << std::endl;
+    return false;
+  }
+
+  options.pipelineFiles = parser.values(pipelineOption);
+  options.runFilters = !parser.isSet(noFiltersOption);
+  options.runMontage = !parser.isSet(noMontageOption);
+  options.outputFile = parser.value(outputOption);
+  options.traceDirectory = parser.value(traceDirOption);
+  return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("ITKImageProcessingBenchmarks");
+
+  Options options;
+  if(!parseOptions(app, options))
+  {
+    return EXIT_FAILURE;
+  }
+  if(!options.traceDirectory.isEmpty())
+  {
+    ITKPhaseTimer::SetEnabled(true);
+    ITKPhaseTimer::SetTraceDirectory(options.traceDirectory);
+  }
+
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+  QMetaObjectUtilities::RegisterMetaTypes();
+
+  QJsonArray results;
+  if(options.runFilters)
+  {
+    runFilterBenchmarks(options, results);
+  }
+  if(options.runMontage)
+  {
+    runMontageBenchmarks(options, results);
+  }
+  for(const QString& pipelineFile : options.pipelineFiles)
+  {
+    runPipelineBenchmark(pipelineFile, options, results);
+  }
+  addSpeedups(results);
+
+  QJsonObject report;
+  report["plugin"] = "ITKImageProcessing";
+  report["plugin_version"] = ITKImageProcessing::Version::Complete();
+  report["itk_version"] = QString::fromLatin1(itk::Version::GetITKVersion());
+  report["hardware_threads"] = static_cast<int>(std::thread::hardware_concurrency());
+  report["repetitions"] = options.repetitions;
+  report["results"] = results;
+  const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+  if(options.outputFile.isEmpty())
+  {
+    std::cout << json.constData() << std::endl;
+    return EXIT_SUCCESS;
+  }
+  QFile outputFile(options.outputFile);
+  if(!outputFile.open(QIODevice::WriteOnly))
+  {
+    std::cerr << "Could not write " << options.outputFile.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+  outputFile.write(json);
+  return EXIT_SUCCESS;
+}
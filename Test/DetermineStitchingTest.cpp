@@ -0,0 +1,189 @@
+#pragma once
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/DetermineStitching.h"
+#include "ITKImageProcessing/Test/UnitTestSupport.hpp"
+
+class DetermineStitchingTest
+{
+public:
+  DetermineStitchingTest() = default;
+  ~DetermineStitchingTest() = default;
+  DetermineStitchingTest(const DetermineStitchingTest&) = delete;            // Copy Constructor
+  DetermineStitchingTest(DetermineStitchingTest&&) = delete;                 // Move Constructor
+  DetermineStitchingTest& operator=(const DetermineStitchingTest&) = delete; // Copy Assignment
+  DetermineStitchingTest& operator=(DetermineStitchingTest&&) = delete;      // Move Assignment
+
+  const size_t k_Columns = 6;
+  const size_t k_Rows = 5;
+  const float k_NominalDx = 900.0f;
+  const float k_NominalDy = 700.0f;
+  const float k_Confidence = 0.9f;
+  const float k_Tolerance = 0.5f;
+
+  // -----------------------------------------------------------------------------
+  // The true position of each tile is its nominal grid position plus a few pixels of stage error.
+  // -----------------------------------------------------------------------------
+  void createTruePositions(std::vector<float>& xPositions, std::vector<float>& yPositions) const
+  {
+    const size_t numTiles = k_Columns * k_Rows;
+    xPositions.resize(numTiles);
+    yPositions.resize(numTiles);
+    for(size_t tile = 0; tile < numTiles; tile++)
+    {
+      const size_t col = tile % k_Columns;
+      const size_t row = tile / k_Columns;
+      const float jitter = (tile == 0) ? 0.0f : 1.0f;
+      xPositions[tile] = static_cast<float>(col) * k_NominalDx + jitter * static_cast<float>((tile * 7) % 11) - 5.0f * jitter;
+      yPositions[tile] = static_cast<float>(row) * k_NominalDy + jitter * static_cast<float>((tile * 5) % 9) - 4.0f * jitter;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Measures the exact displacement of every tile from its left and top neighbors.
+  // -----------------------------------------------------------------------------
+  std::vector<DetermineStitching::TileDisplacement> createDisplacements(const std::vector<float>& xPositions, const std::vector<float>& yPositions) const
+  {
+    std::vector<DetermineStitching::TileDisplacement> displacements;
+    for(size_t tile = 0; tile < xPositions.size(); tile++)
+    {
+      if(tile % k_Columns != 0)
+      {
+        displacements.push_back(createDisplacement(tile - 1, tile, xPositions, yPositions, k_NominalDx, 0.0f));
+      }
+      if(tile >= k_Columns)
+      {
+        displacements.push_back(createDisplacement(tile - k_Columns, tile, xPositions, yPositions, 0.0f, k_NominalDy));
+      }
+    }
+    return displacements;
+  }
+
+  // -----------------------------------------------------------------------------
+  DetermineStitching::TileDisplacement createDisplacement(size_t fromTile, size_t toTile, const std::vector<float>& xPositions, const std::vector<float>& yPositions, float nominalDx,
+                                                          float nominalDy) const
+  {
+    DetermineStitching::TileDisplacement displacement;
+    displacement.fromTile = fromTile;
+    displacement.toTile = toTile;
+    displacement.dx = xPositions[toTile] - xPositions[fromTile];
+    displacement.dy = yPositions[toTile] - yPositions[fromTile];
+    displacement.nominalDx = nominalDx;
+    displacement.nominalDy = nominalDy;
+    displacement.confidence = k_Confidence;
+    return displacement;
+  }
+
+  // -----------------------------------------------------------------------------
+  void checkPositions(const std::vector<float>& positions, const std::vector<float>& xPositions, const std::vector<float>& yPositions) const
+  {
+    DREAM3D_REQUIRE_EQUAL(positions.size(), 2 * xPositions.size())
+    for(size_t tile = 0; tile < xPositions.size(); tile++)
+    {
+      DREAM3D_REQUIRED(std::fabs(positions[2 * tile] - xPositions[tile]), <=, k_Tolerance)
+      DREAM3D_REQUIRED(std::fabs(positions[2 * tile + 1] - yPositions[tile]), <=, k_Tolerance)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestExactDisplacements()
+  {
+    std::vector<float> xPositions;
+    std::vector<float> yPositions;
+    createTruePositions(xPositions, yPositions);
+    std::vector<DetermineStitching::TileDisplacement> displacements = createDisplacements(xPositions, yPositions);
+
+    size_t rejectedCount = 0;
+    std::vector<float> positions = DetermineStitching::SolveGlobalPositions(xPositions.size(), displacements, 0.1f, rejectedCount);
+    DREAM3D_REQUIRE_EQUAL(rejectedCount, 0)
+    checkPositions(positions, xPositions, yPositions);
+  }
+
+  // -----------------------------------------------------------------------------
+  // A pair whose correlation locked onto the wrong peak must be rejected without moving any tile.
+  // -----------------------------------------------------------------------------
+  void TestCorruptedPair()
+  {
+    std::vector<float> xPositions;
+    std::vector<float> yPositions;
+    createTruePositions(xPositions, yPositions);
+    std::vector<DetermineStitching::TileDisplacement> displacements = createDisplacements(xPositions, yPositions);
+
+    const size_t corrupted = displacements.size() / 2;
+    displacements[corrupted].dx += 40.0f;
+    displacements[corrupted].dy -= 25.0f;
+
+    size_t rejectedCount = 0;
+    std::vector<float> positions = DetermineStitching::SolveGlobalPositions(xPositions.size(), displacements, 0.1f, rejectedCount);
+    DREAM3D_REQUIRE_EQUAL(rejectedCount, 1)
+    checkPositions(positions, xPositions, yPositions);
+
+    // The corrupted measurement is the one that disagrees with the solution
+    const DetermineStitching::TileDisplacement& outlier = displacements[corrupted];
+    const float residualX = positions[2 * outlier.toTile] - positions[2 * outlier.fromTile] - outlier.dx;
+    const float residualY = positions[2 * outlier.toTile + 1] - positions[2 * outlier.fromTile + 1] - outlier.dy;
+    DREAM3D_REQUIRED(std::hypot(residualX, residualY), >, 40.0f)
+  }
+
+  // -----------------------------------------------------------------------------
+  // A pair below the minimum confidence is rejected before solving.
+  // -----------------------------------------------------------------------------
+  void TestLowConfidencePair()
+  {
+    std::vector<float> xPositions;
+    std::vector<float> yPositions;
+    createTruePositions(xPositions, yPositions);
+    std::vector<DetermineStitching::TileDisplacement> displacements = createDisplacements(xPositions, yPositions);
+
+    displacements[3].dx += 200.0f;
+    displacements[3].confidence = 0.05f;
+
+    size_t rejectedCount = 0;
+    std::vector<float> positions = DetermineStitching::SolveGlobalPositions(xPositions.size(), displacements, 0.1f, rejectedCount);
+    DREAM3D_REQUIRE_EQUAL(rejectedCount, 1)
+    checkPositions(positions, xPositions, yPositions);
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "---------------- DetermineStitchingTest ---------------------" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestExactDisplacements())
+    DREAM3D_REGISTER_TEST(TestCorruptedPair())
+    DREAM3D_REGISTER_TEST(TestLowConfidencePair())
+  }
+};
@@ -139,6 +139,51 @@ public:
     return 0;
   }
 
+  // -----------------------------------------------------------------------------
+  // The input range is computed over the whole image, so Stream Output must not change the result.
+  // -----------------------------------------------------------------------------
+  int ITKAdaptiveHistogramEqualizationImageStreamOutputTest()
+  {
+#if defined(ITK_VERSION_MAJOR) && ITK_VERSION_MAJOR == 4
+    QString input_filename = UnitTest::DataDir + QString("/Data/JSONFilters/Input/cthead1.png");
+#else
+    QString input_filename = UnitTest::DataDir + QString("/Data/JSONFilters/Input/sf4.png");
+#endif
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    this->ReadImage(input_filename, containerArray, input_path);
+
+#if defined(ITK_VERSION_MAJOR) && ITK_VERSION_MAJOR == 5
+    ConvertInputImage(containerArray, input_path);
+    input_path.setDataArrayName("GrayScale_TestAttributeArrayName"); // Update the data array name for the next filter
+#endif
+
+    const QStringList outputNames = {"Unstreamed_Output", "Streamed_Output"};
+    for(int i = 0; i < outputNames.size(); i++)
+    {
+      ITKAdaptiveHistogramEqualizationImage::Pointer filter = ITKAdaptiveHistogramEqualizationImage::New();
+      filter->setDataContainerArray(containerArray);
+      filter->setSelectedCellArrayPath(input_path);
+      filter->setNewCellArrayName(outputNames[i]);
+      filter->setRadius({5.0f, 5.0f, 5.0f});
+      const bool streamed = (i == 1);
+      filter->setStreamOutput(streamed);
+      filter->setStreamingDivisions(4);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+      if(streamed)
+      {
+        DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), -55559);
+      }
+    }
+
+    DataArrayPath unstreamed_path("TestContainer", "TestAttributeMatrixName", outputNames[0]);
+    DataArrayPath streamed_path("TestContainer", "TestAttributeMatrixName", outputNames[1]);
+    int res = this->CompareImages(containerArray, streamed_path, unstreamed_path, 0);
+    DREAM3D_REQUIRE_EQUAL(res, 0);
+    return 0;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -150,6 +195,7 @@ public:
 
     DREAM3D_REGISTER_TEST(ITKAdaptiveHistogramEqualizationImageTest1());
     DREAM3D_REGISTER_TEST(ITKAdaptiveHistogramEqualizationImageTest2());
+    DREAM3D_REGISTER_TEST(ITKAdaptiveHistogramEqualizationImageStreamOutputTest());
 
     if(SIMPL::unittest::numTests == SIMPL::unittest::numTestsPass)
     {
@@ -0,0 +1,213 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include "ITKTestBase.h"
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+
+class ITKPipelineSegmentTest : public ITKTestBase
+{
+
+public:
+  ITKPipelineSegmentTest() = default;
+  ~ITKPipelineSegmentTest() override = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateFilter(const QString& filtName, const DataArrayPath& inputPath, const QString& outputName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      return AbstractFilter::NullPointer();
+    }
+    AbstractFilter::Pointer filter = filterFactory->create();
+    QVariant var;
+    var.setValue(inputPath);
+    filter->setProperty("SelectedCellArrayPath", var);
+    if(!outputName.isEmpty())
+    {
+      var.setValue(outputName);
+      filter->setProperty("NewCellArrayName", var);
+    }
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString CreateChain(bool keepMedianOutput)
+  {
+    return QString("[{\"Filter_Name\": \"ITKMedianImage\", \"NewCellArrayName\": \"Segment_Median\", \"Radius\": {\"x\": 2, \"y\": 3, \"z\": 0}, \"Keep_Output\": %1},"
+                   " {\"Filter_Name\": \"ITKRescaleIntensityImage\", \"NewCellArrayName\": \"Segment_Rescale\", \"OutputMinimum\": 10, \"OutputMaximum\": 200}]")
+        .arg(keepMedianOutput ? "true" : "false");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunSequentialChain(DataContainerArray::Pointer containerArray, const DataArrayPath& inputPath)
+  {
+    AbstractFilter::Pointer median = CreateFilter("ITKMedianImage", inputPath, "Sequential_Median");
+    DREAM3D_REQUIRE_NE(median.get(), 0);
+    QVariant var;
+    FloatVec3Type radius;
+    radius[0] = 2;
+    radius[1] = 3;
+    radius[2] = 0;
+    var.setValue(radius);
+    DREAM3D_REQUIRE_EQUAL(median->setProperty("Radius", var), true);
+    median->setDataContainerArray(containerArray);
+    median->execute();
+    DREAM3D_REQUIRED(median->getErrorCode(), >=, 0);
+
+    DataArrayPath medianPath(inputPath.getDataContainerName(), inputPath.getAttributeMatrixName(), "Sequential_Median");
+    AbstractFilter::Pointer rescale = CreateFilter("ITKRescaleIntensityImage", medianPath, "Sequential_Rescale");
+    DREAM3D_REQUIRE_NE(rescale.get(), 0);
+    var.setValue(10.0);
+    DREAM3D_REQUIRE_EQUAL(rescale->setProperty("OutputMinimum", var), true);
+    var.setValue(200.0);
+    DREAM3D_REQUIRE_EQUAL(rescale->setProperty("OutputMaximum", var), true);
+    rescale->setDataContainerArray(containerArray);
+    rescale->execute();
+    DREAM3D_REQUIRED(rescale->getErrorCode(), >=, 0);
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestITKPipelineSegmentMatchesSequentialTest(bool keepMedianOutput)
+  {
+    QString input_filename = UnitTest::DataDir + QString("/Data/JSONFilters/Input/RA-Float.nrrd");
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    this->ReadImage(input_filename, containerArray, input_path);
+
+    DREAM3D_REQUIRE_EQUAL(RunSequentialChain(containerArray, input_path), 0);
+
+    AbstractFilter::Pointer filter = CreateFilter("ITKPipelineSegment", input_path, QString());
+    DREAM3D_REQUIRE_NE(filter.get(), 0);
+    QVariant var;
+    var.setValue(CreateChain(keepMedianOutput));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("FilterChain", var), true);
+    filter->setDataContainerArray(containerArray);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+    DREAM3D_REQUIRED(filter->getWarningCode(), >=, 0);
+
+    DataArrayPath sequential_path("TestContainer", "TestAttributeMatrixName", "Sequential_Rescale");
+    DataArrayPath output_path("TestContainer", "TestAttributeMatrixName", "Segment_Rescale");
+    int res = this->CompareImages(containerArray, output_path, sequential_path, 0);
+    DREAM3D_REQUIRE_EQUAL(res, 0);
+
+    AttributeMatrix::Pointer am = containerArray->getAttributeMatrix(input_path);
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Segment_Median"), keepMedianOutput);
+    if(keepMedianOutput)
+    {
+      DataArrayPath sequential_median_path("TestContainer", "TestAttributeMatrixName", "Sequential_Median");
+      DataArrayPath median_path("TestContainer", "TestAttributeMatrixName", "Segment_Median");
+      res = this->CompareImages(containerArray, median_path, sequential_median_path, 0);
+      DREAM3D_REQUIRE_EQUAL(res, 0);
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestITKPipelineSegmentPreflightTest()
+  {
+    QString input_filename = UnitTest::DataDir + QString("/Data/JSONFilters/Input/RA-Float.nrrd");
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    this->ReadImage(input_filename, containerArray, input_path);
+
+    AbstractFilter::Pointer filter = CreateFilter("ITKPipelineSegment", input_path, QString());
+    DREAM3D_REQUIRE_NE(filter.get(), 0);
+    filter->setDataContainerArray(containerArray);
+    QVariant var;
+
+    // Only the last output array is created by default
+    var.setValue(CreateChain(false));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+    AttributeMatrix::Pointer am = containerArray->getAttributeMatrix(input_path);
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Segment_Median"), false);
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Segment_Rescale"), true);
+    am->removeAttributeArray("Segment_Rescale");
+
+    var.setValue(QString("{\"Filter_Name\": \"ITKMedianImage\"}"));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -66900);
+
+    var.setValue(QString("[]"));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -66901);
+
+    var.setValue(QString("[{\"Filter_Name\": \"NotAFilter\"}]"));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -66902);
+
+    var.setValue(QString("[{\"Filter_Name\": \"ITKImageWriter\"}]"));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -66903);
+
+    // The correlation filter reads both images from their arrays and would ignore the previous output
+    var.setValue(QString("[{\"Filter_Name\": \"ITKMedianImage\", \"NewCellArrayName\": \"Segment_Median\"},"
+                         " {\"Filter_Name\": \"ITKFFTNormalizedCorrelationImage\", \"NewCellArrayName\": \"Segment_Correlation\"}]"));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -66905);
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Segment_Median"), false);
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Segment_Correlation"), false);
+
+    // Both filters would write the same array
+    var.setValue(QString("[{\"Filter_Name\": \"ITKMedianImage\", \"NewCellArrayName\": \"Segment_Median\"},"
+                         " {\"Filter_Name\": \"ITKMedianImage\", \"NewCellArrayName\": \"Segment_Median\"}]"));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -66906);
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Segment_Median"), false);
+
+    // The second filter has no output array name
+    var.setValue(QString("[{\"Filter_Name\": \"ITKMedianImage\", \"NewCellArrayName\": \"Segment_Median\"}, {\"Filter_Name\": \"ITKRescaleIntensityImage\"}]"));
+    filter->setProperty("FilterChain", var);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -66904);
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Segment_Median"), false);
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()() override
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(this->TestFilterAvailability("ITKPipelineSegment"));
+
+    DREAM3D_REGISTER_TEST(TestITKPipelineSegmentPreflightTest());
+    DREAM3D_REGISTER_TEST(TestITKPipelineSegmentMatchesSequentialTest(false));
+    DREAM3D_REGISTER_TEST(TestITKPipelineSegmentMatchesSequentialTest(true));
+
+    if(SIMPL::unittest::numTests == SIMPL::unittest::numTestsPass)
+    {
+      DREAM3D_REGISTER_TEST(this->RemoveTestFiles())
+    }
+  }
+
+private:
+  ITKPipelineSegmentTest(const ITKPipelineSegmentTest&); // Copy Constructor Not Implemented
+  void operator=(const ITKPipelineSegmentTest&);         // Move assignment Not Implemented
+};
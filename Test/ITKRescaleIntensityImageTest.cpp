@@ -49,6 +49,47 @@ public:
     return 0;
   }
 
+  // -----------------------------------------------------------------------------
+  // The rescaling range is computed over the whole image, so Stream Output must not change the result.
+  // -----------------------------------------------------------------------------
+  int TestITKRescaleIntensityImageStreamOutputTest()
+  {
+    QString input_filename = UnitTest::DataDir + QString("/Data/JSONFilters/Input/RA-Float.nrrd");
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    this->ReadImage(input_filename, containerArray, input_path);
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("ITKRescaleIntensityImage");
+    DREAM3D_REQUIRE_NE(filterFactory.get(), 0);
+
+    const QStringList outputNames = {"Unstreamed_Output", "Streamed_Output"};
+    for(int i = 0; i < outputNames.size(); i++)
+    {
+      AbstractFilter::Pointer filter = filterFactory->create();
+      QVariant var;
+      var.setValue(input_path);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("SelectedCellArrayPath", var), true);
+      var.setValue(outputNames[i]);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("NewCellArrayName", var), true);
+      const bool streamed = (i == 1);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("StreamOutput", streamed), true);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("StreamingDivisions", 4), true);
+      filter->setDataContainerArray(containerArray);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+      if(streamed)
+      {
+        DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), -55559);
+      }
+    }
+
+    DataArrayPath unstreamed_path("TestContainer", "TestAttributeMatrixName", outputNames[0]);
+    DataArrayPath streamed_path("TestContainer", "TestAttributeMatrixName", outputNames[1]);
+    int res = this->CompareImages(containerArray, streamed_path, unstreamed_path, 0);
+    DREAM3D_REQUIRE_EQUAL(res, 0);
+    return 0;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -59,6 +100,7 @@ public:
     DREAM3D_REGISTER_TEST(this->TestFilterAvailability("ITKRescaleIntensityImage"));
 
     DREAM3D_REGISTER_TEST(TestITKRescaleIntensityImage3dTest());
+    DREAM3D_REGISTER_TEST(TestITKRescaleIntensityImageStreamOutputTest());
 
     if(SIMPL::unittest::numTests == SIMPL::unittest::numTestsPass)
     {
@@ -7,6 +7,12 @@
 #include "ITKTestBase.h"
 // Auto includes
 
+#include <cmath>
+
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/ITKResultCache.h"
+
 class ITKSqrtImageTest : public ITKTestBase
 {
 
@@ -48,6 +54,208 @@ public:
     return 0;
   }
 
+  int TestITKSqrtImageExecutionSettingsTest(const QMap<QString, QVariant>& settings)
+  {
+    QString input_filename = UnitTest::DataDir + QString("/Data/JSONFilters/Input/Ramp-Zero-One-Float.nrrd");
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    this->ReadImage(input_filename, containerArray, input_path);
+    QString filtName = "ITKSqrtImage";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE_NE(filterFactory.get(), 0);
+
+    QStringList outputNames = {"TestAttributeArrayName_Output", "TestAttributeArrayName_Settings"};
+    for(const QString& outputName : outputNames)
+    {
+      AbstractFilter::Pointer filter = filterFactory->create();
+      QVariant var;
+      bool propWasSet;
+      var.setValue(input_path);
+      propWasSet = filter->setProperty("SelectedCellArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+      var.setValue(outputName);
+      propWasSet = filter->setProperty("NewCellArrayName", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+      if(outputName == outputNames[1])
+      {
+        for(auto iter = settings.begin(); iter != settings.end(); ++iter)
+        {
+          propWasSet = filter->setProperty(iter.key().toLatin1().constData(), iter.value());
+          DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+        }
+      }
+      filter->setDataContainerArray(containerArray);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+    }
+
+    DataArrayPath output_path("TestContainer", "TestAttributeMatrixName", outputNames[0]);
+    DataArrayPath settings_path("TestContainer", "TestAttributeMatrixName", outputNames[1]);
+    int res = this->CompareImages(containerArray, settings_path, output_path, 0);
+    DREAM3D_REQUIRE_EQUAL(res, 0);
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // ITKSqrtImage is only instantiated for float and double.  64 bit integers are cast through double and
+  // other types through float.
+  // -----------------------------------------------------------------------------
+  template <typename PixelType>
+  int TestITKSqrtImageCastThroughFloatTest()
+  {
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    DataContainer::Pointer container = DataContainer::New(input_path.getDataContainerName());
+    ImageGeom::Pointer imageGeometry = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    std::vector<size_t> dimensions = {5, 4, 3};
+    imageGeometry->setDimensions(dimensions.data());
+    container->setGeometry(imageGeometry);
+    AttributeMatrix::Pointer matrixArray = container->createAndAddAttributeMatrix(dimensions, input_path.getAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    typename DataArray<PixelType>::Pointer data = DataArray<PixelType>::CreateArray(dimensions, std::vector<size_t>(1, 1), input_path.getDataArrayName(), true);
+    for(size_t i = 0; i < data->getNumberOfTuples(); i++)
+    {
+      data->setValue(i, static_cast<PixelType>(i * 2));
+    }
+    matrixArray->insertOrAssign(data);
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    containerArray->addOrReplaceDataContainer(container);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("ITKSqrtImage");
+    DREAM3D_REQUIRE_NE(filterFactory.get(), 0);
+    AbstractFilter::Pointer filter = filterFactory->create();
+    QVariant var;
+    var.setValue(input_path);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("SelectedCellArrayPath", var), true);
+    QString outputName = "TestAttributeArrayName_Output";
+    var.setValue(outputName);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NewCellArrayName", var), true);
+    filter->setDataContainerArray(containerArray);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+
+    typename DataArray<PixelType>::Pointer output = matrixArray->getAttributeArrayAs<DataArray<PixelType>>(outputName);
+    DREAM3D_REQUIRE_VALID_POINTER(output.get());
+    for(size_t i = 0; i < output->getNumberOfTuples(); i++)
+    {
+      const PixelType expected = static_cast<PixelType>(std::sqrt(static_cast<float>(data->getValue(i))));
+      DREAM3D_REQUIRE_EQUAL(output->getValue(i), expected);
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Filters a constant image of value and checks the output and the precision warning.
+  // -----------------------------------------------------------------------------
+  template <typename PixelType>
+  int TestITKSqrtImageCastPrecisionTest(PixelType value, PixelType expected, int expectedWarning)
+  {
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    DataContainer::Pointer container = DataContainer::New(input_path.getDataContainerName());
+    ImageGeom::Pointer imageGeometry = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    std::vector<size_t> dimensions = {5, 4, 3};
+    imageGeometry->setDimensions(dimensions.data());
+    container->setGeometry(imageGeometry);
+    AttributeMatrix::Pointer matrixArray = container->createAndAddAttributeMatrix(dimensions, input_path.getAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    typename DataArray<PixelType>::Pointer data = DataArray<PixelType>::CreateArray(dimensions, std::vector<size_t>(1, 1), input_path.getDataArrayName(), true);
+    data->initializeWithValue(value);
+    matrixArray->insertOrAssign(data);
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    containerArray->addOrReplaceDataContainer(container);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("ITKSqrtImage");
+    DREAM3D_REQUIRE_NE(filterFactory.get(), 0);
+    AbstractFilter::Pointer filter = filterFactory->create();
+    QVariant var;
+    var.setValue(input_path);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("SelectedCellArrayPath", var), true);
+    QString outputName = "TestAttributeArrayName_Output";
+    var.setValue(outputName);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NewCellArrayName", var), true);
+    filter->setDataContainerArray(containerArray);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+    DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), expectedWarning);
+
+    typename DataArray<PixelType>::Pointer output = matrixArray->getAttributeArrayAs<DataArray<PixelType>>(outputName);
+    DREAM3D_REQUIRE_VALID_POINTER(output.get());
+    for(size_t i = 0; i < output->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(output->getValue(i), expected);
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Creates a float image whose values are offset + i
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createResultCacheInput(const DataArrayPath& input_path, float offset)
+  {
+    DataContainer::Pointer container = DataContainer::New(input_path.getDataContainerName());
+    ImageGeom::Pointer imageGeometry = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    std::vector<size_t> dimensions = {5, 4, 3};
+    imageGeometry->setDimensions(dimensions.data());
+    container->setGeometry(imageGeometry);
+    AttributeMatrix::Pointer matrixArray = container->createAndAddAttributeMatrix(dimensions, input_path.getAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(dimensions, std::vector<size_t>(1, 1), input_path.getDataArrayName(), true);
+    for(size_t i = 0; i < data->getNumberOfTuples(); i++)
+    {
+      data->setValue(i, offset + static_cast<float>(i));
+    }
+    matrixArray->insertOrAssign(data);
+    DataContainerArray::Pointer containerArray = DataContainerArray::New();
+    containerArray->addOrReplaceDataContainer(container);
+    return containerArray;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A second execution on equal input values reuses the cached output, different values do not.
+  // -----------------------------------------------------------------------------
+  int TestITKSqrtImageResultCacheTest()
+  {
+    DataArrayPath input_path("TestContainer", "TestAttributeMatrixName", "TestAttributeArrayName");
+    QString outputName = "TestAttributeArrayName_Output";
+    DataArrayPath output_path("TestContainer", "TestAttributeMatrixName", outputName);
+    ITKResultCache* cache = ITKResultCache::Instance();
+    cache->clear();
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("ITKSqrtImage");
+    DREAM3D_REQUIRE_NE(filterFactory.get(), 0);
+
+    std::vector<float> offsets = {0.0f, 0.0f, 1.0f, 0.0f};
+    std::vector<size_t> expectedHits = {0, 1, 0, 1};
+    for(size_t run = 0; run < offsets.size(); run++)
+    {
+      DataContainerArray::Pointer containerArray = createResultCacheInput(input_path, offsets[run]);
+      AbstractFilter::Pointer filter = filterFactory->create();
+      QVariant var;
+      var.setValue(input_path);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("SelectedCellArrayPath", var), true);
+      var.setValue(outputName);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("NewCellArrayName", var), true);
+      DREAM3D_REQUIRE_EQUAL(filter->setProperty("UseResultCache", true), true);
+      filter->setDataContainerArray(containerArray);
+      const size_t hits = cache->getHitCount();
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+      DREAM3D_REQUIRE_EQUAL(cache->getHitCount() - hits, expectedHits[run]);
+
+      FloatArrayType::Pointer output = containerArray->getAttributeMatrix(output_path)->getAttributeArrayAs<FloatArrayType>(outputName);
+      DREAM3D_REQUIRE_VALID_POINTER(output.get());
+      for(size_t i = 0; i < output->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(output->getValue(i), std::sqrt(offsets[run] + static_cast<float>(i)));
+      }
+      // The cache keeps its own copy, so modifying the output must not change later results
+      output->initializeWithValue(-1.0f);
+    }
+    DREAM3D_REQUIRE_EQUAL(cache->getNumberOfEntries(), 2);
+    cache->clear();
+    return 0;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -58,6 +266,17 @@ public:
     DREAM3D_REGISTER_TEST(this->TestFilterAvailability("ITKSqrtImage"));
 
     DREAM3D_REGISTER_TEST(TestITKSqrtImagedefaultsTest());
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageExecutionSettingsTest({{"StreamOutput", true}, {"StreamingDivisions", 4}}));
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageExecutionSettingsTest({{"StreamOutput", true}, {"StreamingDivisions", 0}, {"StreamingMemoryBudget", 1}}));
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageExecutionSettingsTest({{"MaximumNumberOfThreads", 2}, {"NumberOfWorkUnits", 7}, {"MultiThreaderType", 1}}));
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageExecutionSettingsTest({{"MaximumNumberOfThreads", 1}, {"MultiThreaderType", 0}}));
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageCastThroughFloatTest<uint16_t>());
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageCastThroughFloatTest<int64_t>());
+    // (2^30 + 1)^2 + 2^30 only keeps its square root's integer part when filtered as double
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageCastPrecisionTest<int64_t>((int64_t(1) << 60) + (int64_t(3) << 30) + 1, (int64_t(1) << 30) + 1, 0));
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageCastPrecisionTest<uint64_t>((uint64_t(1) << 60) + (uint64_t(3) << 30) + 1, (uint64_t(1) << 30) + 1, 0));
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageCastPrecisionTest<int32_t>(1 << 30, 1 << 15, -55567));
+    DREAM3D_REGISTER_TEST(TestITKSqrtImageResultCacheTest());
 
     if(SIMPL::unittest::numTests == SIMPL::unittest::numTestsPass)
     {
@@ -0,0 +1,290 @@
+#pragma once
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkTIFFImageIO.h"
+#include "itk_tiff.h"
+
+#include "ITKImageProcessing/ITKImageProcessingFilters/util/TiledTiffWriter.h"
+#include "ITKImageProcessing/Test/ITKImageProcessingTestFileLocations.h"
+#include "ITKImageProcessing/Test/UnitTestSupport.hpp"
+
+class TiledTiffWriterTest
+{
+public:
+  TiledTiffWriterTest() = default;
+  ~TiledTiffWriterTest() = default;
+  TiledTiffWriterTest(const TiledTiffWriterTest&) = delete;            // Copy Constructor
+  TiledTiffWriterTest(TiledTiffWriterTest&&) = delete;                 // Move Constructor
+  TiledTiffWriterTest& operator=(const TiledTiffWriterTest&) = delete; // Copy Assignment
+  TiledTiffWriterTest& operator=(TiledTiffWriterTest&&) = delete;      // Move Assignment
+
+  const QString k_OutputFile = UnitTest::TestTempDir + "/TiledTiffWriterTest.tif";
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(k_OutputFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  T createPixel(uint32_t x, uint32_t y) const
+  {
+    return static_cast<T>((x * 7 + y * 13) % 251);
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  TiledTiffWriter::SampleFormat sampleFormat() const
+  {
+    if(std::is_floating_point<T>::value)
+    {
+      return TiledTiffWriter::SampleFormat::Float;
+    }
+    return std::is_signed<T>::value ? TiledTiffWriter::SampleFormat::SignedInteger : TiledTiffWriter::SampleFormat::UnsignedInteger;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the image in bands of bandHeight rows.  The last band is shorter when height is not a multiple of it.
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void writeImage(uint32_t width, uint32_t height, uint32_t bandHeight, uint32_t pyramidLevels)
+  {
+    TiledTiffWriter writer;
+    DREAM3D_REQUIRE_EQUAL(writer.open(k_OutputFile), true)
+    DREAM3D_REQUIRE_EQUAL(writer.beginImage(width, height, 1, sizeof(T), sampleFormat<T>(), pyramidLevels), true)
+
+    std::vector<T> band;
+    for(uint32_t firstRow = 0; firstRow < height; firstRow += bandHeight)
+    {
+      const uint32_t rowCount = std::min(bandHeight, height - firstRow);
+      band.resize(static_cast<size_t>(rowCount) * width);
+      for(uint32_t y = 0; y < rowCount; y++)
+      {
+        for(uint32_t x = 0; x < width; x++)
+        {
+          band[static_cast<size_t>(y) * width + x] = createPixel<T>(x, firstRow + y);
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(writer.writeBand(firstRow, rowCount, band.data()), true)
+    }
+    DREAM3D_REQUIRE_EQUAL(writer.endImage(), true)
+    DREAM3D_REQUIRE_EQUAL(writer.close(), true)
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void checkImage(uint32_t width, uint32_t height)
+  {
+    using ImageType = itk::Image<T, 2>;
+    using ReaderType = itk::ImageFileReader<ImageType>;
+    typename ReaderType::Pointer reader = ReaderType::New();
+    reader->SetImageIO(itk::TIFFImageIO::New());
+    reader->SetFileName(k_OutputFile.toStdString());
+    reader->Update();
+
+    ImageType* image = reader->GetOutput();
+    typename ImageType::SizeType size = image->GetLargestPossibleRegion().GetSize();
+    DREAM3D_REQUIRE_EQUAL(size[0], width)
+    DREAM3D_REQUIRE_EQUAL(size[1], height)
+    for(uint32_t y = 0; y < height; y++)
+    {
+      for(uint32_t x = 0; x < width; x++)
+      {
+        typename ImageType::IndexType index = {{static_cast<itk::IndexValueType>(x), static_cast<itk::IndexValueType>(y)}};
+        DREAM3D_REQUIRE_EQUAL(image->GetPixel(index), createPixel<T>(x, y))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The width is not a multiple of the tile size and the last band is shorter than the others.
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void TestRoundTrip()
+  {
+    const uint32_t width = 600;
+    const uint32_t height = 700;
+    writeImage<T>(width, height, 2 * TiledTiffWriter::k_TileSize, 0);
+    checkImage<T>(width, height);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Averages each block of 2 x 2 pixels into one pixel, the way every pyramid level is made from the one above.  A
+  // last odd row or column is averaged on its own and integers are rounded to the nearest value.
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  std::vector<T> downsample(const std::vector<T>& pixels, uint32_t width, uint32_t height) const
+  {
+    const uint32_t outputWidth = (width + 1) / 2;
+    const uint32_t outputHeight = (height + 1) / 2;
+    std::vector<T> output(static_cast<size_t>(outputWidth) * outputHeight);
+    for(uint32_t y = 0; y < outputHeight; y++)
+    {
+      const uint32_t rows = std::min(2U, height - 2 * y);
+      for(uint32_t x = 0; x < outputWidth; x++)
+      {
+        const uint32_t columns = std::min(2U, width - 2 * x);
+        double sum = 0.0;
+        for(uint32_t r = 0; r < rows; r++)
+        {
+          for(uint32_t c = 0; c < columns; c++)
+          {
+            sum += static_cast<double>(pixels[(2 * y + r) * static_cast<size_t>(width) + 2 * x + c]);
+          }
+        }
+        double mean = sum / (rows * columns);
+        output[y * static_cast<size_t>(outputWidth) + x] = std::is_integral<T>::value ? static_cast<T>(std::floor(mean + 0.5)) : static_cast<T>(mean);
+      }
+    }
+    return output;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Walks the reduced resolution directories that follow the full resolution image and compares every level with
+  // the box mean of the level above.
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void checkPyramidLevels(uint32_t width, uint32_t height, uint32_t pyramidLevels)
+  {
+    std::vector<T> expected(static_cast<size_t>(width) * height);
+    for(uint32_t y = 0; y < height; y++)
+    {
+      for(uint32_t x = 0; x < width; x++)
+      {
+        expected[static_cast<size_t>(y) * width + x] = createPixel<T>(x, y);
+      }
+    }
+
+    TIFF* tiff = TIFFOpen(k_OutputFile.toLocal8Bit().constData(), "r");
+    DREAM3D_REQUIRE_VALID_POINTER(tiff)
+    DREAM3D_REQUIRE_EQUAL(TIFFNumberOfDirectories(tiff), pyramidLevels + 1)
+
+    std::vector<T> tile(TIFFTileSize(tiff) / sizeof(T));
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    for(uint32_t level = 1; level <= pyramidLevels; level++)
+    {
+      expected = downsample<T>(expected, levelWidth, levelHeight);
+      levelWidth = (levelWidth + 1) / 2;
+      levelHeight = (levelHeight + 1) / 2;
+
+      DREAM3D_REQUIRE_EQUAL(TIFFReadDirectory(tiff), 1)
+      uint32_t subFileType = 0;
+      uint32_t tiffWidth = 0;
+      uint32_t tiffHeight = 0;
+      TIFFGetField(tiff, TIFFTAG_SUBFILETYPE, &subFileType);
+      TIFFGetField(tiff, TIFFTAG_IMAGEWIDTH, &tiffWidth);
+      TIFFGetField(tiff, TIFFTAG_IMAGELENGTH, &tiffHeight);
+      DREAM3D_REQUIRE_EQUAL(subFileType, FILETYPE_REDUCEDIMAGE)
+      DREAM3D_REQUIRE_EQUAL(tiffWidth, levelWidth)
+      DREAM3D_REQUIRE_EQUAL(tiffHeight, levelHeight)
+
+      const uint32_t tileSize = TiledTiffWriter::k_TileSize;
+      for(uint32_t tileRow = 0; tileRow < levelHeight; tileRow += tileSize)
+      {
+        for(uint32_t tileColumn = 0; tileColumn < levelWidth; tileColumn += tileSize)
+        {
+          DREAM3D_REQUIRED(TIFFReadTile(tiff, tile.data(), tileColumn, tileRow, 0, 0), >, 0)
+          const uint32_t rows = std::min(tileSize, levelHeight - tileRow);
+          const uint32_t columns = std::min(tileSize, levelWidth - tileColumn);
+          for(uint32_t y = 0; y < rows; y++)
+          {
+            for(uint32_t x = 0; x < columns; x++)
+            {
+              DREAM3D_REQUIRE_EQUAL(tile[y * tileSize + x], expected[(tileRow + y) * static_cast<size_t>(levelWidth) + tileColumn + x])
+            }
+          }
+        }
+      }
+    }
+    TIFFClose(tiff);
+  }
+
+  // -----------------------------------------------------------------------------
+  // The odd sizes leave a last row and column of every level that is averaged on its own.
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void TestPyramidLevels()
+  {
+    const uint32_t pyramidLevels = 4;
+    writeImage<T>(601, 701, TiledTiffWriter::k_TileSize, pyramidLevels);
+    checkImage<T>(601, 701);
+    checkPyramidLevels<T>(601, 701, pyramidLevels);
+
+    writeImage<T>(1030, 515, 3 * TiledTiffWriter::k_TileSize, pyramidLevels);
+    checkPyramidLevels<T>(1030, 515, pyramidLevels);
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestDiscard()
+  {
+    const uint32_t width = 300;
+    const uint32_t height = 600;
+    std::vector<uint8_t> band(static_cast<size_t>(width) * TiledTiffWriter::k_TileSize, 1);
+
+    TiledTiffWriter writer;
+    DREAM3D_REQUIRE_EQUAL(writer.open(k_OutputFile), true)
+    DREAM3D_REQUIRE_EQUAL(writer.beginImage(width, height, 1, 1, TiledTiffWriter::SampleFormat::UnsignedInteger, 2), true)
+    DREAM3D_REQUIRE_EQUAL(writer.writeBand(0, TiledTiffWriter::k_TileSize, band.data()), true)
+    writer.discard();
+    DREAM3D_REQUIRE_EQUAL(QFile::exists(k_OutputFile), false)
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "---------------- TiledTiffWriterTest ---------------------" << std::endl;
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestRoundTrip<uint8_t>())
+    DREAM3D_REGISTER_TEST(TestRoundTrip<uint16_t>())
+    DREAM3D_REGISTER_TEST(TestRoundTrip<float>())
+    DREAM3D_REGISTER_TEST(TestPyramidLevels<uint8_t>())
+    DREAM3D_REGISTER_TEST(TestPyramidLevels<uint16_t>())
+    DREAM3D_REGISTER_TEST(TestPyramidLevels<float>())
+    DREAM3D_REGISTER_TEST(TestDiscard())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
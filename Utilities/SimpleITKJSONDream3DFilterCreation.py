@@ -579,7 +579,7 @@ def ImplementInternal(filter_description, fct):
         +filter_description['output_pixel_type']+', '\
         +TypenameOutputPixelType(filter_description['output_pixel_type'])+');'
     else:
-        return '  Dream3DArraySwitchMacro('+fct+', getSelectedCellArrayPath(), -4);'
+        return '  ITKPixelTypeSwitchMacro('+fct+', getSelectedCellArrayPath(), -4);'
 
 def ConfigureFiles(ext, template_directory, directory, DREAM3DFilter, rootTemplateName):
     templateFilePath=os.path.join(template_directory, rootTemplateName+'Template')+ext
@@ -17,6 +17,13 @@
 
 #include "SIMPLib/ITK/Dream3DTemplateAliasMacro.h"
 
+// Pixel types the filter is instantiated for when it uses ITKPixelTypeSwitchMacro
+namespace
+{
+using SupportedPixelTypes = ITKPixelTypeList::StandardPixelTypes;
+using SupportedDimensions = ITKPixelTypeList::AllDimensions;
+} // namespace
+
 #include <itkFlatStructuringElement.h>
 
 // -----------------------------------------------------------------------------
@@ -71,6 +78,8 @@ void $
   // Other parameters
   ${SetupFilterParameters}
 
+  addExecutionFilterParameters(parameters);
+
   std::vector<QString> linkedProps;
   linkedProps.push_back("NewCellArrayName");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Save as New Array", SaveAsNewArray, FilterParameter::Category::Parameter, ${FilterName}, linkedProps));
@@ -99,7 +108,9 @@ void $
   setSelectedCellArrayPath(reader->readDataArrayPath("SelectedCellArrayPath", getSelectedCellArrayPath()));
   setNewCellArrayName(reader->readString("NewCellArrayName", getNewCellArrayName()));
   setSaveAsNewArray(reader->readValue("SaveAsNewArray", getSaveAsNewArray()));
-  ${ReadFilterParameters} reader->closeFilterGroup();
+  ${ReadFilterParameters}
+  readExecutionFilterParameters(reader);
+  reader->closeFilterGroup();
 }
 
 // -----------------------------------------------------------------------------